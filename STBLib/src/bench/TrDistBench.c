@@ -0,0 +1,110 @@
+/*---------------------------------------------------------------------------*/
+/* Copyright(C)  2017  OMRON Corporation                                     */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/* Benchmark of the distance table of the tracker                            */
+/*   Usage: TrDistBench [people(1-256)] [repeat]                             */
+/*   The rows by the C version and by the selected version are compared,     */
+/*   then both are timed.                                                    */
+/*---------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "STBTrAPI.h"
+
+#define BENCH_CNT_MAX   STB_TR_TRA_CNT_MAX
+
+static STB_INT32 posX[BENCH_CNT_MAX];
+static STB_INT32 posY[BENCH_CNT_MAX];
+static STB_INT32 size[BENCH_CNT_MAX];
+static STB_INT32 dstC[BENCH_CNT_MAX * BENCH_CNT_MAX];
+static STB_INT32 dstS[BENCH_CNT_MAX * BENCH_CNT_MAX];
+
+static double GetSec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char *argv[])
+{
+    ROI_SYS cur;
+    STB_INT32 nCnt = BENCH_CNT_MAX;
+    long nRepeat = 2000;
+    long i;
+    STB_INT32 ip;
+    double start, secC, secS;
+    const char *kernel;
+
+    if ( argc > 1 ) nCnt = atoi(argv[1]);
+    if ( argc > 2 ) nRepeat = atol(argv[2]);
+    if ( nCnt < 1 || nCnt > BENCH_CNT_MAX || nRepeat < 1 ) {
+        printf("Usage: %s [people(1-%d)] [repeat]\n", argv[0], BENCH_CNT_MAX);
+        return -1;
+    }
+
+    /* Same people in the previous and the current frame, in a crowded area */
+    srand(1);
+    for ( ip = 0; ip < nCnt; ip++ ) {
+        posX[ip] = rand() % 1600;
+        posY[ip] = rand() % 1200;
+        size[ip] = 40 + rand() % 200;
+    }
+    memset(&cur, 0, sizeof(cur));
+    cur.cnt  = nCnt;
+    cur.posX = posX;
+    cur.posY = posY;
+    cur.size = size;
+
+#if defined( STB_TR_SIMD_X86 )
+    kernel = __builtin_cpu_supports("avx2") ? "AVX2" : "SSE2";
+#else
+    kernel = "C";
+#endif
+
+    /* The results must be the same */
+    for ( ip = 0; ip < nCnt; ip++ ) {
+        TrCheckSameROIRowC(&dstC[ip * nCnt], &cur, 0, nCnt, posX[ip] + 3, posY[ip] - 2, size[ip] + 1);
+        TrCheckSameROIRow (&dstS[ip * nCnt], &cur, posX[ip] + 3, posY[ip] - 2, size[ip] + 1);
+    }
+    if ( memcmp(dstC, dstS, sizeof(STB_INT32) * nCnt * nCnt) != 0 ) {
+        printf("NG : the results of %s differ from C\n", kernel);
+        return 1;
+    }
+
+    start = GetSec();
+    for ( i = 0; i < nRepeat; i++ ) {
+        for ( ip = 0; ip < nCnt; ip++ ) {
+            TrCheckSameROIRowC(&dstC[ip * nCnt], &cur, 0, nCnt, posX[ip], posY[ip], size[ip]);
+        }
+    }
+    secC = GetSec() - start;
+
+    start = GetSec();
+    for ( i = 0; i < nRepeat; i++ ) {
+        for ( ip = 0; ip < nCnt; ip++ ) {
+            TrCheckSameROIRow(&dstS[ip * nCnt], &cur, posX[ip], posY[ip], size[ip]);
+        }
+    }
+    secS = GetSec() - start;
+
+    printf("people %d x %d, repeat %ld\n", nCnt, nCnt, nRepeat);
+    printf("C    : %10.2f us/table\n", secC / nRepeat * 1e6);
+    printf("%-4s : %10.2f us/table\n", kernel, secS / nRepeat * 1e6);
+    return 0;
+}
@@ -25,6 +25,11 @@
 /*Value range check*/
 #define ISVALID_RANGE( val , min , max )    ( ( (min) <= (val) ) && ( (val) <= (max) ) )
 
+/*Age/gender are the only properties : PE does not update them any more once they are FIXED*/
+#define IS_PE_SETTLED_MODE( flg )    (    ( (flg)->age == STB_TRUE || (flg)->gen == STB_TRUE )    \
+                                    &&    (flg)->exp != STB_TRUE && (flg)->gaz != STB_TRUE            \
+                                    &&    (flg)->dir != STB_TRUE && (flg)->bli != STB_TRUE )
+
 
 /*------------------------------------------------------------------------------------------------------------------*/
 /*IsValidValue : error check*/
@@ -84,34 +89,49 @@ STB_INT32 GetVersion( STB_INT8* pnMajorVersion , STB_INT8* pnMinorVersion ){
     return nRet;
 }
 /*------------------------------------------------------------------------------------------------------------------*/
+/*    CalcSettledHashSize                                                                                                */
+/*------------------------------------------------------------------------------------------------------------------*/
+static STB_UINT32 CalcSettledHashSize ( STB_UINT32 nTraCntMax )
+{
+    //power of 2, at least twice the number of the tracking people so that the probe sequences stay short
+    STB_UINT32 retVal ;
+
+    retVal = 1 ;
+    while( retVal < nTraCntMax * 2 )
+    {
+        retVal *= 2 ;
+    }
+    return retVal;
+}
+/*------------------------------------------------------------------------------------------------------------------*/
 /*    CalcStbSize                                                                                                        */
 /*------------------------------------------------------------------------------------------------------------------*/
-STB_UINT32 CalcStbSize ( STBExecFlg *execFlg , STB_UINT32 nTraCntMax)
+STB_UINT32 CalcStbSize ( STBExecFlg *execFlg , STB_UINT32 nDetCntMax , STB_UINT32 nTraCntMax)
 {
     STB_UINT32 retVal ;
 
     retVal = 0 ;
 
-    retVal += 100 ;///Margin  : alignment
-
-
-
-
-    retVal    +=    sizeof( STB_TR_DET        );//wSrcTr
+    retVal    +=    STB_MEM_AREA( sizeof( STB_TR_DET        ) );//wSrcTr
     if( execFlg->bodyTr == STB_TRUE )
     {
-        retVal    +=    sizeof( TraObj        ) * nTraCntMax    ;    // trBody
-        retVal    +=    sizeof( ROI_DET        ) * nTraCntMax    ;    // wSrcTr->bdDet
-        retVal    +=    sizeof( STB_TR_RES_BODYS    )        ;    // wDstTrBody
-        retVal    +=    sizeof( STB_TR_RES    ) * nTraCntMax    ;    // wDstTrBody->body
+        retVal    +=    STB_MEM_AREA( sizeof( TraObj        ) * nTraCntMax )    ;    // trBody
+        retVal    +=    STB_MEM_AREA( sizeof( ROI_DET        ) * nDetCntMax )    ;    // wSrcTr->bdDet
+        retVal    +=    STB_MEM_AREA( sizeof( STB_TR_RES_BODYS    ) )        ;    // wDstTrBody
+        retVal    +=    STB_MEM_AREA( sizeof( STB_TR_RES    ) * nTraCntMax )    ;    // wDstTrBody->body
+        retVal    +=    STB_MEM_AREA( sizeof( STB_TR_EVENTS    ) )            ;    // wDstTrBdEvt
+        retVal    +=    STB_MEM_AREA( sizeof( STB_TR_EVENT    ) * nTraCntMax * TR_EVENT_CNT_PER_TRACK );    // wDstTrBdEvt->event
     }
     if( execFlg->faceTr == STB_TRUE )
     {
-        retVal    +=    sizeof( TraObj        ) * nTraCntMax    ;    // trFace
-        retVal    +=    sizeof( ROI_DET        ) * nTraCntMax    ;    // wSrcTr->fcDet
-        retVal    +=    sizeof( STB_TR_RES_FACES    )        ;    // wDstTrFace
-        retVal    +=    sizeof( STB_TR_RES    ) * nTraCntMax    ;    // wDstTrFace->face
+        retVal    +=    STB_MEM_AREA( sizeof( TraObj        ) * nTraCntMax )    ;    // trFace
+        retVal    +=    STB_MEM_AREA( sizeof( ROI_DET        ) * nDetCntMax )    ;    // wSrcTr->fcDet
+        retVal    +=    STB_MEM_AREA( sizeof( STB_TR_RES_FACES    ) )        ;    // wDstTrFace
+        retVal    +=    STB_MEM_AREA( sizeof( STB_TR_RES    ) * nTraCntMax )    ;    // wDstTrFace->face
+        retVal    +=    STB_MEM_AREA( sizeof( STB_TR_EVENTS    ) )            ;    // wDstTrFcEvt
+        retVal    +=    STB_MEM_AREA( sizeof( STB_TR_EVENT    ) * nTraCntMax * TR_EVENT_CNT_PER_TRACK );    // wDstTrFcEvt->event
     }
+    retVal    +=    STB_MEM_AREA( sizeof( STB_EVENT    ) * nTraCntMax * EVENT_CNT_PER_TRACK );    // event
     if(        execFlg->gen    == STB_TRUE     
         ||    execFlg->age    == STB_TRUE 
         ||    execFlg->fr        == STB_TRUE 
@@ -121,7 +141,9 @@ STB_UINT32 CalcStbSize ( STBExecFlg *execFlg , STB_UINT32 nTraCntMax)
         ||    execFlg->bli    == STB_TRUE 
         )
     {
-        retVal    +=    sizeof( FaceObj        ) * nTraCntMax    ;    // infoFace
+        retVal    +=    STB_MEM_AREA( sizeof( FaceObj        ) * nTraCntMax )    ;    // infoFace
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * nDetCntMax )    ;    // wDetTra
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax )    ;    // wTraFace
     }
 
 
@@ -134,19 +156,25 @@ STB_UINT32 CalcStbSize ( STBExecFlg *execFlg , STB_UINT32 nTraCntMax)
         ||    execFlg->bli    == STB_TRUE 
         )
     {
-        retVal    +=    sizeof( STB_PE_DET    )                ;    // wSrcPe
-        retVal    +=    sizeof( FACE_DET    ) * nTraCntMax    ;    // wSrcPe->fcDet
-        retVal    +=    sizeof( STB_PE_RES    )                ;    // wDstPe
-        retVal    +=    sizeof( STB_PE_FACE    ) * nTraCntMax    ;    // wDstPe->peFace
+        retVal    +=    STB_MEM_AREA( sizeof( STB_PE_DET    ) )                ;    // wSrcPe
+        retVal    +=    STB_MEM_AREA( sizeof( FACE_DET    ) * nTraCntMax )    ;    // wSrcPe->fcDet
+        retVal    +=    STB_MEM_AREA( sizeof( STB_PE_RES    ) )                ;    // wDstPe
+        retVal    +=    STB_MEM_AREA( sizeof( STB_PE_FACE    ) * nTraCntMax )    ;    // wDstPe->peFace
 
     }
+    if( IS_PE_SETTLED_MODE( execFlg ) )
+    {
+        retVal    +=    STB_MEM_AREA( sizeof( SettledObj    ) * nTraCntMax )    ;    // settled
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * CalcSettledHashSize( nTraCntMax ) );    // settledHash
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax )    ;    // wFaceSettled
+    }
 
     if(    execFlg->fr    == STB_TRUE )
     {
-        retVal    +=    sizeof( STB_FR_DET    )                ;    // wSrcFr
-        retVal    +=    sizeof( FR_DET        ) * nTraCntMax    ;    // wSrcFr->fcDet
-        retVal    +=    sizeof( STB_FR_RES    )                ;    // wDstFr
-        retVal    +=    sizeof( FR_RES        ) * nTraCntMax    ;    // wDstFr->frFace
+        retVal    +=    STB_MEM_AREA( sizeof( STB_FR_DET    ) )                ;    // wSrcFr
+        retVal    +=    STB_MEM_AREA( sizeof( FR_DET        ) * nTraCntMax )    ;    // wSrcFr->fcDet
+        retVal    +=    STB_MEM_AREA( sizeof( STB_FR_RES    ) )                ;    // wDstFr
+        retVal    +=    STB_MEM_AREA( sizeof( FR_RES        ) * nTraCntMax )    ;    // wDstFr->frFace
     }
     
 
@@ -157,26 +185,33 @@ STB_UINT32 CalcStbSize ( STBExecFlg *execFlg , STB_UINT32 nTraCntMax)
 /*------------------------------------------------------------------------------------------------------------------*/
 void ShareStbSize ( STBHANDLE    handle , STB_INT8    *stbPtr )
 {
+    STB_UINT32    nDetCntMax;
     STB_UINT32    nTraCntMax;
 
+    nDetCntMax = handle->nDetCntMax;
     nTraCntMax = handle->nTraCntMax;
 
 
-    handle->wSrcTr = (STB_TR_DET*)stbPtr;        stbPtr    += ( sizeof( STB_TR_DET    ) );
+    handle->wSrcTr = (STB_TR_DET*)stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_TR_DET    ) );
     if( handle->execFlg->bodyTr == STB_TRUE )
     {
-        handle->trBody                = ( TraObj*                ) stbPtr;        stbPtr    += ( sizeof( TraObj                ) * nTraCntMax );
-        handle->wSrcTr->bdDet        = ( ROI_DET*            ) stbPtr;        stbPtr    += ( sizeof( ROI_DET            ) * nTraCntMax );
-        handle->wDstTrBody            = ( STB_TR_RES_BODYS*    ) stbPtr;        stbPtr    += ( sizeof( STB_TR_RES_BODYS    ));
-        handle->wDstTrBody->body    = ( STB_TR_RES*            ) stbPtr;        stbPtr    += ( sizeof( STB_TR_RES            ) * nTraCntMax );
+        handle->trBody                = ( TraObj*                ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( TraObj                ) * nTraCntMax );
+        handle->wSrcTr->bdDet        = ( ROI_DET*            ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( ROI_DET            ) * nDetCntMax );
+        handle->wDstTrBody            = ( STB_TR_RES_BODYS*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_TR_RES_BODYS    ));
+        handle->wDstTrBody->body    = ( STB_TR_RES*            ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_TR_RES            ) * nTraCntMax );
+        handle->wDstTrBdEvt            = ( STB_TR_EVENTS*        ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_TR_EVENTS        ));
+        handle->wDstTrBdEvt->event    = ( STB_TR_EVENT*        ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_TR_EVENT        ) * nTraCntMax * TR_EVENT_CNT_PER_TRACK );
     }
     if( handle->execFlg->faceTr == STB_TRUE )
     {
-        handle->trFace                = ( TraObj*                ) stbPtr;        stbPtr    += ( sizeof( TraObj                ) * nTraCntMax );
-        handle->wSrcTr->fcDet        = ( ROI_DET*            ) stbPtr;        stbPtr    += ( sizeof( ROI_DET            ) * nTraCntMax );
-        handle->wDstTrFace            = ( STB_TR_RES_FACES*    ) stbPtr;        stbPtr    += ( sizeof( STB_TR_RES_FACES    ));
-        handle->wDstTrFace->face    = ( STB_TR_RES*            ) stbPtr;        stbPtr    += ( sizeof( STB_TR_RES            ) * nTraCntMax );
+        handle->trFace                = ( TraObj*                ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( TraObj                ) * nTraCntMax );
+        handle->wSrcTr->fcDet        = ( ROI_DET*            ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( ROI_DET            ) * nDetCntMax );
+        handle->wDstTrFace            = ( STB_TR_RES_FACES*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_TR_RES_FACES    ));
+        handle->wDstTrFace->face    = ( STB_TR_RES*            ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_TR_RES            ) * nTraCntMax );
+        handle->wDstTrFcEvt            = ( STB_TR_EVENTS*        ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_TR_EVENTS        ));
+        handle->wDstTrFcEvt->event    = ( STB_TR_EVENT*        ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_TR_EVENT        ) * nTraCntMax * TR_EVENT_CNT_PER_TRACK );
     }
+    handle->event                    = ( STB_EVENT*            ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_EVENT            ) * nTraCntMax * EVENT_CNT_PER_TRACK );
 
     if(        handle->execFlg->gen    == STB_TRUE     
         ||    handle->execFlg->age    == STB_TRUE 
@@ -187,7 +222,9 @@ void ShareStbSize ( STBHANDLE    handle , STB_INT8    *stbPtr )
         ||    handle->execFlg->bli    == STB_TRUE 
         )
     {
-        handle->infoFace            = ( FaceObj*    ) stbPtr;        stbPtr    += ( sizeof( FaceObj    ) * nTraCntMax );
+        handle->infoFace            = ( FaceObj*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( FaceObj    ) * nTraCntMax );
+        handle->wDetTra                = ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nDetCntMax );
+        handle->wTraFace            = ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax );
     }
 
     if(        handle->execFlg->gen    == STB_TRUE     
@@ -199,18 +236,26 @@ void ShareStbSize ( STBHANDLE    handle , STB_INT8    *stbPtr )
         ||    handle->execFlg->bli    == STB_TRUE 
         )
     {
-        handle->wSrcPe                = ( STB_PE_DET*    ) stbPtr;        stbPtr    += ( sizeof( STB_PE_DET    ) );
-        handle->wSrcPe->fcDet        = ( FACE_DET*    ) stbPtr;        stbPtr    += ( sizeof( FACE_DET    ) * nTraCntMax );
-        handle->wDstPe                = ( STB_PE_RES*    ) stbPtr;        stbPtr    += ( sizeof( STB_PE_RES    )  );
-        handle->wDstPe->peFace        = ( STB_PE_FACE*) stbPtr;        stbPtr    += ( sizeof( STB_PE_FACE) * nTraCntMax );
+        handle->wSrcPe                = ( STB_PE_DET*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_PE_DET    ) );
+        handle->wSrcPe->fcDet        = ( FACE_DET*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( FACE_DET    ) * nTraCntMax );
+        handle->wDstPe                = ( STB_PE_RES*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_PE_RES    )  );
+        handle->wDstPe->peFace        = ( STB_PE_FACE*) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_PE_FACE) * nTraCntMax );
+    }
+    if( IS_PE_SETTLED_MODE( handle->execFlg ) )
+    {
+        handle->settled                = ( SettledObj*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( SettledObj    ) * nTraCntMax );
+        handle->settledHash            = ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * CalcSettledHashSize( nTraCntMax ) );
+        handle->wFaceSettled        = ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax );
+        handle->settledHashMask        = (STB_INT32)CalcSettledHashSize( nTraCntMax ) - 1;
+        handle->nPeSettled            = STB_TRUE;
     }
 
     if(    handle->execFlg->fr        == STB_TRUE )
     {
-        handle->wSrcFr                = ( STB_FR_DET*    ) stbPtr;        stbPtr    += ( sizeof( STB_FR_DET    ) );
-        handle->wSrcFr->fcDet        = ( FR_DET*        ) stbPtr;        stbPtr    += ( sizeof( FR_DET        ) * nTraCntMax );
-        handle->wDstFr                = ( STB_FR_RES*    ) stbPtr;        stbPtr    += ( sizeof( STB_FR_RES    ) );
-        handle->wDstFr->frFace        = ( FR_RES*        ) stbPtr;        stbPtr    += ( sizeof( FR_RES        ) * nTraCntMax );
+        handle->wSrcFr                = ( STB_FR_DET*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_FR_DET    ) );
+        handle->wSrcFr->fcDet        = ( FR_DET*        ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( FR_DET        ) * nTraCntMax );
+        handle->wDstFr                = ( STB_FR_RES*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_FR_RES    ) );
+        handle->wDstFr->frFace        = ( FR_RES*        ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( FR_RES        ) * nTraCntMax );
     }
 
 
@@ -219,65 +264,140 @@ void ShareStbSize ( STBHANDLE    handle , STB_INT8    *stbPtr )
 /*Create handle*/
 /*------------------------------------------------------------------------------------------------------------------*/
 STBHANDLE CreateHandle ( STB_UINT32 stbExecFlg )
+{
+    return CreateHandleEx ( stbExecFlg , DETECT_CNT_MAX , TRACK_CNT_MAX );
+}
+/*------------------------------------------------------------------------------------------------------------------*/
+/*Create handle with the detection/tracking capacity*/
+/*------------------------------------------------------------------------------------------------------------------*/
+STBHANDLE CreateHandleEx ( STB_UINT32 stbExecFlg , STB_INT32 nDetCntMax , STB_INT32 nTraCntMax )
+{
+    return CreateHandleEx2 ( stbExecFlg , nDetCntMax , nTraCntMax , STB_HISTORY_DEPTH_DEFAULT , STB_HISTORY_DEPTH_DEFAULT );
+}
+/*------------------------------------------------------------------------------------------------------------------*/
+/* SetExecFlg : Convert the function flags of the API into STBExecFlg */
+/*------------------------------------------------------------------------------------------------------------------*/
+static STB_INT32 SetExecFlg ( STBExecFlg *execFlg , STB_UINT32 stbExecFlg )
+{
+    if( ( stbExecFlg & STB_FUNC_BD )== STB_FUNC_BD ){    execFlg->bodyTr    = STB_TRUE ;}else{    execFlg->bodyTr    = STB_FALSE ;}
+    if( ( stbExecFlg & STB_FUNC_DT )== STB_FUNC_DT ){    execFlg->faceTr    = STB_TRUE ;}else{    execFlg->faceTr    = STB_FALSE ;}
+    if( ( stbExecFlg & STB_FUNC_PT )== STB_FUNC_PT ){    execFlg->dir    = STB_TRUE ;}else{    execFlg->dir    = STB_FALSE ;}
+    if( ( stbExecFlg & STB_FUNC_AG )== STB_FUNC_AG ){    execFlg->age    = STB_TRUE ;}else{    execFlg->age    = STB_FALSE ;}
+    if( ( stbExecFlg & STB_FUNC_GN )== STB_FUNC_GN ){    execFlg->gen    = STB_TRUE ;}else{    execFlg->gen    = STB_FALSE ;}
+    if( ( stbExecFlg & STB_FUNC_GZ )== STB_FUNC_GZ ){    execFlg->gaz    = STB_TRUE ;}else{    execFlg->gaz    = STB_FALSE ;}
+    if( ( stbExecFlg & STB_FUNC_BL )== STB_FUNC_BL ){    execFlg->bli    = STB_TRUE ;}else{    execFlg->bli    = STB_FALSE ;}
+    if( ( stbExecFlg & STB_FUNC_EX )== STB_FUNC_EX ){    execFlg->exp    = STB_TRUE ;}else{    execFlg->exp    = STB_FALSE ;}
+    if( ( stbExecFlg & STB_FUNC_FR )== STB_FUNC_FR ){    execFlg->fr        = STB_TRUE ;}else{    execFlg->fr        = STB_FALSE ;}
+    execFlg->pet    = STB_FALSE ;
+    execFlg->hand    = STB_FALSE ;
+
+
+    if( execFlg->faceTr == STB_FALSE )
+    {
+        if(        execFlg->gen    == STB_TRUE     
+            ||    execFlg->age    == STB_TRUE 
+            ||    execFlg->fr        == STB_TRUE 
+            ||    execFlg->exp    == STB_TRUE     
+            ||    execFlg->dir    == STB_TRUE     
+            ||    execFlg->gaz    == STB_TRUE 
+            ||    execFlg->bli    == STB_TRUE 
+            )
+        {
+            return STB_ERR_INVALIDPARAM;/*Invalid input parameter stbExecFlg*/
+        }
+    }
+    return STB_NORMAL;
+}
+/*------------------------------------------------------------------------------------------------------------------*/
+/*Get the memory size necessary for the handle (0 : invalid parameter)*/
+/*------------------------------------------------------------------------------------------------------------------*/
+STB_UINT32 GetRequiredMemorySize ( STB_UINT32 stbExecFlg , STB_INT32 nDetCntMax , STB_INT32 nTraCntMax , STB_INT32 nPeBackMax , STB_INT32 nFrBackMax )
+{
+    STBHANDLE        handle = NULL;
+    STBExecFlg        execFlg;
+    STB_UINT32        retVal;
+
+    /*Every detection may start a track in the same frame, so the tracking capacity covers the detection capacity*/
+    if( IsValidValue( nTraCntMax , 1 , STB_CNT_MAX_LIMIT ) != STB_NORMAL
+     || IsValidValue( nDetCntMax , 1 , nTraCntMax        ) != STB_NORMAL )
+    {
+        return 0;/*Invalid input parameter nDetCntMax/nTraCntMax*/
+    }
+    if( IsValidValue( nPeBackMax , STB_HISTORY_DEPTH_MIN , STB_HISTORY_DEPTH_LIMIT ) != STB_NORMAL
+     || IsValidValue( nFrBackMax , STB_HISTORY_DEPTH_MIN , STB_HISTORY_DEPTH_LIMIT ) != STB_NORMAL )
+    {
+        return 0;/*Invalid input parameter nPeBackMax/nFrBackMax*/
+    }
+    if( SetExecFlg ( &execFlg , stbExecFlg ) != STB_NORMAL )
+    {
+        return 0;/*Invalid input parameter stbExecFlg*/
+    }
+
+    /*STB handle at the cache line boundary, its ExecFlg and areas, then the handles for child functions*/
+    retVal    =    STB_MEM_ALIGN_TOP - 1;
+    retVal    +=    STB_MEM_AREA( sizeof( *handle    ) );
+    retVal    +=    STB_MEM_AREA( sizeof( STBExecFlg ) );
+    retVal    +=    CalcStbSize ( &execFlg , nDetCntMax , nTraCntMax );
+    if( execFlg.bodyTr == STB_TRUE || execFlg.faceTr == STB_TRUE )
+    {
+        retVal    +=    STB_Tr_GetRequiredMemorySize( &execFlg , nDetCntMax , nTraCntMax );
+    }
+    if(        execFlg.gen    == STB_TRUE     
+        ||    execFlg.age    == STB_TRUE 
+        //||    execFlg.fr    == STB_TRUE     
+        ||    execFlg.exp    == STB_TRUE     
+        ||    execFlg.dir    == STB_TRUE     
+        ||    execFlg.gaz    == STB_TRUE 
+        ||    execFlg.bli    == STB_TRUE 
+        )
+    {
+        retVal    +=    STB_Pe_GetRequiredMemorySize( &execFlg , nTraCntMax , nPeBackMax );
+    }
+    if( execFlg.fr == STB_TRUE )
+    {
+        retVal    +=    STB_Fr_GetRequiredMemorySize( nTraCntMax , nFrBackMax );
+    }
+
+    return retVal;
+}
+/*------------------------------------------------------------------------------------------------------------------*/
+/*Create handle in the memory given by the caller*/
+/*------------------------------------------------------------------------------------------------------------------*/
+STBHANDLE CreateHandleInPlace ( VOID *pMem , STB_UINT32 nMemSize , STB_UINT32 stbExecFlg , STB_INT32 nDetCntMax , STB_INT32 nTraCntMax , STB_INT32 nPeBackMax , STB_INT32 nFrBackMax )
 {
 
     STBHANDLE        handle;
     STB_UINT32        tmpVal;
     STB_UINT32        tmpFLG;
+    STB_INT8        *stbPtr;
     
 
-
-    /*do STB handle's malloc here*/
-    handle = NULL ;
-    handle = ( STBHANDLE )malloc( sizeof( *handle ) );
-    if( handle == NULL )
+    if( IsValidPointer( pMem ) != STB_NORMAL )
     {
-        return NULL;/* FAIL : Create STB handle */
+        return NULL;
     }
+    tmpVal = GetRequiredMemorySize ( stbExecFlg , nDetCntMax , nTraCntMax , nPeBackMax , nFrBackMax );
+    if( tmpVal == 0 || nMemSize < tmpVal )
+    {
+        return NULL;/*Invalid input parameter or too small memory*/
+    }
+
+    /*STB handle is placed at the cache line boundary of the memory*/
+    handle = ( STBHANDLE )STB_MEM_TOP( pMem );
+    stbPtr = ( STB_INT8 * )handle + STB_MEM_AREA( sizeof( *handle ) );
 
     /* ExecFlg */
-    handle->execFlg = ( STBExecFlg* )malloc( sizeof( STBExecFlg ) );
-    if( handle->execFlg == NULL )
-    {
-        free ( handle )    ;/*Free of Malloc things at the present time*/
-        return NULL        ;/* FAIL : Create STB handle ExecFlg */
-    }
-    if( ( stbExecFlg & STB_FUNC_BD )== STB_FUNC_BD ){    handle->execFlg->bodyTr    = STB_TRUE ;}else{    handle->execFlg->bodyTr    = STB_FALSE ;}
-    if( ( stbExecFlg & STB_FUNC_DT )== STB_FUNC_DT ){    handle->execFlg->faceTr    = STB_TRUE ;}else{    handle->execFlg->faceTr    = STB_FALSE ;}
-    if( ( stbExecFlg & STB_FUNC_PT )== STB_FUNC_PT ){    handle->execFlg->dir    = STB_TRUE ;}else{    handle->execFlg->dir    = STB_FALSE ;}
-    if( ( stbExecFlg & STB_FUNC_AG )== STB_FUNC_AG ){    handle->execFlg->age    = STB_TRUE ;}else{    handle->execFlg->age    = STB_FALSE ;}
-    if( ( stbExecFlg & STB_FUNC_GN )== STB_FUNC_GN ){    handle->execFlg->gen    = STB_TRUE ;}else{    handle->execFlg->gen    = STB_FALSE ;}
-    if( ( stbExecFlg & STB_FUNC_GZ )== STB_FUNC_GZ ){    handle->execFlg->gaz    = STB_TRUE ;}else{    handle->execFlg->gaz    = STB_FALSE ;}
-    if( ( stbExecFlg & STB_FUNC_BL )== STB_FUNC_BL ){    handle->execFlg->bli    = STB_TRUE ;}else{    handle->execFlg->bli    = STB_FALSE ;}
-    if( ( stbExecFlg & STB_FUNC_EX )== STB_FUNC_EX ){    handle->execFlg->exp    = STB_TRUE ;}else{    handle->execFlg->exp    = STB_FALSE ;}
-    if( ( stbExecFlg & STB_FUNC_FR )== STB_FUNC_FR ){    handle->execFlg->fr        = STB_TRUE ;}else{    handle->execFlg->fr        = STB_FALSE ;}
-    handle->execFlg->pet    = STB_FALSE ;
-    handle->execFlg->hand    = STB_FALSE ;
-
-
-    if( handle->execFlg->faceTr == STB_FALSE )
-    {
-        if(        handle->execFlg->gen    == STB_TRUE     
-            ||    handle->execFlg->age    == STB_TRUE 
-            ||    handle->execFlg->fr        == STB_TRUE 
-            ||    handle->execFlg->exp    == STB_TRUE     
-            ||    handle->execFlg->dir    == STB_TRUE     
-            ||    handle->execFlg->gaz    == STB_TRUE 
-            ||    handle->execFlg->bli    == STB_TRUE 
-            )
-        {
-            free ( handle->execFlg    );/*Free of Malloc things at the present time*/
-            free ( handle            );/*Free of Malloc things at the present time*/
-            return NULL        ;/*Invalid input parameter stbExecFlg*/
-        }
-    }
+    handle->execFlg = ( STBExecFlg* )stbPtr;    stbPtr += STB_MEM_AREA( sizeof( STBExecFlg ) );
+    SetExecFlg ( handle->execFlg , stbExecFlg );
 
 
     /*Setting the initial value here.*/
     handle->nTraCntBody    = 0;
     handle->nTraCntFace    = 0;
-    handle->nDetCntMax    = DETECT_CNT_MAX    ;/*A maximum number of detected(input) people*/
-    handle->nTraCntMax    = TRACK_CNT_MAX        ;/*A maximum number of tracking(output) people*/
+    handle->nDetCntMax    = nDetCntMax        ;/*A maximum number of detected(input) people*/
+    handle->nTraCntMax    = nTraCntMax        ;/*A maximum number of tracking(output) people*/
+    handle->nPeBackMax    = nPeBackMax        ;/*A number of past frames kept for PE stabilization*/
+    handle->nFrBackMax    = nFrBackMax        ;/*A number of past frames kept for FR stabilization*/
     handle->nExecuted   = STB_FALSE            ;
     handle->nInitialized= STB_FALSE            ;
     handle->nDetCntBody    = 0;
@@ -285,38 +405,50 @@ STBHANDLE CreateHandle ( STB_UINT32 stbExecFlg )
     handle->trFace        = NULL;
     handle->trBody        = NULL;
     handle->infoFace    = NULL;
+    handle->wDetTra        = NULL;
+    handle->wTraFace    = NULL;
     handle->wSrcTr        = NULL;
     handle->wDstTrFace    = NULL;
     handle->wDstTrBody    = NULL;
+    handle->wDstTrFcEvt    = NULL;
+    handle->wDstTrBdEvt    = NULL;
+    handle->event        = NULL;
+    handle->nEventCnt    = 0;
     handle->wSrcPe        = NULL;
     handle->wDstPe        = NULL;
+    handle->nPeSettled    = STB_FALSE;
+    handle->nSettledCnt    = 0;
+    handle->settled        = NULL;
+    handle->settledHash    = NULL;
+    handle->settledHashMask    = 0;
+    handle->wFaceSettled= NULL;
     handle->wSrcFr        = NULL;
     handle->wDstFr        = NULL;
 
 
-    /* Do Malloc to things that need Malloc in STB handle */
-    handle->stbPtr        = NULL    ;
+    /* Allocate the areas in STB handle */
+    handle->stbMem        = NULL    ;
+    handle->stbPtr        = stbPtr;
     handle->hTrHandle    = NULL    ;
     handle->hPeHandle    = NULL    ;
     handle->hFrHandle    = NULL    ;
-    tmpVal                = CalcStbSize ( handle->execFlg ,handle->nTraCntMax        );    /*calculate necessary amount in the STB handle*/
-    handle->stbPtr        = ( STB_INT8 * )malloc( tmpVal    )                        ;    /*keep necessary amount in the STB handle*/
-    if( handle->stbPtr    == NULL )
+    ShareStbSize ( handle, handle->stbPtr);                                            /* the areas are allocated to things that need them in STB handle */
+    if( handle->nPeSettled == STB_TRUE )
     {
-            free ( handle->execFlg    );/*Free of Malloc things at the present time*/
-            free ( handle            );/*Free of Malloc things at the present time*/
-            return NULL        ;
+        SetFaceToSettled( 0 , handle->infoFace , handle->execFlg , handle->settled , &(handle->nSettledCnt) , handle->settledHash , handle->settledHashMask );/*empty*/
     }
-    ShareStbSize ( handle, handle->stbPtr);                                            /* Malloc-area is allocated to things that need Malloc in STB handle */
+    stbPtr                += CalcStbSize ( handle->execFlg ,handle->nDetCntMax ,handle->nTraCntMax );
 
-    /*Create handles for child functions*/
+    /*Create handles for child functions in the rest of the memory*/
     tmpFLG = STB_TRUE;
     if(        handle->execFlg->bodyTr    == STB_TRUE 
         ||    handle->execFlg->faceTr    == STB_TRUE 
         )
     {
-        handle->hTrHandle    = STB_Tr_CreateHandle( handle->execFlg ,handle->nDetCntMax, handle->nTraCntMax    );    
+        tmpVal                = STB_Tr_GetRequiredMemorySize( handle->execFlg ,handle->nDetCntMax, handle->nTraCntMax    );
+        handle->hTrHandle    = STB_Tr_CreateHandleInPlace( stbPtr , tmpVal , handle->execFlg ,handle->nDetCntMax, handle->nTraCntMax    );    
         if( handle->hTrHandle == NULL ){ tmpFLG = STB_FALSE; }
+        stbPtr                += tmpVal;
     }
     if(        handle->execFlg->gen    == STB_TRUE     
         ||    handle->execFlg->age    == STB_TRUE 
@@ -327,26 +459,57 @@ STBHANDLE CreateHandle ( STB_UINT32 stbExecFlg )
         ||    handle->execFlg->bli    == STB_TRUE 
         )
     {
-        handle->hPeHandle    = STB_Pe_CreateHandle( handle->execFlg ,handle->nTraCntMax                        );    
+        tmpVal                = STB_Pe_GetRequiredMemorySize( handle->execFlg ,handle->nTraCntMax, handle->nPeBackMax    );
+        handle->hPeHandle    = STB_Pe_CreateHandleInPlace( stbPtr , tmpVal , handle->execFlg ,handle->nTraCntMax, handle->nPeBackMax    );    
         if( handle->hPeHandle == NULL ){ tmpFLG = STB_FALSE; }
+        stbPtr                += tmpVal;
     }
     if(    handle->execFlg->fr    == STB_TRUE )
     {
-        handle->hFrHandle    = STB_Fr_CreateHandle( handle->nTraCntMax                                        );    
+        tmpVal                = STB_Fr_GetRequiredMemorySize( handle->nTraCntMax, handle->nFrBackMax                    );
+        handle->hFrHandle    = STB_Fr_CreateHandleInPlace( stbPtr , tmpVal , handle->nTraCntMax, handle->nFrBackMax                    );    
         if( handle->hFrHandle == NULL ){ tmpFLG = STB_FALSE; }
+        stbPtr                += tmpVal;
     }
 
     if(    tmpFLG == STB_FALSE    )
     {
-        /*When Malloc failed, Free of Malloc data at the present time*/
-        if( handle->hTrHandle        != NULL )    {    STB_Tr_DeleteHandle    ( handle->hTrHandle )    ;}
-        if( handle->hPeHandle        != NULL )    {    STB_Pe_DeleteHandle    ( handle->hPeHandle )    ;}
-        if( handle->hFrHandle        != NULL )    {    STB_Fr_DeleteHandle    ( handle->hFrHandle )    ;}
-        if( handle->stbPtr            != NULL )    {    free                ( handle->stbPtr    )    ;}/*Free of Malloc things at the present time*/
-        if( handle->execFlg            != NULL )    {    free                ( handle->execFlg    )    ;}/*Free of Malloc things at the present time*/
-        if( handle                    != NULL )    {    free                ( handle            )    ;}/*Free of Malloc things at the present time*/
+        return NULL;/*Nothing is allocated in the memory given by the caller*/
+    }
+
+    return handle;
+}
+/*------------------------------------------------------------------------------------------------------------------*/
+/*Create handle with the detection/tracking capacity and the PE/FR history depth*/
+/*------------------------------------------------------------------------------------------------------------------*/
+STBHANDLE CreateHandleEx2 ( STB_UINT32 stbExecFlg , STB_INT32 nDetCntMax , STB_INT32 nTraCntMax , STB_INT32 nPeBackMax , STB_INT32 nFrBackMax )
+{
+
+    STBHANDLE        handle;
+    STB_UINT32        tmpVal;
+    STB_INT8        *pMem;
+    
+
+    tmpVal = GetRequiredMemorySize ( stbExecFlg , nDetCntMax , nTraCntMax , nPeBackMax , nFrBackMax );    /*calculate necessary amount in the STB handle*/
+    if( tmpVal == 0 )
+    {
+        return NULL;/*Invalid input parameter*/
+    }
+
+    /*do Malloc of STB handle, its areas and the handles for child functions at once here*/
+    pMem = ( STB_INT8 * )malloc( tmpVal );
+    if( pMem == NULL )
+    {
+        return NULL;/* FAIL : Create STB handle */
+    }
+
+    handle = CreateHandleInPlace ( pMem , tmpVal , stbExecFlg , nDetCntMax , nTraCntMax , nPeBackMax , nFrBackMax );
+    if( handle == NULL )
+    {
+        free ( pMem );/*Free of Malloc things at the present time*/
         return NULL;
     }
+    handle->stbMem = pMem;
 
     return handle;
 }
@@ -364,16 +527,87 @@ STB_INT32 DeleteHandle(STBHANDLE handle)
         return STB_ERR_NOHANDLE;
     }
 
-    /*Malloc things here, do free*/
+    /*The handles for child functions are in the memory of STB handle*/
     if( handle->hTrHandle        != NULL )    {    STB_Tr_DeleteHandle    ( handle->hTrHandle )    ;}
     if( handle->hPeHandle        != NULL )    {    STB_Pe_DeleteHandle    ( handle->hPeHandle )    ;}
     if( handle->hFrHandle        != NULL )    {    STB_Fr_DeleteHandle    ( handle->hFrHandle )    ;}
-    if( handle->stbPtr            != NULL )    {    free                ( handle->stbPtr    )    ;}
-    if( handle->execFlg            != NULL )    {    free                ( handle->execFlg    )    ;}
-    if( handle                    != NULL )    {    free                ( handle            )    ;}
+    if( handle->stbMem            != NULL )    {    free                ( handle->stbMem    )    ;}/*NULL : created in the memory given by the caller*/
 
 
 
+    return STB_NORMAL;
+}
+/*------------------------------------------------------------------------------------------------------------------*/
+/* SetFrameResultCore : Get the result of stbINPUT (up to nCntMax people) */
+/*------------------------------------------------------------------------------------------------------------------*/
+static STB_INT32 SetFrameResultCore (    STBHANDLE                            handle        ,
+                                        STB_INT32                            nBodyCount    ,
+                                        const STB_FRAME_RESULT_DETECTION    *body        ,
+                                        STB_INT32                            nFaceCount    ,
+                                        const STB_FRAME_RESULT_FACE            *face        ,
+                                        STB_INT32                            nCntMax        )
+{
+
+    STB_INT32 nRet;
+
+    /*NULL check*/
+    if( handle->execFlg->bodyTr == STB_TRUE && nBodyCount > 0 )
+    {
+        nRet = IsValidPointer(body);
+        if(nRet != STB_NORMAL)
+        {
+            return STB_ERR_INVALIDPARAM;
+        }
+    }
+    if( handle->execFlg->faceTr == STB_TRUE && nFaceCount > 0 )
+    {
+        nRet = IsValidPointer(face);
+        if(nRet != STB_NORMAL)
+        {
+            return STB_ERR_INVALIDPARAM;
+        }
+    }
+
+
+    /*Input value check*/
+    nRet = STB_IsValidValue ( nBodyCount , body , nFaceCount , face , nCntMax ,handle->execFlg );
+    if(nRet != STB_TRUE)
+    {
+        return STB_ERR_INVALIDPARAM;
+    }
+
+
+    /*Clear the unexecuted state flag*/
+    handle->nExecuted = STB_FALSE;
+
+    /*Set the received result to the handle*/
+    if( handle->execFlg->bodyTr == STB_TRUE )
+    {
+        handle->nDetCntBody = nBodyCount;
+        SetTrackingObjectBody ( nBodyCount , body    ,handle->wSrcTr    );
+    }
+    if( handle->execFlg->faceTr == STB_TRUE )
+    {
+        handle->nDetCntFace = nFaceCount;
+        SetTrackingObjectFace ( nFaceCount , face    ,handle->wSrcTr    );
+    }
+
+    /*Set detection result to Face/Property/Recognition data*/
+    if(        handle->execFlg->gen    == STB_TRUE 
+        ||    handle->execFlg->age    == STB_TRUE 
+        ||    handle->execFlg->fr        == STB_TRUE 
+        ||    handle->execFlg->exp    == STB_TRUE 
+        ||    handle->execFlg->gaz    == STB_TRUE 
+        ||    handle->execFlg->dir    == STB_TRUE 
+        ||    handle->execFlg->bli    == STB_TRUE 
+        )
+    {
+        SetFaceObject ( nFaceCount , face    ,handle->infoFace    ,handle->execFlg , handle->nTraCntMax );
+    }
+
+
+    handle->nInitialized = STB_TRUE;
+
     return STB_NORMAL;
 }
 /*------------------------------------------------------------------------------------------------------------------*/
@@ -383,6 +617,7 @@ STB_INT32 SetFrameResult ( STBHANDLE handle    , const STB_FRAME_RESULT *stbINPU
 {
 
     STB_INT32 nRet;
+    STB_INT32 nCntMax;
 
     /*NULL check*/
     nRet = IsValidPointer(handle);
@@ -397,28 +632,107 @@ STB_INT32 SetFrameResult ( STBHANDLE handle    , const STB_FRAME_RESULT *stbINPU
         return STB_ERR_INVALIDPARAM;
     }
 
+    /*STB_FRAME_RESULT holds FRAME_RESULT_CNT_MAX people at most*/
+    nCntMax = handle->nDetCntMax;
+    if( nCntMax > FRAME_RESULT_CNT_MAX )
+    {
+        nCntMax = FRAME_RESULT_CNT_MAX;
+    }
 
-    /*Input value check*/
-    nRet = STB_IsValidValue ( stbINPUTResult ,handle->execFlg );
+    return SetFrameResultCore (    handle                                ,
+                                stbINPUTResult->bodys.nCount        ,
+                                stbINPUTResult->bodys.body            ,
+                                stbINPUTResult->faces.nCount        ,
+                                stbINPUTResult->faces.face            ,
+                                nCntMax                                );
+}
+/*------------------------------------------------------------------------------------------------------------------*/
+/* SetFrameResultEx : Get the result of stbINPUT given as arrays */
+/*------------------------------------------------------------------------------------------------------------------*/
+STB_INT32 SetFrameResultEx (    STBHANDLE                            handle        ,
+                                STB_INT32                            nBodyCount    ,
+                                const STB_FRAME_RESULT_DETECTION    *body        ,
+                                STB_INT32                            nFaceCount    ,
+                                const STB_FRAME_RESULT_FACE            *face        )
+{
+
+    STB_INT32 nRet;
+
+    /*NULL check*/
+    nRet = IsValidPointer(handle);
+    if(nRet != STB_NORMAL)
+    {
+        return STB_ERR_NOHANDLE;
+    }
+
+    return SetFrameResultCore ( handle , nBodyCount , body , nFaceCount , face , handle->nDetCntMax );
+}
+
+/*------------------------------------------------------------------------------------------------------------------*/
+/* SetFrameResultLayout : Get the result of stbINPUT read in place from caller memory described by a layout */
+/*------------------------------------------------------------------------------------------------------------------*/
+STB_INT32 SetFrameResultLayout (    STBHANDLE                            handle        ,
+                                    STB_INT32                            nBodyCount    ,
+                                    const VOID                            *body        ,
+                                    const STB_FRAME_LAYOUT_DETECTION    *bodyLayout    ,
+                                    STB_INT32                            nFaceCount    ,
+                                    const VOID                            *face        ,
+                                    const STB_FRAME_LAYOUT_FACE            *faceLayout    )
+{
+
+    STB_INT32 nRet;
+
+    /*NULL check*/
+    nRet = IsValidPointer(handle);
+    if(nRet != STB_NORMAL)
+    {
+        return STB_ERR_NOHANDLE;
+    }
+    if( handle->execFlg->bodyTr == STB_TRUE && nBodyCount > 0 )
+    {
+        if( IsValidPointer(body) != STB_NORMAL || IsValidPointer(bodyLayout) != STB_NORMAL || ( size_t )( body ) % sizeof( STB_INT32 ) != 0 )
+        {
+            return STB_ERR_INVALIDPARAM;
+        }
+    }
+    if( handle->execFlg->faceTr == STB_TRUE && nFaceCount > 0 )
+    {
+        if( IsValidPointer(face) != STB_NORMAL || IsValidPointer(faceLayout) != STB_NORMAL || ( size_t )( face ) % sizeof( STB_INT32 ) != 0 )
+        {
+            return STB_ERR_INVALIDPARAM;
+        }
+    }
+
+    /*Count and layout check (the values are checked while they are read)*/
+    nRet = STB_IsValidLayout ( nBodyCount , bodyLayout , nFaceCount , faceLayout , handle->nDetCntMax , handle->execFlg );
     if(nRet != STB_TRUE)
     {
         return STB_ERR_INVALIDPARAM;
     }
 
 
-    /*Clear the unexecuted state flag*/
-    handle->nExecuted = STB_FALSE;
+    /*Clear the unexecuted state flag : a frame rejected part way leaves nothing to execute*/
+    handle->nExecuted    = STB_FALSE;
+    handle->nInitialized = STB_FALSE;
 
-    /*Set the received result to the handle*/
+    /*Read the received result straight into the tracking input and the face information*/
     if( handle->execFlg->bodyTr == STB_TRUE )
     {
-        handle->nDetCntBody = stbINPUTResult->bodys.nCount;
-        SetTrackingObjectBody ( &(stbINPUTResult->bodys)    ,handle->trBody    );
+        handle->nDetCntBody = nBodyCount;
+        nRet = SetTrackingObjectBodyLayout ( nBodyCount , (const STB_INT8*)body , bodyLayout , handle->wSrcTr );
+        if(nRet != STB_TRUE)
+        {
+            return STB_ERR_INVALIDPARAM;
+        }
     }
     if( handle->execFlg->faceTr == STB_TRUE )
     {
-        handle->nDetCntFace = stbINPUTResult->faces.nCount;
-        SetTrackingObjectFace ( &(stbINPUTResult->faces)    ,handle->trFace    );
+        handle->nDetCntFace = nFaceCount;
+        nRet = SetTrackingObjectFaceLayout ( nFaceCount , (const STB_INT8*)face , faceLayout , handle->wSrcTr );
+        if(nRet != STB_TRUE)
+        {
+            return STB_ERR_INVALIDPARAM;
+        }
     }
 
     /*Set detection result to Face/Property/Recognition data*/
@@ -431,7 +745,11 @@ STB_INT32 SetFrameResult ( STBHANDLE handle    , const STB_FRAME_RESULT *stbINPU
         ||    handle->execFlg->bli    == STB_TRUE 
         )
     {
-        SetFaceObject ( &(stbINPUTResult->faces)    ,handle->infoFace    ,handle->execFlg , handle->nTraCntMax );
+        nRet = SetFaceObjectLayout ( nFaceCount , (const STB_INT8*)face , faceLayout , handle->infoFace , handle->execFlg , handle->nTraCntMax );
+        if(nRet != STB_TRUE)
+        {
+            return STB_ERR_INVALIDPARAM;
+        }
     }
 
 
@@ -449,6 +767,8 @@ STB_INT32 Execute ( STBHANDLE handle )
     STB_TR_DET            *srcTr        = handle->wSrcTr    ;/*TR : input data*/
     STB_TR_RES_FACES    *dstTrFace    = handle->wDstTrFace;/*TR : output data*/
     STB_TR_RES_BODYS    *dstTrBody    = handle->wDstTrBody;/*TR : output data*/
+    STB_TR_EVENTS        *dstTrFcEvt    = handle->wDstTrFcEvt;/*TR : output events*/
+    STB_TR_EVENTS        *dstTrBdEvt    = handle->wDstTrBdEvt;/*TR : output events*/
     STB_PE_DET            *srcPe        = handle->wSrcPe    ;/*PR : Input data*/
     STB_PE_RES            *dstPe        = handle->wDstPe    ;/*PE : Output data*/
     STB_FR_DET            *srcFr        = handle->wSrcFr    ;/*FR : Input data*/
@@ -469,17 +789,10 @@ STB_INT32 Execute ( STBHANDLE handle )
     }
     handle->nInitialized = STB_FALSE;
     handle->nExecuted    = STB_FALSE;
+    handle->nEventCnt    = 0;
 
     /* TR ------------------------------------------------------------------------------------------------*/
-    if( handle->execFlg->faceTr    == STB_TRUE )
-    {
-        SetSrcTrFace ( handle->nDetCntFace , handle->trFace , srcTr );            /*Creation of tracking input data from handle information*/
-    }
-    if( handle->execFlg->bodyTr    == STB_TRUE )
-    {
-        SetSrcTrBody ( handle->nDetCntBody , handle->trBody , srcTr );            /*Creation of tracking input data from handle information*/
-    }
-    nRet = STB_Tr_SetDetect    ( handle->hTrHandle , srcTr);                        /*Frame information settings*/
+    nRet = STB_Tr_SetDetect    ( handle->hTrHandle , srcTr);                        /*Frame information settings (srcTr was made by SetFrameResult)*/
     if( nRet != STB_NORMAL)    { return nRet;    }
     nRet = STB_Tr_Execute    ( handle->hTrHandle );                                /*execute tracking*/
     if( nRet != STB_NORMAL)    { return nRet;    }
@@ -493,6 +806,16 @@ STB_INT32 Execute ( STBHANDLE handle )
     {
         SetTrackingInfoToBody    ( dstTrBody,&(handle->nTraCntBody),handle->trBody);/*copy to handle the tracking result*/
     }
+    nRet = STB_Tr_GetEvents    ( handle->hTrHandle , dstTrFcEvt , dstTrBdEvt );    /*get the tracking events*/
+    if( nRet != STB_NORMAL)    { return nRet;    }
+    if( handle->execFlg->faceTr    == STB_TRUE )
+    {
+        SetTrEventToEvent        ( dstTrFcEvt,STB_EVENT_TARGET_FACE,handle->event,&(handle->nEventCnt));/*copy to handle the tracking events*/
+    }
+    if( handle->execFlg->bodyTr    == STB_TRUE )
+    {
+        SetTrEventToEvent        ( dstTrBdEvt,STB_EVENT_TARGET_BODY,handle->event,&(handle->nEventCnt));/*copy to handle the tracking events*/
+    }
 
 
     /*Association of face information and tracking ID--------------------------------------------------------------------------------*/
@@ -505,7 +828,7 @@ STB_INT32 Execute ( STBHANDLE handle )
         ||    handle->execFlg->bli    == STB_TRUE 
         )
     {
-        SetTrackingIDToFace        ( handle->nTraCntFace ,handle->nDetCntFace, handle->trFace,handle->infoFace , handle->execFlg );
+        SetTrackingIDToFace        ( handle->nTraCntFace ,handle->nDetCntFace, handle->trFace,handle->infoFace , handle->execFlg , handle->wDetTra , handle->wTraFace );
     }
 
     /* Fr ------------------------------------------------------------------------------------------------*/
@@ -531,16 +854,32 @@ STB_INT32 Execute ( STBHANDLE handle )
         ||    handle->execFlg->bli    == STB_TRUE 
         )
     {
-        SetFaceToPeInfo            ( handle->nTraCntFace,handle->infoFace,srcPe    );    /*Creation of property input data from handle information*/
+        if( handle->nPeSettled == STB_TRUE )
+        {
+            SetSettledToFace    ( handle->nTraCntFace,handle->infoFace,handle->settled,handle->nSettledCnt,handle->settledHash,handle->settledHashMask,handle->wFaceSettled );/*The faces FIXED in the previous frame are not passed to PE*/
+        }
+        SetFaceToPeInfo            ( handle->nTraCntFace,handle->infoFace,handle->wFaceSettled,srcPe    );    /*Creation of property input data from handle information*/
         nRet = STB_Pe_SetDetect    ( handle->hPeHandle,srcPe                        );    /*Pass to property stabilization*/
         if( nRet != STB_NORMAL    ){    return nRet;    }
         nRet = STB_Pe_Execute    ( handle->hPeHandle                                );    /*Property stabilization execution*/
         if( nRet != STB_NORMAL    ){    return nRet;    }
         nRet = STB_Pe_GetResult    ( handle->hPeHandle,dstPe                        );    /*get the property stabilization results*/
         if( nRet != STB_NORMAL    ){    return nRet;    }
-        SetPeInfoToFace            ( handle->nTraCntFace,dstPe,handle->infoFace , handle->execFlg );    /*Copy to handle the property stabilization results*/
+        SetPeInfoToFace            ( handle->nTraCntFace,dstPe,handle->wFaceSettled,handle->settled,handle->infoFace , handle->execFlg );    /*Copy to handle the property stabilization results*/
+        if( handle->nPeSettled == STB_TRUE )
+        {
+            SetFaceToSettled    ( handle->nTraCntFace,handle->infoFace,handle->execFlg,handle->settled,&(handle->nSettledCnt),handle->settledHash,handle->settledHashMask );
+        }
     }
 
+    /* Event ---------------------------------------------------------------------------------------------*/
+    if(        handle->execFlg->gen    == STB_TRUE 
+        ||    handle->execFlg->age    == STB_TRUE 
+        ||    handle->execFlg->fr        == STB_TRUE 
+        )
+    {
+        SetFaceToEvent            ( handle->nTraCntFace,handle->infoFace,handle->execFlg,handle->event,&(handle->nEventCnt));/*Add the events of the stabilization done*/
+    }
 
 
     /*Set execution completion flag--------------------------------------------------*/
@@ -552,8 +891,16 @@ STB_INT32 Execute ( STBHANDLE handle )
 /* GetFaces : Getting stabilization results of face*/
 /*------------------------------------------------------------------------------------------------------------------*/
 STB_INT32 GetFaces(STBHANDLE handle, STB_UINT32 *face_count, STB_FACE *face )
+{
+    return GetFacesEx( handle , TRACK_CNT_MAX , face_count , face );
+}
+/*------------------------------------------------------------------------------------------------------------------*/
+/* GetFacesEx : Getting stabilization results of face (up to face_max people)*/
+/*------------------------------------------------------------------------------------------------------------------*/
+STB_INT32 GetFacesEx(STBHANDLE handle, STB_UINT32 face_max, STB_UINT32 *face_count, STB_FACE *face )
 {
     STB_INT32 nRet , i;
+    STB_INT32 nResMax , nResCnt;
 
     /*NULL check*/
     nRet = IsValidPointer(handle);
@@ -577,8 +924,13 @@ STB_INT32 GetFaces(STBHANDLE handle, STB_UINT32 *face_count, STB_FACE *face )
     }
 
     /*init*/
+    nResMax = handle->nTraCntMax;
+    if( face_max < (STB_UINT32)nResMax )
+    {
+        nResMax = (STB_INT32)face_max;
+    }
     *face_count = 0;
-    for( i = 0 ; i < handle->nTraCntMax ; i++ )
+    for( i = 0 ; i < nResMax ; i++ )
     {
         face[i].nDetectID                = -1;
         face[i].nTrackingID                = -1;
@@ -615,8 +967,9 @@ STB_INT32 GetFaces(STBHANDLE handle, STB_UINT32 *face_count, STB_FACE *face )
     /*Set the result to the structure*/
     if( handle->execFlg->faceTr == STB_TRUE )
     {
-        *face_count = handle->nTraCntFace;
-        SetFaceToResult ( handle->nTraCntFace ,handle->trFace ,handle->infoFace ,face , handle->execFlg );
+        nResCnt = handle->nTraCntFace < nResMax ? handle->nTraCntFace : nResMax;
+        *face_count = nResCnt;
+        SetFaceToResult ( nResCnt ,handle->trFace ,handle->infoFace ,face , handle->execFlg , handle->wTraFace );
     }
     
     return STB_NORMAL;
@@ -625,8 +978,16 @@ STB_INT32 GetFaces(STBHANDLE handle, STB_UINT32 *face_count, STB_FACE *face )
 /* GetBodies : Getting stabilization results of body */
 /*------------------------------------------------------------------------------------------------------------------*/
 STB_INT32 GetBodies(STBHANDLE handle, STB_UINT32 *body_count, STB_BODY *body)
+{
+    return GetBodiesEx( handle , TRACK_CNT_MAX , body_count , body );
+}
+/*------------------------------------------------------------------------------------------------------------------*/
+/* GetBodiesEx : Getting stabilization results of body (up to body_max people) */
+/*------------------------------------------------------------------------------------------------------------------*/
+STB_INT32 GetBodiesEx(STBHANDLE handle, STB_UINT32 body_max, STB_UINT32 *body_count, STB_BODY *body)
 {
     STB_INT32 nRet , i;
+    STB_INT32 nResMax , nResCnt;
 
     /*NULL check*/
     nRet = IsValidPointer(handle);
@@ -647,8 +1008,13 @@ STB_INT32 GetBodies(STBHANDLE handle, STB_UINT32 *body_count, STB_BODY *body)
 
 
     /*init*/
+    nResMax = handle->nTraCntMax;
+    if( body_max < (STB_UINT32)nResMax )
+    {
+        nResMax = (STB_INT32)body_max;
+    }
     *body_count = 0;
-    for( i = 0 ; i < handle->nTraCntMax ; i++ )
+    for( i = 0 ; i < nResMax ; i++ )
     {
         body[i].nDetectID        = -1;
         body[i].nTrackingID        = -1;
@@ -661,8 +1027,47 @@ STB_INT32 GetBodies(STBHANDLE handle, STB_UINT32 *body_count, STB_BODY *body)
     /*Set the result to the structure*/
     if( handle->execFlg->bodyTr == STB_TRUE )
     {
-        *body_count = handle->nTraCntBody;
-        SetBodyToResult(handle->nTraCntBody,handle->trBody, body);
+        nResCnt = handle->nTraCntBody < nResMax ? handle->nTraCntBody : nResMax;
+        *body_count = nResCnt;
+        SetBodyToResult(nResCnt,handle->trBody, body);
+    }
+    return STB_NORMAL;
+}
+/*------------------------------------------------------------------------------------------------------------------*/
+/* GetEvents : Getting the events of the present frame (up to event_max events) */
+/*------------------------------------------------------------------------------------------------------------------*/
+STB_INT32 GetEvents(STBHANDLE handle, STB_UINT32 event_max, STB_UINT32 *event_count, STB_EVENT *event)
+{
+    STB_INT32 nRet , i;
+    STB_INT32 nResCnt;
+
+    /*NULL check*/
+    nRet = IsValidPointer(handle);
+    if(nRet != STB_NORMAL){
+        return STB_ERR_NOHANDLE;
+    }
+    nRet = IsValidPointer(event_count);
+    if(nRet != STB_NORMAL){
+        return nRet;
+    }
+    nRet = IsValidPointer(event);
+    if(nRet != STB_NORMAL){
+        return nRet;
+    }
+    if(    handle->nExecuted != STB_TRUE){
+        return STB_ERR_INITIALIZE;
+    }
+
+    /*Set the result to the structure*/
+    nResCnt = handle->nEventCnt;
+    if( event_max < (STB_UINT32)nResCnt )
+    {
+        nResCnt = (STB_INT32)event_max;
+    }
+    *event_count = nResCnt;
+    for( i = 0 ; i < nResCnt ; i++ )
+    {
+        event[i] = handle->event[i];
     }
     return STB_NORMAL;
 }
@@ -681,6 +1086,7 @@ STB_INT32 Clear(STBHANDLE handle)
 
     STB_Tr_Clear( handle->hTrHandle    );
     STB_Pe_Clear( handle->hPeHandle    );
+    handle->nSettledCnt = 0;/*the hash is rebuilt in the next execution*/
     if( handle->execFlg->fr    == STB_TRUE )
     {
         STB_Fr_Clear( handle->hFrHandle    );
@@ -740,6 +1146,72 @@ STB_INT32 GetTrackingSteadinessParam(STBHANDLE handle, STB_INT32 *pnPosSteadines
     return STB_Tr_GetStedinessParam(handle->hTrHandle, pnPosSteadinessParam, pnSizeSteadinessParam);
 }
 
+STB_INT32 SetTrackingAssociationMode(STBHANDLE handle, STB_INT32 nMode){
+    STB_INT32 nRet;
+    /*NULL check*/
+    nRet = IsValidPointer(handle);
+    if(nRet != STB_NORMAL){
+        return STB_ERR_NOHANDLE;
+    }
+
+    return STB_Tr_SetAssociationMode(handle->hTrHandle, nMode);
+}
+
+STB_INT32 GetTrackingAssociationMode(STBHANDLE handle, STB_INT32 *pnMode){
+    STB_INT32 nRet;
+    /*NULL check*/
+    nRet = IsValidPointer(handle);
+    if(nRet != STB_NORMAL){
+        return STB_ERR_NOHANDLE;
+    }
+
+    return STB_Tr_GetAssociationMode(handle->hTrHandle, pnMode);
+}
+
+STB_INT32 SetTrackingAssociationRange(STBHANDLE handle, STB_INT32 nRange){
+    STB_INT32 nRet;
+    /*NULL check*/
+    nRet = IsValidPointer(handle);
+    if(nRet != STB_NORMAL){
+        return STB_ERR_NOHANDLE;
+    }
+
+    return STB_Tr_SetAssociationRange(handle->hTrHandle, nRange);
+}
+
+STB_INT32 GetTrackingAssociationRange(STBHANDLE handle, STB_INT32 *pnRange){
+    STB_INT32 nRet;
+    /*NULL check*/
+    nRet = IsValidPointer(handle);
+    if(nRet != STB_NORMAL){
+        return STB_ERR_NOHANDLE;
+    }
+
+    return STB_Tr_GetAssociationRange(handle->hTrHandle, pnRange);
+}
+
+STB_INT32 SetTrackingMotionParam(STBHANDLE handle, STB_INT32 nVelocityGain){
+    STB_INT32 nRet;
+    /*NULL check*/
+    nRet = IsValidPointer(handle);
+    if(nRet != STB_NORMAL){
+        return STB_ERR_NOHANDLE;
+    }
+
+    return STB_Tr_SetMotionParam(handle->hTrHandle, nVelocityGain);
+}
+
+STB_INT32 GetTrackingMotionParam(STBHANDLE handle, STB_INT32 *pnVelocityGain){
+    STB_INT32 nRet;
+    /*NULL check*/
+    nRet = IsValidPointer(handle);
+    if(nRet != STB_NORMAL){
+        return STB_ERR_NOHANDLE;
+    }
+
+    return STB_Tr_GetMotionParam(handle->hTrHandle, pnVelocityGain);
+}
+
 STB_INT32 SetPropertyThreshold(STBHANDLE handle, STB_INT32 nThreshold){
     STB_INT32 nRet;
     /*NULL check*/
@@ -18,12 +18,16 @@
 #define _INTERFACE_H_
 #include "STBTypedefInput.h"
 #include "STBHandle.h"
+#include "STBCommonDef.h"
 
 #define VERSION_MAJOR        (    1    )
 #define VERSION_MINOR        (    1    )
 
-#define DETECT_CNT_MAX        (    35    )    /*A maximum number of detected(input) people*/
-#define TRACK_CNT_MAX        (    35    )    /*A maximum number of tracking(output) people*/
+#define DETECT_CNT_MAX        (    STB_CNT_MAX_DEFAULT    )    /*A maximum number of detected(input) people*/
+#define TRACK_CNT_MAX        (    STB_CNT_MAX_DEFAULT    )    /*A maximum number of tracking(output) people*/
+#define FRAME_RESULT_CNT_MAX    (    35    )    /*Capacity of STB_FRAME_RESULT_BODYS/FACES*/
+#define TR_EVENT_CNT_PER_TRACK    (    2    )    /*Tracking events per track and frame : exit of a released ID + enter/lost/found*/
+#define EVENT_CNT_PER_TRACK        (    7    )    /*Events per track and frame : face and body tracking events + age/gender/recognition*/
 
 #ifdef  __cplusplus
 extern "C" {
@@ -32,18 +36,33 @@ extern "C" {
 /*-------------------------------------------------------------------------------------------------------------------*/
 STB_INT32 GetVersion        (STB_INT8* pnMajorVersion , STB_INT8* pnMinorVersion );
 STBHANDLE CreateHandle        (STB_UINT32 stbExecFlg );
+STBHANDLE CreateHandleEx        (STB_UINT32 stbExecFlg , STB_INT32 nDetCntMax , STB_INT32 nTraCntMax );
+STBHANDLE CreateHandleEx2        (STB_UINT32 stbExecFlg , STB_INT32 nDetCntMax , STB_INT32 nTraCntMax , STB_INT32 nPeBackMax , STB_INT32 nFrBackMax );
+STB_UINT32 GetRequiredMemorySize    (STB_UINT32 stbExecFlg , STB_INT32 nDetCntMax , STB_INT32 nTraCntMax , STB_INT32 nPeBackMax , STB_INT32 nFrBackMax );
+STBHANDLE CreateHandleInPlace    (VOID *pMem , STB_UINT32 nMemSize , STB_UINT32 stbExecFlg , STB_INT32 nDetCntMax , STB_INT32 nTraCntMax , STB_INT32 nPeBackMax , STB_INT32 nFrBackMax );
 STB_INT32 DeleteHandle        (STBHANDLE handle);
 STB_INT32 SetFrameResult    (STBHANDLE handle,const STB_FRAME_RESULT *stbINPUTResult);
+STB_INT32 SetFrameResultEx    (STBHANDLE handle,STB_INT32 nBodyCount,const STB_FRAME_RESULT_DETECTION *body,STB_INT32 nFaceCount,const STB_FRAME_RESULT_FACE *face);
+STB_INT32 SetFrameResultLayout(STBHANDLE handle,STB_INT32 nBodyCount,const VOID *body,const STB_FRAME_LAYOUT_DETECTION *bodyLayout,STB_INT32 nFaceCount,const VOID *face,const STB_FRAME_LAYOUT_FACE *faceLayout);
 STB_INT32 Execute            (STBHANDLE handle);
 /*-------------------------------------------------------------------------------------------------------------------*/
 STB_INT32 GetFaces    (STBHANDLE handle, STB_UINT32 *face_count, STB_FACE face[35]);
 STB_INT32 GetBodies    (STBHANDLE handle, STB_UINT32 *body_count, STB_BODY body[35]);
+STB_INT32 GetFacesEx    (STBHANDLE handle, STB_UINT32 face_max, STB_UINT32 *face_count, STB_FACE *face);
+STB_INT32 GetBodiesEx    (STBHANDLE handle, STB_UINT32 body_max, STB_UINT32 *body_count, STB_BODY *body);
+STB_INT32 GetEvents    (STBHANDLE handle, STB_UINT32 event_max, STB_UINT32 *event_count, STB_EVENT *event);
 STB_INT32 Clear        (STBHANDLE handle);
 /*-------------------------------------------------------------------------------------------------------------------*/
 STB_INT32 SetTrackingRetryCount            (STBHANDLE handle, STB_INT32 nMaxRetryCount        );
 STB_INT32 GetTrackingRetryCount            (STBHANDLE handle, STB_INT32 *pnMaxRetryCount    );
 STB_INT32 SetTrackingSteadinessParam    (STBHANDLE handle, STB_INT32 nPosSteadinessParam    , STB_INT32 nSizeSteadinessParam    );
 STB_INT32 GetTrackingSteadinessParam    (STBHANDLE handle, STB_INT32 *pnPosSteadinessParam    , STB_INT32 *pnSizeSteadinessParam    );
+STB_INT32 SetTrackingAssociationMode    (STBHANDLE handle, STB_INT32 nMode        );
+STB_INT32 GetTrackingAssociationMode    (STBHANDLE handle, STB_INT32 *pnMode    );
+STB_INT32 SetTrackingAssociationRange    (STBHANDLE handle, STB_INT32 nRange        );
+STB_INT32 GetTrackingAssociationRange    (STBHANDLE handle, STB_INT32 *pnRange    );
+STB_INT32 SetTrackingMotionParam        (STBHANDLE handle, STB_INT32 nVelocityGain    );
+STB_INT32 GetTrackingMotionParam        (STBHANDLE handle, STB_INT32 *pnVelocityGain);
 /*-------------------------------------------------------------------------------------------------------------------*/
 STB_INT32 SetPropertyThreshold            (STBHANDLE handle, STB_INT32 nThreshold        );
 STB_INT32 GetPropertyThreshold            (STBHANDLE handle, STB_INT32 *pnThreshold    );
@@ -28,6 +28,18 @@ STB_INT32 STB_GetVersion(STB_INT8* pnMajorVersion, STB_INT8* pnMinorVersion){
 HSTB STB_CreateHandle(STB_UINT32 stbExecFlg){
     return (HSTB)CreateHandle(stbExecFlg);
 }
+HSTB STB_CreateHandleEx(STB_UINT32 stbExecFlg, STB_INT32 nDetCntMax, STB_INT32 nTraCntMax){
+    return (HSTB)CreateHandleEx(stbExecFlg, nDetCntMax, nTraCntMax);
+}
+HSTB STB_CreateHandleEx2(STB_UINT32 stbExecFlg, STB_INT32 nDetCntMax, STB_INT32 nTraCntMax, STB_INT32 nPeBackMax, STB_INT32 nFrBackMax){
+    return (HSTB)CreateHandleEx2(stbExecFlg, nDetCntMax, nTraCntMax, nPeBackMax, nFrBackMax);
+}
+STB_UINT32 STB_GetRequiredMemorySize(STB_UINT32 stbExecFlg, STB_INT32 nDetCntMax, STB_INT32 nTraCntMax, STB_INT32 nPeBackMax, STB_INT32 nFrBackMax){
+    return GetRequiredMemorySize(stbExecFlg, nDetCntMax, nTraCntMax, nPeBackMax, nFrBackMax);
+}
+HSTB STB_CreateHandleInPlace(VOID *pBuffer, STB_UINT32 nBufferSize, STB_UINT32 stbExecFlg, STB_INT32 nDetCntMax, STB_INT32 nTraCntMax, STB_INT32 nPeBackMax, STB_INT32 nFrBackMax){
+    return (HSTB)CreateHandleInPlace(pBuffer, nBufferSize, stbExecFlg, nDetCntMax, nTraCntMax, nPeBackMax, nFrBackMax);
+}
 VOID STB_DeleteHandle(HSTB handle){
     DeleteHandle((STBHANDLE)handle);
 }
@@ -35,6 +47,12 @@ VOID STB_DeleteHandle(HSTB handle){
 STB_INT32 STB_SetFrameResult(HSTB handle, const STB_FRAME_RESULT *stbINPUTResult){
     return SetFrameResult((STBHANDLE)handle, stbINPUTResult);
 }
+STB_INT32 STB_SetFrameResultEx(HSTB handle, STB_INT32 nBodyCount, const STB_FRAME_RESULT_DETECTION body[], STB_INT32 nFaceCount, const STB_FRAME_RESULT_FACE face[]){
+    return SetFrameResultEx((STBHANDLE)handle, nBodyCount, body, nFaceCount, face);
+}
+STB_INT32 STB_SetFrameResultLayout(HSTB handle, STB_INT32 nBodyCount, const VOID *body, const STB_FRAME_LAYOUT_DETECTION *bodyLayout, STB_INT32 nFaceCount, const VOID *face, const STB_FRAME_LAYOUT_FACE *faceLayout){
+    return SetFrameResultLayout((STBHANDLE)handle, nBodyCount, body, bodyLayout, nFaceCount, face, faceLayout);
+}
 STB_INT32 STB_ClearFrameResults(HSTB handle){
     return Clear((STBHANDLE)handle);
 }
@@ -49,6 +67,15 @@ STB_INT32 STB_GetFaces(HSTB handle, STB_UINT32 *face_count, STB_FACE face[35]){
 STB_INT32 STB_GetBodies(HSTB handle, STB_UINT32 *body_count, STB_BODY body[35]){
     return GetBodies((STBHANDLE)handle, body_count, body);
 }
+STB_INT32 STB_GetFacesEx(HSTB handle, STB_UINT32 face_max, STB_UINT32 *face_count, STB_FACE face[]){
+    return GetFacesEx((STBHANDLE)handle, face_max, face_count, face);
+}
+STB_INT32 STB_GetBodiesEx(HSTB handle, STB_UINT32 body_max, STB_UINT32 *body_count, STB_BODY body[]){
+    return GetBodiesEx((STBHANDLE)handle, body_max, body_count, body);
+}
+STB_INT32 STB_GetEvents(HSTB handle, STB_UINT32 event_max, STB_UINT32 *event_count, STB_EVENT event[]){
+    return GetEvents((STBHANDLE)handle, event_max, event_count, event);
+}
 
 /*Setting / Getting Function for tracking*/
 STB_INT32   STB_SetTrRetryCount(HSTB hHandle, STB_INT32 nMaxRetryCount){
@@ -63,6 +90,24 @@ STB_INT32 STB_SetTrSteadinessParam(HSTB hHandle, STB_INT32 nPosSteadinessParam,
 STB_INT32 STB_GetTrSteadinessParam(HSTB hHandle, STB_INT32 *pnPosSteadinessParam, STB_INT32 *pnSizeSteadinessParam){
     return GetTrackingSteadinessParam((STBHANDLE)hHandle, pnPosSteadinessParam, pnSizeSteadinessParam);
 }
+STB_INT32 STB_SetTrAssociationMode(HSTB hHandle, STB_INT32 nMode){
+    return SetTrackingAssociationMode((STBHANDLE)hHandle, nMode);
+}
+STB_INT32 STB_GetTrAssociationMode(HSTB hHandle, STB_INT32 *pnMode){
+    return GetTrackingAssociationMode((STBHANDLE)hHandle, pnMode);
+}
+STB_INT32 STB_SetTrAssociationRange(HSTB hHandle, STB_INT32 nRange){
+    return SetTrackingAssociationRange((STBHANDLE)hHandle, nRange);
+}
+STB_INT32 STB_GetTrAssociationRange(HSTB hHandle, STB_INT32 *pnRange){
+    return GetTrackingAssociationRange((STBHANDLE)hHandle, pnRange);
+}
+STB_INT32 STB_SetTrMotionParam(HSTB hHandle, STB_INT32 nVelocityGain){
+    return SetTrackingMotionParam((STBHANDLE)hHandle, nVelocityGain);
+}
+STB_INT32 STB_GetTrMotionParam(HSTB hHandle, STB_INT32 *pnVelocityGain){
+    return GetTrackingMotionParam((STBHANDLE)hHandle, pnVelocityGain);
+}
 
 /*Setting / Getting Function for property*/
 STB_INT32 STB_SetPeThresholdUse(HSTB hHandle, STB_INT32 nThreshold){
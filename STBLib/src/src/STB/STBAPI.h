@@ -33,22 +33,39 @@ extern "C" {
 /*Create/Delete handle*/
 STB_INT32    STB_GetVersion(STB_INT8* pnMajorVersion, STB_INT8* pnMinorVersion);
 HSTB         STB_CreateHandle(STB_UINT32 unUseFuncFlag);
+HSTB         STB_CreateHandleEx(STB_UINT32 unUseFuncFlag, STB_INT32 nDetectCountMax, STB_INT32 nTrackCountMax);
+HSTB         STB_CreateHandleEx2(STB_UINT32 unUseFuncFlag, STB_INT32 nDetectCountMax, STB_INT32 nTrackCountMax, STB_INT32 nPeHistoryDepth, STB_INT32 nFrHistoryDepth);
+/* Size of the buffer for STB_CreateHandleInPlace with the same parameters as STB_CreateHandleEx2 (0 : invalid parameter) */
+STB_UINT32   STB_GetRequiredMemorySize(STB_UINT32 unUseFuncFlag, STB_INT32 nDetectCountMax, STB_INT32 nTrackCountMax, STB_INT32 nPeHistoryDepth, STB_INT32 nFrHistoryDepth);
+/* Create handle in the buffer given by the caller without allocating memory (the buffer is kept until STB_DeleteHandle) */
+HSTB         STB_CreateHandleInPlace(VOID *pBuffer, STB_UINT32 unBufferSize, STB_UINT32 unUseFuncFlag, STB_INT32 nDetectCountMax, STB_INT32 nTrackCountMax, STB_INT32 nPeHistoryDepth, STB_INT32 nFrHistoryDepth);
 VOID         STB_DeleteHandle(HSTB hSTB);
 
 /*set frame information*/
 STB_INT32    STB_SetFrameResult(HSTB hSTB, const STB_FRAME_RESULT *stFrameResult);
+STB_INT32    STB_SetFrameResultEx(HSTB hSTB, STB_INT32 nBodyCount, const STB_FRAME_RESULT_DETECTION stBody[], STB_INT32 nFaceCount, const STB_FRAME_RESULT_FACE stFace[]);
+STB_INT32    STB_SetFrameResultLayout(HSTB hSTB, STB_INT32 nBodyCount, const VOID *pBody, const STB_FRAME_LAYOUT_DETECTION *pBodyLayout, STB_INT32 nFaceCount, const VOID *pFace, const STB_FRAME_LAYOUT_FACE *pFaceLayout);
 STB_INT32    STB_ClearFrameResults(HSTB hSTB);
 /*Main process execution*/
 STB_INT32    STB_Execute(HSTB hSTB);
 /*get the result*/
 STB_INT32    STB_GetFaces(HSTB hSTB, STB_UINT32 *punFaceCount, STB_FACE stFace[]);
 STB_INT32    STB_GetBodies(HSTB hSTB, STB_UINT32 *punBodyCount, STB_BODY stBody[]);
+STB_INT32    STB_GetFacesEx(HSTB hSTB, STB_UINT32 unFaceMax, STB_UINT32 *punFaceCount, STB_FACE stFace[]);
+STB_INT32    STB_GetBodiesEx(HSTB hSTB, STB_UINT32 unBodyMax, STB_UINT32 *punBodyCount, STB_BODY stBody[]);
+STB_INT32    STB_GetEvents(HSTB hSTB, STB_UINT32 unEventMax, STB_UINT32 *punEventCount, STB_EVENT stEvent[]);
 
 /*Setting / Getting Function for tracking*/
 STB_INT32    STB_SetTrRetryCount(HSTB hSTB, STB_INT32 nMaxRetryCount);
 STB_INT32    STB_GetTrRetryCount(HSTB hSTB, STB_INT32 *pnMaxRetryCount);
 STB_INT32    STB_SetTrSteadinessParam(HSTB hSTB, STB_INT32 nPosSteadinessParam, STB_INT32 nSizeSteadinessParam);
 STB_INT32    STB_GetTrSteadinessParam(HSTB hSTB, STB_INT32 *pnPosSteadinessParam, STB_INT32 *pnSizeSteadinessParam);
+STB_INT32    STB_SetTrAssociationMode(HSTB hSTB, STB_INT32 nMode);
+STB_INT32    STB_GetTrAssociationMode(HSTB hSTB, STB_INT32 *pnMode);
+STB_INT32    STB_SetTrAssociationRange(HSTB hSTB, STB_INT32 nRange);
+STB_INT32    STB_GetTrAssociationRange(HSTB hSTB, STB_INT32 *pnRange);
+STB_INT32    STB_SetTrMotionParam(HSTB hSTB, STB_INT32 nVelocityGain);
+STB_INT32    STB_GetTrMotionParam(HSTB hSTB, STB_INT32 *pnVelocityGain);
 /*Setting / Getting Function for property*/
 STB_INT32    STB_SetPeThresholdUse(HSTB hSTB, STB_INT32 nThreshold);
 STB_INT32    STB_GetPeThresholdUse(HSTB hSTB, STB_INT32 *pnThreshold);
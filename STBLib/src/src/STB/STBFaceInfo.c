@@ -149,15 +149,11 @@ static VOID ClearFace ( FaceObj *face , int  i , const STBExecFlg *execFlg )
 /*------------------------------------------------------------------------------------------------------------------*/
 /* SetFaceObject : Copy the tracking information */
 /*------------------------------------------------------------------------------------------------------------------*/
-VOID SetFaceObject( const STB_FRAME_RESULT_FACES* stbINPUTfaces    ,FaceObj *faces    , const STBExecFlg *execFlg , const STB_INT32 nTraCntMax)
+VOID SetFaceObject( STB_INT32 nCount , const STB_FRAME_RESULT_FACE* stbINPUTfaces    ,FaceObj *faces    , const STBExecFlg *execFlg , const STB_INT32 nTraCntMax)
 {
-    STB_INT32 nCount;
     STB_INT32 i,nIdx1;
 
 
-    nCount = stbINPUTfaces->nCount;
-
-
     for (i = 0; i < nCount; i++)
     {
         faces[i].nDetID    = i;
@@ -168,19 +164,19 @@ VOID SetFaceObject( const STB_FRAME_RESULT_FACES* stbINPUTfaces    ,FaceObj *fac
     {
         for (i = 0; i < nCount; i++)
         {
-            faces[i].dirConf    = stbINPUTfaces->face[i].direction.nConfidence;
-            faces[i].dirYaw        = stbINPUTfaces->face[i].direction.nLR;
-            faces[i].dirRoll    = stbINPUTfaces->face[i].direction.nRoll;
-            faces[i].dirPitch    = stbINPUTfaces->face[i].direction.nUD;
+            faces[i].dirConf    = stbINPUTfaces[i].direction.nConfidence;
+            faces[i].dirYaw        = stbINPUTfaces[i].direction.nLR;
+            faces[i].dirRoll    = stbINPUTfaces[i].direction.nRoll;
+            faces[i].dirPitch    = stbINPUTfaces[i].direction.nUD;
         }
     }
     if( execFlg->age == STB_TRUE )            /*Age*/
     {
         for (i = 0; i < nCount; i++)
         {
-            faces[i].ageConf    = stbINPUTfaces->face[i].age.nConfidence;
+            faces[i].ageConf    = stbINPUTfaces[i].age.nConfidence;
             faces[i].ageStatus    = STB_STATUS_NO_DATA;
-            faces[i].ageVal        = stbINPUTfaces->face[i].age.nAge;
+            faces[i].ageVal        = stbINPUTfaces[i].age.nAge;
         }
     }
     if( execFlg->exp == STB_TRUE )            /*Facial expression*/
@@ -190,7 +186,7 @@ VOID SetFaceObject( const STB_FRAME_RESULT_FACES* stbINPUTfaces    ,FaceObj *fac
             faces[i].expConf    = -1;// not degree 
             for (nIdx1 = STB_EX_NEUTRAL; nIdx1 < STB_EX_MAX;nIdx1++)
             {
-                faces[i].expScore[ nIdx1]    = stbINPUTfaces->face[i].expression.anScore[nIdx1];
+                faces[i].expScore[ nIdx1]    = stbINPUTfaces[i].expression.anScore[nIdx1];
             }
             faces[i].expStatus    = STB_STATUS_NO_DATA;
             faces[i].expVal        = STB_EX_UNKNOWN;
@@ -200,36 +196,36 @@ VOID SetFaceObject( const STB_FRAME_RESULT_FACES* stbINPUTfaces    ,FaceObj *fac
     {
         for (i = 0; i < nCount; i++)
         {
-            faces[i].genConf    = stbINPUTfaces->face[i].gender.nConfidence;
+            faces[i].genConf    = stbINPUTfaces[i].gender.nConfidence;
             faces[i].genStatus    = STB_STATUS_NO_DATA;
-            faces[i].genVal        = stbINPUTfaces->face[i].gender.nGender;
+            faces[i].genVal        = stbINPUTfaces[i].gender.nGender;
         }
     }
     if( execFlg->gaz == STB_TRUE )            /*Gaze*/
     {
         for (i = 0; i < nCount; i++)
         {
-            faces[i].gazConf    = stbINPUTfaces->face[i].direction.nConfidence;
+            faces[i].gazConf    = stbINPUTfaces[i].direction.nConfidence;
             faces[i].gazStatus    = STB_STATUS_NO_DATA;
-            faces[i].gazLR        = stbINPUTfaces->face[i].gaze.nLR;
-            faces[i].gazUD        = stbINPUTfaces->face[i].gaze.nUD;
+            faces[i].gazLR        = stbINPUTfaces[i].gaze.nLR;
+            faces[i].gazUD        = stbINPUTfaces[i].gaze.nUD;
         }
     }
     if( execFlg->fr == STB_TRUE )            /*Face recognition*/
     {
         for (i = 0; i < nCount; i++)
         {
-            faces[i].frConf        = stbINPUTfaces->face[i].recognition.nScore;
+            faces[i].frConf        = stbINPUTfaces[i].recognition.nScore;
             faces[i].frStatus    = STB_STATUS_NO_DATA;
-            faces[i].frVal        = stbINPUTfaces->face[i].recognition.nUID;
+            faces[i].frVal        = stbINPUTfaces[i].recognition.nUID;
         }
     }
     if( execFlg->bli == STB_TRUE )            //blink
     {
         for (i = 0; i < nCount; i++)
         {
-            faces[i].bliL        = stbINPUTfaces->face[i].blink.nLeftEye;
-            faces[i].bliR        = stbINPUTfaces->face[i].blink.nRightEye;
+            faces[i].bliL        = stbINPUTfaces[i].blink.nLeftEye;
+            faces[i].bliR        = stbINPUTfaces[i].blink.nRightEye;
         }
     }
 
@@ -242,15 +238,126 @@ VOID SetFaceObject( const STB_FRAME_RESULT_FACES* stbINPUTfaces    ,FaceObj *fac
 }
 
 
+/*------------------------------------------------------------------------------------------------------------------*/
+/* SetFaceObjectLayout : Copy the face information from caller memory, checking each value as it is read */
+/*------------------------------------------------------------------------------------------------------------------*/
+STB_INT32 SetFaceObjectLayout( STB_INT32 nCount , const STB_INT8 *stbINPUTfaces , const STB_FRAME_LAYOUT_FACE *layout , FaceObj *faces , const STBExecFlg *execFlg , const STB_INT32 nTraCntMax)
+{
+    STB_INT32 i,nIdx1;
+    STB_INT32 nLR,nUD,nRoll,nConf,nDegree;
+    const STB_INT8 *elem;
+
+
+    for (i = 0 , elem = stbINPUTfaces; i < nCount; i++ , elem += layout->nStride)
+    {
+        faces[i].nDetID    = i;
+        faces[i].nTraID    = STB_STATUS_NO_DATA;
+
+        /*Face direction : checked for every property, its confidence is also that of the gaze*/
+        nLR        = STB_LAYOUT_VALUE( elem , layout->direction.nLR            , 0 );
+        nUD        = STB_LAYOUT_VALUE( elem , layout->direction.nUD            , 0 );
+        nRoll    = STB_LAYOUT_VALUE( elem , layout->direction.nRoll            , 0 );
+        nConf    = STB_LAYOUT_VALUE( elem , layout->direction.nConfidence    , 0 );
+        if( IS_OUT_RANGE( nLR    , STB_FACE_DIR_LR_MIN    , STB_FACE_DIR_LR_MAX    )    ){ return STB_FALSE;}
+        if( IS_OUT_RANGE( nUD    , STB_FACE_DIR_UD_MIN    , STB_FACE_DIR_UD_MAX    )    ){ return STB_FALSE;}
+        if( IS_OUT_RANGE( nRoll    , STB_FACE_DIR_ROLL_MIN    , STB_FACE_DIR_ROLL_MAX )    ){ return STB_FALSE;}
+        if( IS_OUT_RANGE( nConf    , STB_FACE_DIR_CONF_MIN    , STB_FACE_DIR_CONF_MAX )    ){ return STB_FALSE;}
+        if( execFlg->dir == STB_TRUE )            /*Face direction*/
+        {
+            faces[i].dirConf    = nConf;
+            faces[i].dirYaw        = nLR;
+            faces[i].dirRoll    = nRoll;
+            faces[i].dirPitch    = nUD;
+        }
+        if( execFlg->age == STB_TRUE )            /*Age*/
+        {
+            faces[i].ageConf    = STB_LAYOUT_VALUE( elem , layout->age.nConfidence    , STB_ERR_PE_CANNOT );
+            faces[i].ageStatus    = STB_STATUS_NO_DATA;
+            faces[i].ageVal        = STB_LAYOUT_VALUE( elem , layout->age.nAge            , STB_ERR_PE_CANNOT );
+            if( IS_OUT_VALUE( faces[i].ageVal    , STB_FACE_AGE_VAL_MIN    , STB_FACE_AGE_VAL_MAX    ,STB_ERR_PE_CANNOT )    ){ return STB_FALSE;}
+            if( IS_OUT_VALUE( faces[i].ageConf    , STB_FACE_AGE_CONF_MIN    , STB_FACE_AGE_CONF_MAX    ,STB_ERR_PE_CANNOT )    ){ return STB_FALSE;}
+        }
+        if( execFlg->exp == STB_TRUE )            /*Facial expression*/
+        {
+            nDegree                = STB_LAYOUT_VALUE( elem , layout->expression.nDegree    , STB_ERR_PE_CANNOT );
+            if( IS_OUT_VALUE( nDegree    , STB_FACE_EXP_DEG_MIN    , STB_FACE_EXP_DEG_MAX    ,STB_ERR_PE_CANNOT )    ){ return STB_FALSE;}
+            faces[i].expConf    = -1;// not degree 
+            for (nIdx1 = STB_EX_NEUTRAL; nIdx1 < STB_EX_MAX;nIdx1++)
+            {
+                faces[i].expScore[ nIdx1]    = STB_LAYOUT_VALUE( elem , layout->expression.anScore[nIdx1] , STB_ERR_PE_CANNOT );
+                if( IS_OUT_VALUE( faces[i].expScore[ nIdx1] ,STB_FACE_EXP_SCORE_MIN    , STB_FACE_EXP_SCORE_MAX    ,STB_ERR_PE_CANNOT )    ){ return STB_FALSE;}
+            }
+            faces[i].expStatus    = STB_STATUS_NO_DATA;
+            faces[i].expVal        = STB_EX_UNKNOWN;
+        }
+        if( execFlg->gen == STB_TRUE )            /*Gender*/
+        {
+            faces[i].genConf    = STB_LAYOUT_VALUE( elem , layout->gender.nConfidence    , STB_ERR_PE_CANNOT );
+            faces[i].genStatus    = STB_STATUS_NO_DATA;
+            faces[i].genVal        = STB_LAYOUT_VALUE( elem , layout->gender.nGender        , STB_ERR_PE_CANNOT );
+            if( IS_OUT_VALUE( faces[i].genVal    , STB_FACE_GEN_VAL_MIN    , STB_FACE_GEN_VAL_MAX    ,STB_ERR_PE_CANNOT )    ){ return STB_FALSE;}
+            if( IS_OUT_VALUE( faces[i].genConf    , STB_FACE_GEN_CONF_MIN    , STB_FACE_GEN_CONF_MAX    ,STB_ERR_PE_CANNOT )    ){ return STB_FALSE;}
+        }
+        if( execFlg->gaz == STB_TRUE )            /*Gaze*/
+        {
+            faces[i].gazConf    = nConf;
+            faces[i].gazStatus    = STB_STATUS_NO_DATA;
+            faces[i].gazLR        = STB_LAYOUT_VALUE( elem , layout->gaze.nLR    , STB_ERR_PE_CANNOT );
+            faces[i].gazUD        = STB_LAYOUT_VALUE( elem , layout->gaze.nUD    , STB_ERR_PE_CANNOT );
+            if( IS_OUT_VALUE( faces[i].gazLR    , STB_FACE_GAZE_LR_MIN    , STB_FACE_GAZE_LR_MAX    ,STB_ERR_PE_CANNOT )    ){ return STB_FALSE;}
+            if( IS_OUT_VALUE( faces[i].gazUD    , STB_FACE_GAZE_UD_MIN    , STB_FACE_GAZE_UD_MAX    ,STB_ERR_PE_CANNOT )    ){ return STB_FALSE;}
+        }
+        if( execFlg->fr == STB_TRUE )            /*Face recognition*/
+        {
+            faces[i].frConf        = STB_LAYOUT_VALUE( elem , layout->recognition.nScore    , STB_ERR_FR_CANNOT );
+            faces[i].frStatus    = STB_STATUS_NO_DATA;
+            faces[i].frVal        = STB_LAYOUT_VALUE( elem , layout->recognition.nUID        , STB_ERR_FR_CANNOT );
+            if( IS_OUT_FR_UID( faces[i].frVal    , STB_FACE_FR_UID_MIN    , STB_FACE_FR_UID_MAX    ,STB_ERR_FR_CANNOT ,STB_ERR_FR_NOID ,STB_ERR_FR_NOALBUM ) ){ return STB_FALSE;}
+            if( IS_OUT_FR_SCORE( faces[i].frConf , STB_FACE_FR_SCORE_MIN    , STB_FACE_FR_SCORE_MAX    ,STB_ERR_FR_CANNOT ,STB_ERR_FR_NOALBUM)    ){ return STB_FALSE;}
+        }
+        if( execFlg->bli == STB_TRUE )            //blink
+        {
+            faces[i].bliL        = STB_LAYOUT_VALUE( elem , layout->blink.nLeftEye    , STB_ERR_PE_CANNOT );
+            faces[i].bliR        = STB_LAYOUT_VALUE( elem , layout->blink.nRightEye    , STB_ERR_PE_CANNOT );
+            if( IS_OUT_VALUE( faces[i].bliL    , STB_FACE_BLI_L_MIN    , STB_FACE_BLI_L_MAX    ,STB_ERR_PE_CANNOT)    ){ return STB_FALSE;}
+            if( IS_OUT_VALUE( faces[i].bliR    , STB_FACE_BLI_R_MIN    , STB_FACE_BLI_R_MAX    ,STB_ERR_PE_CANNOT)    ){ return STB_FALSE;}
+        }
+    }
+
+    /*The results exceeding the detection number are initialized*/
+    for ( i = nCount; i < nTraCntMax; i++)
+    {
+        ClearFace ( faces , i  , execFlg );
+    }
+
+    return STB_TRUE;
+}
+
+
 /*------------------------------------------------------------------------------------------------------------------*/
 /* SetTrackingIDToFace : Tracking result ID is linked to face information */
 /*------------------------------------------------------------------------------------------------------------------*/
-VOID SetTrackingIDToFace(STB_INT32 TrackingNum,STB_INT32 DetectNum, TraObj *track,FaceObj *faces , const STBExecFlg *execFlg )
+VOID SetTrackingIDToFace(STB_INT32 TrackingNum,STB_INT32 DetectNum, TraObj *track,FaceObj *faces , const STBExecFlg *execFlg , STB_INT32 *detTra , STB_INT32 *traFace )
 {
-    STB_INT32 i,j;
+    STB_INT32 i,j,n;
 
 
+    /*Index of the tracking result for each detection result (the first one for the same ID)*/
+    for( i = 0 ; i < DetectNum; i++)
+    {
+        detTra[i] = -1;
+    }
+    for( j = 0 ; j < TrackingNum; j++)
+    {
+        traFace[j] = -1;
+        if( track[j].nDetID >= 0 && track[j].nDetID < DetectNum && detTra[ track[j].nDetID ] < 0 )
+        {
+            detTra[ track[j].nDetID ] = j;
+        }
+    }
+
     /*If there is a detection result erased in the tracking result, it is deleted from the face information.*/
+    n = 0;
     for( i = 0 ; i < DetectNum; i++)
     {
         /*termination if no more detected results*/
@@ -259,84 +366,150 @@ VOID SetTrackingIDToFace(STB_INT32 TrackingNum,STB_INT32 DetectNum, TraObj *trac
             break;
         }
 
-        /*Search for the same ID as the detection result from the tracking result*/
-        for( j = 0; j < TrackingNum ; j++)
+        j = detTra[ faces[i].nDetID ];
+        if( j < 0 )
         {
-            if(track[j].nDetID == faces[i].nDetID)
-            {
-                faces[i].nTraID = track[j].nTraID;
-                break;
-            }
-        }
-
-        if( j >= TrackingNum){
             /*If the detection ID is not included in the ID under tracking*/
-            ClearFace ( faces , i , execFlg);
-            for(j = j + 1 ; j < DetectNum; j++)
-            {
-                if(faces[j].nDetID < 0)
-                {
-                    /*Repeat until detection result disappears*/
-                    break;
-                }
-                /*Stuff up ahead of erasure*/
-                CopyFace ( (faces+j),(faces+j-1), execFlg );
-            }
+            continue;
         }
+        if( n != i )
+        {
+            /*Stuff up ahead of erasure*/
+            CopyFace ( (faces+i),(faces+n), execFlg );
+        }
+        faces[n].nTraID = track[j].nTraID;
+        traFace[j] = n;
+        n++;
     }
     /*After that, the processing for the face only during tracking (retry status)*/
     for( j = 0 ; j < TrackingNum; j++)
     {
         if( track[j].nDetID < 0)
         {
-            ClearFace ( faces , i , execFlg );/*It should have been cleared but just in case*/
-            faces[i].nDetID        = track[j].nDetID;
-            faces[i].nTraID        = track[j].nTraID;
-            i++;
+            ClearFace ( faces , n , execFlg );
+            faces[n].nDetID        = track[j].nDetID;
+            faces[n].nTraID        = track[j].nTraID;
+            traFace[j] = n;
+            n++;
         }
     }
+    /*The erased detection results are cleared*/
+    for( i = n ; i < DetectNum; i++)
+    {
+        ClearFace ( faces , i , execFlg );
+    }
     
     return;
 }
 /*------------------------------------------------------------------------------------------------------------------*/
+/* SettledHashTrID                                                                                                   */
+/*------------------------------------------------------------------------------------------------------------------*/
+static STB_INT32 SettledHashTrID ( STB_INT32 nTraID , STB_INT32 hashMask )
+{
+    /*Tracking IDs are mostly sequential, multiplying by an odd constant spreads them over the table.*/
+    return (STB_INT32)( ( (STB_UINT32)nTraID * 2654435761U ) & (STB_UINT32)hashMask );
+}
+/*------------------------------------------------------------------------------------------------------------------*/
+/* SetSettledToFace : Find the faces whose age/gender were FIXED in the previous frame */
+/*------------------------------------------------------------------------------------------------------------------*/
+VOID SetSettledToFace(STB_INT32 TrackingNum,const FaceObj *faces,const SettledObj *settled,STB_INT32 settledCnt,const STB_INT32 *settledHash,STB_INT32 hashMask,STB_INT32 *faceSettled)
+{
+    STB_INT32 i,h;
+
+    /*An index of settledCnt or more was left by the clear processing : it is not referred*/
+    for( i = 0 ; i < TrackingNum ; i++ )
+    {
+        faceSettled[i] = -1;
+        for( h = SettledHashTrID( faces[i].nTraID , hashMask ) ; settledHash[h] >= 0 ; h = ( h + 1 ) & hashMask )
+        {
+            if( settledHash[h] < settledCnt && settled[ settledHash[h] ].nTraID == faces[i].nTraID )
+            {
+                faceSettled[i] = settledHash[h];
+                break;
+            }
+        }
+    }
+    return;
+}
+/*------------------------------------------------------------------------------------------------------------------*/
+/* SetFaceToSettled : Keep the age/gender of the faces whose enabled ones are all FIXED for the next frame */
+/*------------------------------------------------------------------------------------------------------------------*/
+VOID SetFaceToSettled(STB_INT32 TrackingNum,const FaceObj *faces,const STBExecFlg *execFlg,SettledObj *settled,STB_INT32 *pnSettledCnt,STB_INT32 *settledHash,STB_INT32 hashMask)
+{
+    STB_INT32 i,h,n;
+
+    for( h = 0 ; h <= hashMask ; h++ )
+    {
+        settledHash[h] = -1;
+    }
+    /*PE carries FIXED results forward unchanged while the tracking person continues, so the next frame gets them from here*/
+    n = 0;
+    for( i = 0 ; i < TrackingNum ; i++ )
+    {
+        if(        ( execFlg->age != STB_TRUE || faces[i].ageStatus == STB_STATUS_FIXED )
+            &&    ( execFlg->gen != STB_TRUE || faces[i].genStatus == STB_STATUS_FIXED )
+            )
+        {
+            settled[n].nTraID    = faces[i].nTraID    ;
+            settled[n].genConf    = faces[i].genConf    ;
+            settled[n].genVal    = faces[i].genVal    ;
+            settled[n].ageConf    = faces[i].ageConf    ;
+            settled[n].ageVal    = faces[i].ageVal    ;
+            for( h = SettledHashTrID( faces[i].nTraID , hashMask ) ; settledHash[h] >= 0 ; h = ( h + 1 ) & hashMask )
+            {
+            }
+            settledHash[h] = n;
+            n++;
+        }
+    }
+    *pnSettledCnt = n;
+    return;
+}
+/*------------------------------------------------------------------------------------------------------------------*/
 /* SetFaceToPeInfo : Create input data for stabilization of property estimation from face information */
 /*------------------------------------------------------------------------------------------------------------------*/
-VOID SetFaceToPeInfo(STB_INT32 TrackingNum,FaceObj *faces,STB_PE_DET *peInfo)
+VOID SetFaceToPeInfo(STB_INT32 TrackingNum,FaceObj *faces,const STB_INT32 *faceSettled,STB_PE_DET *peInfo)
 {
-    STB_INT32 nIdx,nIdx1;
+    STB_INT32 nIdx,nIdx1,nPe;
 
-    peInfo->num = TrackingNum;
+    /*The settled faces are not passed (faceSettled NULL : all faces are passed)*/
+    nPe = 0;
     for(nIdx=0 ; nIdx < TrackingNum;nIdx++)
     {
+        if( faceSettled != NULL && faceSettled[nIdx] >= 0 )
+        {
+            continue;
+        }
         /*tracking result*/
-        peInfo->fcDet[nIdx].nDetID        = faces[nIdx].nDetID    ;
-        peInfo->fcDet[nIdx].nTraID        = faces[nIdx].nTraID    ;
+        peInfo->fcDet[nPe].nDetID        = faces[nIdx].nDetID    ;
+        peInfo->fcDet[nPe].nTraID        = faces[nIdx].nTraID    ;
         /*Face direction estimation*/
-        peInfo->fcDet[nIdx].dirDetConf    = faces[nIdx].dirConf    ;
-        peInfo->fcDet[nIdx].dirDetYaw    = faces[nIdx].dirYaw    ;
-        peInfo->fcDet[nIdx].dirDetPitch    = faces[nIdx].dirPitch    ;
-        peInfo->fcDet[nIdx].dirDetRoll    = faces[nIdx].dirRoll    ;
+        peInfo->fcDet[nPe].dirDetConf    = faces[nIdx].dirConf    ;
+        peInfo->fcDet[nPe].dirDetYaw    = faces[nIdx].dirYaw    ;
+        peInfo->fcDet[nPe].dirDetPitch    = faces[nIdx].dirPitch    ;
+        peInfo->fcDet[nPe].dirDetRoll    = faces[nIdx].dirRoll    ;
         /*Age estimation*/
-        peInfo->fcDet[nIdx].ageDetVal   = faces[nIdx].ageVal    ;
-        peInfo->fcDet[nIdx].ageDetConf    = faces[nIdx].ageConf    ;
+        peInfo->fcDet[nPe].ageDetVal   = faces[nIdx].ageVal    ;
+        peInfo->fcDet[nPe].ageDetConf    = faces[nIdx].ageConf    ;
         /*Gaze estimation*/
-        peInfo->fcDet[nIdx].gazDetLR    = faces[nIdx].gazLR        ;
-        peInfo->fcDet[nIdx].gazDetUD    = faces[nIdx].gazUD        ;
+        peInfo->fcDet[nPe].gazDetLR    = faces[nIdx].gazLR        ;
+        peInfo->fcDet[nPe].gazDetUD    = faces[nIdx].gazUD        ;
         /*Gender estimation*/
-        peInfo->fcDet[nIdx].genDetVal    = faces[nIdx].genVal    ;
-        peInfo->fcDet[nIdx].genDetConf    = faces[nIdx].genConf    ;
+        peInfo->fcDet[nPe].genDetVal    = faces[nIdx].genVal    ;
+        peInfo->fcDet[nPe].genDetConf    = faces[nIdx].genConf    ;
         /*estimation of facial expression*/
-        peInfo->fcDet[nIdx].expDetConf    = faces[nIdx].expConf    ;
+        peInfo->fcDet[nPe].expDetConf    = faces[nIdx].expConf    ;
         for( nIdx1 = 0; nIdx1 < STB_EX_MAX; nIdx1++)
         {
-            peInfo->fcDet[nIdx].expDetVal[nIdx1]  = faces[nIdx].expScore[nIdx1];
+            peInfo->fcDet[nPe].expDetVal[nIdx1]  = faces[nIdx].expScore[nIdx1];
         }
         //blink
-        peInfo->fcDet[nIdx].bliDetL        = faces[nIdx].bliL        ;
-        peInfo->fcDet[nIdx].bliDetR        = faces[nIdx].bliR        ;
+        peInfo->fcDet[nPe].bliDetL        = faces[nIdx].bliL        ;
+        peInfo->fcDet[nPe].bliDetR        = faces[nIdx].bliR        ;
         
-
+        nPe++;
     }
+    peInfo->num = nPe;
     return;
 }
 /*------------------------------------------------------------------------------------------------------------------*/
@@ -370,58 +543,78 @@ VOID SetFaceToFrInfo(STB_INT32 TrackingNum,FaceObj *faces,STB_FR_DET *frInfo)
 /*------------------------------------------------------------------------------------------------------------------*/
 /* SetPeInfoToFace : Copy stabilization result of property estimation to face information */
 /*------------------------------------------------------------------------------------------------------------------*/
-VOID SetPeInfoToFace(STB_INT32 TrackingNum,STB_PE_RES *peInfo,FaceObj *faces, const STBExecFlg *execFlg )
+VOID SetPeInfoToFace(STB_INT32 TrackingNum,STB_PE_RES *peInfo,const STB_INT32 *faceSettled,const SettledObj *settled,FaceObj *faces, const STBExecFlg *execFlg )
 {
-    STB_INT32 i,j;
+    STB_INT32 i,k;
 
-    for( i = 0 ; i < TrackingNum; i++)
+    /*The stabilization results are in the order of its input (SetFaceToPeInfo), so faces[i] is peFace[k] with the settled faces skipped.*/
+    k = 0;
+    for( i = 0 ; i < TrackingNum ; i++)
     {
-        for( j = 0 ; j < TrackingNum; j++)
+        if( faceSettled != NULL && faceSettled[i] >= 0 )
         {
-            if(peInfo->peFace[j].nTraID == faces[i].nTraID    )
+            /*the results PE would carry forward*/
+            if( execFlg->gen == STB_TRUE )
             {
-                if( execFlg->gen == STB_TRUE )
-                {
-                    faces[i].genStatus    = peInfo->peFace[j].gen.status    ;
-                    faces[i].genVal        = peInfo->peFace[j].gen.value    ;
-                    faces[i].genConf    = peInfo->peFace[j].gen.conf    ;
-                }
-                if( execFlg->age == STB_TRUE )
-                {
-                    faces[i].ageStatus    = peInfo->peFace[j].age.status    ;
-                    faces[i].ageVal        = peInfo->peFace[j].age.value    ;
-                    faces[i].ageConf    = peInfo->peFace[j].age.conf    ;
-                }
-                if( execFlg->exp == STB_TRUE )
-                {
-                    faces[i].expStatus    = peInfo->peFace[j].exp.status    ;
-                    faces[i].expVal        = peInfo->peFace[j].exp.value    ;
-                    faces[i].expConf    = peInfo->peFace[j].exp.conf    ;
-                }
-                if( execFlg->gaz == STB_TRUE )
-                {
-                    faces[i].gazStatus    = peInfo->peFace[j].gaz.status    ;
-                    faces[i].gazConf    = peInfo->peFace[j].gaz.conf    ;
-                    faces[i].gazLR        = peInfo->peFace[j].gaz.LR        ;
-                    faces[i].gazUD        = peInfo->peFace[j].gaz.UD        ;
-                }
-                if( execFlg->dir == STB_TRUE )
-                {
-                    faces[i].dirPitch    = peInfo->peFace[j].dir.pitch    ;
-                    faces[i].dirRoll    = peInfo->peFace[j].dir.roll    ;
-                    faces[i].dirYaw        = peInfo->peFace[j].dir.yaw        ;
-                    faces[i].dirStatus    = peInfo->peFace[j].dir.status    ;
-                    faces[i].dirConf    = peInfo->peFace[j].dir.conf    ;
-                }
-                if( execFlg->bli == STB_TRUE )
-                {
-                    faces[i].bliL        = peInfo->peFace[j].bli.ratioL    ;
-                    faces[i].bliR        = peInfo->peFace[j].bli.ratioR    ;
-                    faces[i].bliStatus    = peInfo->peFace[j].bli.status    ;
-                }
-                break;
+                faces[i].genStatus    = STB_STATUS_FIXED                        ;
+                faces[i].genVal        = settled[ faceSettled[i] ].genVal    ;
+                faces[i].genConf    = settled[ faceSettled[i] ].genConf    ;
+            }
+            if( execFlg->age == STB_TRUE )
+            {
+                faces[i].ageStatus    = STB_STATUS_FIXED                        ;
+                faces[i].ageVal        = settled[ faceSettled[i] ].ageVal    ;
+                faces[i].ageConf    = settled[ faceSettled[i] ].ageConf    ;
+            }
+            continue;
+        }
+        if( k >= peInfo->peCnt )
+        {
+            break;
+        }
+        if(peInfo->peFace[k].nTraID == faces[i].nTraID    )
+        {
+            if( execFlg->gen == STB_TRUE )
+            {
+                faces[i].genStatus    = peInfo->peFace[k].gen.status    ;
+                faces[i].genVal        = peInfo->peFace[k].gen.value    ;
+                faces[i].genConf    = peInfo->peFace[k].gen.conf    ;
+            }
+            if( execFlg->age == STB_TRUE )
+            {
+                faces[i].ageStatus    = peInfo->peFace[k].age.status    ;
+                faces[i].ageVal        = peInfo->peFace[k].age.value    ;
+                faces[i].ageConf    = peInfo->peFace[k].age.conf    ;
+            }
+            if( execFlg->exp == STB_TRUE )
+            {
+                faces[i].expStatus    = peInfo->peFace[k].exp.status    ;
+                faces[i].expVal        = peInfo->peFace[k].exp.value    ;
+                faces[i].expConf    = peInfo->peFace[k].exp.conf    ;
+            }
+            if( execFlg->gaz == STB_TRUE )
+            {
+                faces[i].gazStatus    = peInfo->peFace[k].gaz.status    ;
+                faces[i].gazConf    = peInfo->peFace[k].gaz.conf    ;
+                faces[i].gazLR        = peInfo->peFace[k].gaz.LR        ;
+                faces[i].gazUD        = peInfo->peFace[k].gaz.UD        ;
+            }
+            if( execFlg->dir == STB_TRUE )
+            {
+                faces[i].dirPitch    = peInfo->peFace[k].dir.pitch    ;
+                faces[i].dirRoll    = peInfo->peFace[k].dir.roll    ;
+                faces[i].dirYaw        = peInfo->peFace[k].dir.yaw        ;
+                faces[i].dirStatus    = peInfo->peFace[k].dir.status    ;
+                faces[i].dirConf    = peInfo->peFace[k].dir.conf    ;
+            }
+            if( execFlg->bli == STB_TRUE )
+            {
+                faces[i].bliL        = peInfo->peFace[k].bli.ratioL    ;
+                faces[i].bliR        = peInfo->peFace[k].bli.ratioR    ;
+                faces[i].bliStatus    = peInfo->peFace[k].bli.status    ;
             }
         }
+        k++;
     }
 
     return;
@@ -431,19 +624,49 @@ VOID SetPeInfoToFace(STB_INT32 TrackingNum,STB_PE_RES *peInfo,FaceObj *faces, co
 /*------------------------------------------------------------------------------------------------------------------*/
 VOID SetFrInfoToFace(STB_INT32 TrackingNum,STB_FR_RES *frInfo,FaceObj *faces)
 {
-    STB_INT32 i,j;
+    STB_INT32 i;
 
+    /*The stabilization results are in the order of its input (SetFaceToFrInfo), so faces[i] is frFace[i].*/
+    for( i = 0 ; i < TrackingNum && i < frInfo->frCnt; i++)
+    {
+        if(frInfo->frFace[i].nTraID == faces[i].nTraID)
+        {
+            faces[i].frStatus    = frInfo->frFace[i].frRecog.status    ;
+            faces[i].frVal        = frInfo->frFace[i].frRecog.value    ;
+            faces[i].frConf        = frInfo->frFace[i].frRecog.conf    ;
+        }
+    }
+    return;
+}
+/*------------------------------------------------------------------------------------------------------------------*/
+/* SetFaceToEvent : Add the event of the face whose property/recognition stabilization was just done */
+/*------------------------------------------------------------------------------------------------------------------*/
+static VOID AddCompleteEvent(STB_EVENT_TYPE type,STB_INT32 nTraID,STB_INT32 value,STB_EVENT *events,STB_INT32 *pnEventCnt)
+{
+    events[*pnEventCnt].type        = type                    ;
+    events[*pnEventCnt].target        = STB_EVENT_TARGET_FACE    ;
+    events[*pnEventCnt].nTrackingID    = nTraID                ;
+    events[*pnEventCnt].value        = value                    ;
+    (*pnEventCnt)++;
+}
+VOID SetFaceToEvent(STB_INT32 TrackingNum,FaceObj *faces,const STBExecFlg *execFlg,STB_EVENT *events,STB_INT32 *pnEventCnt)
+{
+    STB_INT32 i;
+
+    /*STB_STATUS_COMPLETE lasts only the frame in which the stabilization was done*/
     for( i = 0 ; i < TrackingNum; i++)
     {
-        for( j = 0 ; j < TrackingNum; j++)
+        if( execFlg->age == STB_TRUE && faces[i].ageStatus == STB_STATUS_COMPLETE )
         {
-            if(frInfo->frFace[j].nTraID == faces[i].nTraID)
-            {
-                faces[i].frStatus    = frInfo->frFace[j].frRecog.status    ;
-                faces[i].frVal        = frInfo->frFace[j].frRecog.value    ;
-                faces[i].frConf        = frInfo->frFace[j].frRecog.conf    ;
-                break;
-            }
+            AddCompleteEvent( STB_EVENT_AGE_COMPLETE , faces[i].nTraID , faces[i].ageVal , events , pnEventCnt );
+        }
+        if( execFlg->gen == STB_TRUE && faces[i].genStatus == STB_STATUS_COMPLETE )
+        {
+            AddCompleteEvent( STB_EVENT_GENDER_COMPLETE , faces[i].nTraID , faces[i].genVal , events , pnEventCnt );
+        }
+        if( execFlg->fr == STB_TRUE && faces[i].frStatus == STB_STATUS_COMPLETE )
+        {
+            AddCompleteEvent( STB_EVENT_RECOGNITION_COMPLETE , faces[i].nTraID , faces[i].frVal , events , pnEventCnt );
         }
     }
     return;
@@ -20,7 +20,7 @@
 /*------------------------------------------------------------------------------------------------------------------*/
 /* SetFaceToResult                                                                                                    */
 /*------------------------------------------------------------------------------------------------------------------*/
-VOID SetFaceToResult ( STB_INT32 TraCnt , TraObj* trObj , FaceObj* faceObj, STB_FACE* result, const STBExecFlg* execFlg )
+VOID SetFaceToResult ( STB_INT32 TraCnt , TraObj* trObj , FaceObj* faceObj, STB_FACE* result, const STBExecFlg* execFlg , const STB_INT32* traFace )
 {
     STB_INT32 i,j;
     STB_INT32 tmpFlg;
@@ -45,58 +45,56 @@ VOID SetFaceToResult ( STB_INT32 TraCnt , TraObj* trObj , FaceObj* faceObj, STB_
 
         if(    tmpFlg    )
         {
-            for( j = 0; j < TraCnt; j++)
+            /*face information of this tracking result (SetTrackingIDToFace)*/
+            j = traFace[i];
+            if( j >= 0 && j < TraCnt && trObj[i].nTraID == faceObj[j].nTraID )
             {
-                if( trObj[i].nTraID == faceObj[j].nTraID )
+                if(    execFlg->age    == STB_TRUE )
                 {
-                    if(    execFlg->age    == STB_TRUE )
-                    {
-                        result[i].age.status            = faceObj[j].ageStatus            ;
-                        result[i].age.value                = faceObj[j].ageVal                ;
-                        result[i].age.conf                = faceObj[j].ageConf    ;
-                    }
-                    if(    execFlg->bli    == STB_TRUE )
-                    {
-                        result[i].blink.ratioL            = faceObj[j].bliL                ;
-                        result[i].blink.ratioR            = faceObj[j].bliR                ;
-                        result[i].blink.status            = faceObj[j].bliStatus            ;
-                    }
-                    if(    execFlg->dir    == STB_TRUE )
-                    {
-                        result[i].direction.pitch        = faceObj[j].dirPitch            ;
-                        result[i].direction.roll        = faceObj[j].dirRoll            ;
-                        result[i].direction.yaw            = faceObj[j].dirYaw                ;
-                        result[i].direction.status        = faceObj[j].dirStatus            ;
-                        result[i].direction.conf        = faceObj[j].dirConf    ;
-                    }
-                    if(    execFlg->exp    == STB_TRUE )
-                    {
-                        result[i].expression.status        = faceObj[j].expStatus            ;
-                        result[i].expression.value        = faceObj[j].expVal                ;
-                        result[i].expression.conf        = faceObj[j].expConf    ;
-                    }
-                    if(    execFlg->gaz    == STB_TRUE )
-                    {
-                        result[i].gaze.status            = faceObj[j].gazStatus            ;
-                        result[i].gaze.LR                = faceObj[j].gazLR                ;
-                        result[i].gaze.UD                = faceObj[j].gazUD                ;
-                        result[i].gaze.conf                = faceObj[j].gazConf    ;
-                    }
-                    if(    execFlg->gen    == STB_TRUE )
-                    {
-                        result[i].gender.status            = faceObj[j].genStatus            ;
-                        result[i].gender.value            = faceObj[j].genVal                ;
-                        result[i].gender.conf            = faceObj[j].genConf    ;
-                    }
-                    if(    execFlg->fr        == STB_TRUE )
-                    {
-                        result[i].recognition.status    = faceObj[j].frStatus            ;
-                        result[i].recognition.value        = faceObj[j].frVal                ;
-                        result[i].recognition.conf        = faceObj[j].frConf    ;
-                    }
-                    break;
-                }//if( trObj[i].nTraID == faceObj[j].nTraID )
-            }//for( j = 0; j < TraCnt; j++)
+                    result[i].age.status            = faceObj[j].ageStatus            ;
+                    result[i].age.value                = faceObj[j].ageVal                ;
+                    result[i].age.conf                = faceObj[j].ageConf    ;
+                }
+                if(    execFlg->bli    == STB_TRUE )
+                {
+                    result[i].blink.ratioL            = faceObj[j].bliL                ;
+                    result[i].blink.ratioR            = faceObj[j].bliR                ;
+                    result[i].blink.status            = faceObj[j].bliStatus            ;
+                }
+                if(    execFlg->dir    == STB_TRUE )
+                {
+                    result[i].direction.pitch        = faceObj[j].dirPitch            ;
+                    result[i].direction.roll        = faceObj[j].dirRoll            ;
+                    result[i].direction.yaw            = faceObj[j].dirYaw                ;
+                    result[i].direction.status        = faceObj[j].dirStatus            ;
+                    result[i].direction.conf        = faceObj[j].dirConf    ;
+                }
+                if(    execFlg->exp    == STB_TRUE )
+                {
+                    result[i].expression.status        = faceObj[j].expStatus            ;
+                    result[i].expression.value        = faceObj[j].expVal                ;
+                    result[i].expression.conf        = faceObj[j].expConf    ;
+                }
+                if(    execFlg->gaz    == STB_TRUE )
+                {
+                    result[i].gaze.status            = faceObj[j].gazStatus            ;
+                    result[i].gaze.LR                = faceObj[j].gazLR                ;
+                    result[i].gaze.UD                = faceObj[j].gazUD                ;
+                    result[i].gaze.conf                = faceObj[j].gazConf    ;
+                }
+                if(    execFlg->gen    == STB_TRUE )
+                {
+                    result[i].gender.status            = faceObj[j].genStatus            ;
+                    result[i].gender.value            = faceObj[j].genVal                ;
+                    result[i].gender.conf            = faceObj[j].genConf    ;
+                }
+                if(    execFlg->fr        == STB_TRUE )
+                {
+                    result[i].recognition.status    = faceObj[j].frStatus            ;
+                    result[i].recognition.value        = faceObj[j].frVal                ;
+                    result[i].recognition.conf        = faceObj[j].frConf    ;
+                }
+            }//if( trObj[i].nTraID == faceObj[j].nTraID )
         }//if(    tmpFlg    )
     }//for( i = 0; i < TraCnt; i++)
 }
@@ -15,89 +15,101 @@
 /*---------------------------------------------------------------------------*/
 
 #include "STBTracking.h"
+#include "STBValidValue.h"
 #include "STB_Debug.h"
 
 /*------------------------------------------------------------------------------------------------------------------*/
-/* SetTrackingObjectBody                                                                                            */
+/* SetTrackingObjectBody : Make the tracking input data of the human body                                           */
 /*------------------------------------------------------------------------------------------------------------------*/
-VOID SetTrackingObjectBody(const STB_FRAME_RESULT_BODYS* stbINPUTbodys,TraObj *bodys)
+VOID SetTrackingObjectBody(STB_INT32 nCount,const STB_FRAME_RESULT_DETECTION* stbINPUTbodys,STB_TR_DET *trSrcInfo)
 {
 
-    STB_INT32 nCount;
     STB_INT32 i;
 
 
     /*make the human body information*/
-    nCount = stbINPUTbodys->nCount;
-    
+    trSrcInfo->bdNum = nCount;
     for ( i = 0; i < nCount; i++)
     {
-        bodys[i].nDetID        = i;
-        bodys[i].pos.x        = stbINPUTbodys->body[i].center.nX    ;
-        bodys[i].pos.y        = stbINPUTbodys->body[i].center.nY    ;
-        bodys[i].conf        = stbINPUTbodys->body[i].nConfidence;
-        bodys[i].size        = stbINPUTbodys->body[i].nSize        ;
-        bodys[i].nTraID        = STB_STATUS_NO_DATA;
+        trSrcInfo->bdDet[i].posX    = stbINPUTbodys[i].center.nX    ;
+        trSrcInfo->bdDet[i].posY    = stbINPUTbodys[i].center.nY    ;
+        trSrcInfo->bdDet[i].conf    = stbINPUTbodys[i].nConfidence;
+        trSrcInfo->bdDet[i].size    = stbINPUTbodys[i].nSize        ;
     }
 
 }
 /*------------------------------------------------------------------------------------------------------------------*/
-/* SetTrackingObjectFace                                                                                            */
+/* SetTrackingObjectFace : Make the tracking input data of the face                                                 */
 /*------------------------------------------------------------------------------------------------------------------*/
-VOID SetTrackingObjectFace ( const STB_FRAME_RESULT_FACES *stbINPUTfaces    ,TraObj *faces    )
+VOID SetTrackingObjectFace ( STB_INT32 nCount , const STB_FRAME_RESULT_FACE *stbINPUTfaces    ,STB_TR_DET *trSrcInfo    )
 {
 
-    STB_INT32 nCount;
     STB_INT32 i;
 
 
-    /*make the human body information*/
-    nCount = stbINPUTfaces->nCount;
+    /*make the face information*/
+    trSrcInfo->fcNum = nCount;
     for ( i = 0; i < nCount; i++)
     {
-        faces[i].nDetID        = i;
-        faces[i].pos.x        = stbINPUTfaces->face[i].center.nX    ;
-        faces[i].pos.y        = stbINPUTfaces->face[i].center.nY    ;
-        faces[i].conf        = stbINPUTfaces->face[i].nConfidence;
-        faces[i].size        = stbINPUTfaces->face[i].nSize        ;
-        faces[i].nTraID        = STB_STATUS_NO_DATA;
+        trSrcInfo->fcDet[i].posX    = stbINPUTfaces[i].center.nX    ;
+        trSrcInfo->fcDet[i].posY    = stbINPUTfaces[i].center.nY    ;
+        trSrcInfo->fcDet[i].conf    = stbINPUTfaces[i].nConfidence;
+        trSrcInfo->fcDet[i].size    = stbINPUTfaces[i].nSize        ;
     }
 
 }
 /*------------------------------------------------------------------------------------------------------------------*/
-/* SetSrcTrFace                                                                                                        */
+/* SetTrackingObjectBodyLayout : Make the tracking input data of the body from caller memory (checked as read) */
 /*------------------------------------------------------------------------------------------------------------------*/
-VOID SetSrcTrFace ( STB_INT32 nDetCntFace , TraObj *trFace, STB_TR_DET *trSrcInfo)
+STB_INT32 SetTrackingObjectBodyLayout ( STB_INT32 nCount , const STB_INT8 *stbINPUTbodys , const STB_FRAME_LAYOUT_DETECTION *layout , STB_TR_DET *trSrcInfo )
 {
+
     STB_INT32 i;
+    const STB_INT8 *elem;
+    ROI_DET *det = trSrcInfo->bdDet;
+
 
-    trSrcInfo->fcNum = nDetCntFace;
-    for( i = 0; i < nDetCntFace; i++)
+    trSrcInfo->bdNum = nCount;
+    for ( i = 0 , elem = stbINPUTbodys ; i < nCount; i++ , elem += layout->nStride )
     {
-        trSrcInfo->fcDet[i].conf    = trFace[i].conf    ;
-        trSrcInfo->fcDet[i].posX    = trFace[i].pos    .x    ;
-        trSrcInfo->fcDet[i].posY    = trFace[i].pos    .y    ;
-        trSrcInfo->fcDet[i].size    = trFace[i].size    ;
+        det[i].posX        = STB_LAYOUT_VALUE( elem , layout->center.nX    , 0 );
+        det[i].posY        = STB_LAYOUT_VALUE( elem , layout->center.nY    , 0 );
+        det[i].conf        = STB_LAYOUT_VALUE( elem , layout->nConfidence    , 0 );
+        det[i].size        = STB_LAYOUT_VALUE( elem , layout->nSize        , 0 );
+        if( IS_OUT_RANGE( det[i].posX    , STB_BODY_XY_MIN    , STB_BODY_XY_MAX    )    ){ return STB_FALSE;}
+        if( IS_OUT_RANGE( det[i].posY    , STB_BODY_XY_MIN    , STB_BODY_XY_MAX    )    ){ return STB_FALSE;}
+        if( IS_OUT_RANGE( det[i].size    , STB_BODY_SIZE_MIN , STB_BODY_SIZE_MAX )    ){ return STB_FALSE;}
+        if( IS_OUT_RANGE( det[i].conf    , STB_BODY_CONF_MIN , STB_BODY_CONF_MAX )    ){ return STB_FALSE;}
     }
+
+    return STB_TRUE;
 }
 /*------------------------------------------------------------------------------------------------------------------*/
-/* SetSrcTrBody                                                                                                        */
+/* SetTrackingObjectFaceLayout : Make the tracking input data of the face from caller memory (checked as read) */
 /*------------------------------------------------------------------------------------------------------------------*/
-VOID SetSrcTrBody ( STB_INT32 nDetCntBody , TraObj *trBody, STB_TR_DET *trSrcInfo)
+STB_INT32 SetTrackingObjectFaceLayout ( STB_INT32 nCount , const STB_INT8 *stbINPUTfaces , const STB_FRAME_LAYOUT_FACE *layout , STB_TR_DET *trSrcInfo )
 {
+
     STB_INT32 i;
+    const STB_INT8 *elem;
+    ROI_DET *det = trSrcInfo->fcDet;
 
-    trSrcInfo->bdNum = nDetCntBody;
 
-    for( i = 0; i < nDetCntBody; i++)
+    trSrcInfo->fcNum = nCount;
+    for ( i = 0 , elem = stbINPUTfaces ; i < nCount; i++ , elem += layout->nStride )
     {
-        trSrcInfo->bdDet[i].conf    = trBody[i].conf    ;
-        trSrcInfo->bdDet[i].posX    = trBody[i].pos    .x    ;
-        trSrcInfo->bdDet[i].posY    = trBody[i].pos    .y    ;
-        trSrcInfo->bdDet[i].size    = trBody[i].size    ;
+        det[i].posX        = STB_LAYOUT_VALUE( elem , layout->center.nX    , 0 );
+        det[i].posY        = STB_LAYOUT_VALUE( elem , layout->center.nY    , 0 );
+        det[i].conf        = STB_LAYOUT_VALUE( elem , layout->nConfidence    , 0 );
+        det[i].size        = STB_LAYOUT_VALUE( elem , layout->nSize        , 0 );
+        if( IS_OUT_RANGE( det[i].posX    , STB_FACE_XY_MIN    , STB_FACE_XY_MAX    )    ){ return STB_FALSE;}
+        if( IS_OUT_RANGE( det[i].posY    , STB_FACE_XY_MIN    , STB_FACE_XY_MAX    )    ){ return STB_FALSE;}
+        if( IS_OUT_RANGE( det[i].size    , STB_FACE_SIZE_MIN , STB_FACE_SIZE_MAX )    ){ return STB_FALSE;}
+        if( IS_OUT_RANGE( det[i].conf    , STB_FACE_CONF_MIN , STB_FACE_CONF_MAX )    ){ return STB_FALSE;}
     }
-}
 
+    return STB_TRUE;
+}
 /*------------------------------------------------------------------------------------------------------------------*/
 /* SetTrackingInfoToFace : Reflect tracking result in structure of detection result */
 /*------------------------------------------------------------------------------------------------------------------*/
@@ -134,5 +146,23 @@ VOID SetTrackingInfoToBody(STB_TR_RES_BODYS *bdResult,STB_INT32 *pnTrackingNum,T
         bodys[nIdx].conf    = bdResult->body[nIdx].conf        ;
     }
 
+    return;
+}
+/*------------------------------------------------------------------------------------------------------------------*/
+/* SetTrEventToEvent : Copy the tracking events to the event list */
+/*------------------------------------------------------------------------------------------------------------------*/
+VOID SetTrEventToEvent(STB_TR_EVENTS *trEvents,STB_EVENT_TARGET target,STB_EVENT *events,STB_INT32 *pnEventCnt)
+{
+    STB_INT32 nIdx;
+
+    for (nIdx = 0; nIdx < trEvents->cnt; nIdx++)
+    {
+        events[*pnEventCnt].type        = (STB_EVENT_TYPE)trEvents->event[nIdx].type    ;
+        events[*pnEventCnt].target        = target                                        ;
+        events[*pnEventCnt].nTrackingID    = trEvents->event[nIdx].nTraID                    ;
+        events[*pnEventCnt].value        = -1                                            ;
+        (*pnEventCnt)++;
+    }
+
     return;
 }
\ No newline at end of file
@@ -16,16 +16,10 @@
 
 #include "STBValidValue.h"
 
-/*Value range check*/
-#define IS_OUT_RANGE( val , min , max ) ( ( (val) < (min) ) || ( (max) < (val) ) )
-#define IS_OUT_VALUE( val , min , max , accept ) ( IS_OUT_RANGE( val , min , max ) && ( (val) != (accept) )  )
-#define IS_OUT_FR_UID( val , min , max , acceptA , acceptB , acceptC  ) ( IS_OUT_RANGE( val , min , max ) && ( (val) != (acceptA) ) && ( (val) != (acceptB) ) && ( (val) != (acceptC) ) )
-#define IS_OUT_FR_SCORE( val , min , max , acceptA , acceptB ) ( IS_OUT_RANGE( val , min , max ) && ( (val) != (acceptA) ) && ( (val) != (acceptB) )  )
-
 /*------------------------------------------------------------------------------------------------------------------*/
 /* STB_IsValidValue                                                                                            */
 /*------------------------------------------------------------------------------------------------------------------*/
-STB_INT32 STB_IsValidValue(const STB_FRAME_RESULT *input, STBExecFlg *execFlg)
+STB_INT32 STB_IsValidValue(STB_INT32 nBodyCount, const STB_FRAME_RESULT_DETECTION *body, STB_INT32 nFaceCount, const STB_FRAME_RESULT_FACE *face, STB_INT32 nCntMax, STBExecFlg *execFlg)
 {
     STB_INT32 i ,j;
 
@@ -33,26 +27,26 @@ STB_INT32 STB_IsValidValue(const STB_FRAME_RESULT *input, STBExecFlg *execFlg)
 
     if( execFlg->bodyTr == STB_TRUE )
     {
-        if( IS_OUT_RANGE( input->bodys.nCount , STB_BODY_CNT_MIN , STB_BODY_CNT_MAX )    ){ return STB_FALSE;}
-        for( i = 0 ; i < input->bodys.nCount ; i++)
+        if( IS_OUT_RANGE( nBodyCount , STB_BODY_CNT_MIN , nCntMax )    ){ return STB_FALSE;}
+        for( i = 0 ; i < nBodyCount ; i++)
         {
-            if( IS_OUT_RANGE( input->bodys.body[i].center.nX    , STB_BODY_XY_MIN    , STB_BODY_XY_MAX    )    ){ return STB_FALSE;}
-            if( IS_OUT_RANGE( input->bodys.body[i].center.nY    , STB_BODY_XY_MIN    , STB_BODY_XY_MAX    )    ){ return STB_FALSE;}
-            if( IS_OUT_RANGE( input->bodys.body[i].nSize        , STB_BODY_SIZE_MIN , STB_BODY_SIZE_MAX )    ){ return STB_FALSE;}
-            if( IS_OUT_RANGE( input->bodys.body[i].nConfidence    , STB_BODY_CONF_MIN , STB_BODY_CONF_MAX )    ){ return STB_FALSE;}
+            if( IS_OUT_RANGE( body[i].center.nX    , STB_BODY_XY_MIN    , STB_BODY_XY_MAX    )    ){ return STB_FALSE;}
+            if( IS_OUT_RANGE( body[i].center.nY    , STB_BODY_XY_MIN    , STB_BODY_XY_MAX    )    ){ return STB_FALSE;}
+            if( IS_OUT_RANGE( body[i].nSize        , STB_BODY_SIZE_MIN , STB_BODY_SIZE_MAX )    ){ return STB_FALSE;}
+            if( IS_OUT_RANGE( body[i].nConfidence    , STB_BODY_CONF_MIN , STB_BODY_CONF_MAX )    ){ return STB_FALSE;}
         }
         
     }
 
     if( execFlg->faceTr == STB_TRUE )
     {
-        if( IS_OUT_RANGE( input->faces.nCount , STB_FACE_CNT_MIN , STB_FACE_CNT_MAX )    ){ return STB_FALSE;}
-        for( i = 0 ; i < input->faces.nCount ; i++)
+        if( IS_OUT_RANGE( nFaceCount , STB_FACE_CNT_MIN , nCntMax )    ){ return STB_FALSE;}
+        for( i = 0 ; i < nFaceCount ; i++)
         {
-            if( IS_OUT_RANGE( input->faces.face[i].center.nX    , STB_FACE_XY_MIN    , STB_FACE_XY_MAX    )    ){ return STB_FALSE;}
-            if( IS_OUT_RANGE( input->faces.face[i].center.nY    , STB_FACE_XY_MIN    , STB_FACE_XY_MAX    )    ){ return STB_FALSE;}
-            if( IS_OUT_RANGE( input->faces.face[i].nSize        , STB_FACE_SIZE_MIN , STB_FACE_SIZE_MAX )    ){ return STB_FALSE;}
-            if( IS_OUT_RANGE( input->faces.face[i].nConfidence    , STB_FACE_CONF_MIN , STB_FACE_CONF_MAX )    ){ return STB_FALSE;}
+            if( IS_OUT_RANGE( face[i].center.nX    , STB_FACE_XY_MIN    , STB_FACE_XY_MAX    )    ){ return STB_FALSE;}
+            if( IS_OUT_RANGE( face[i].center.nY    , STB_FACE_XY_MIN    , STB_FACE_XY_MAX    )    ){ return STB_FALSE;}
+            if( IS_OUT_RANGE( face[i].nSize        , STB_FACE_SIZE_MIN , STB_FACE_SIZE_MAX )    ){ return STB_FALSE;}
+            if( IS_OUT_RANGE( face[i].nConfidence    , STB_FACE_CONF_MIN , STB_FACE_CONF_MAX )    ){ return STB_FALSE;}
         }
     }
 
@@ -65,60 +59,60 @@ STB_INT32 STB_IsValidValue(const STB_FRAME_RESULT *input, STBExecFlg *execFlg)
         ||    execFlg->bli    == STB_TRUE 
         )
     {
-        for( i = 0 ; i < input->faces.nCount ; i++)
+        for( i = 0 ; i < nFaceCount ; i++)
         {
-            if( IS_OUT_RANGE( input->faces.face[i].direction.nLR            , STB_FACE_DIR_LR_MIN    , STB_FACE_DIR_LR_MAX    )    ){ return STB_FALSE;}
-            if( IS_OUT_RANGE( input->faces.face[i].direction.nUD            , STB_FACE_DIR_UD_MIN    , STB_FACE_DIR_UD_MAX    )    ){ return STB_FALSE;}
-            if( IS_OUT_RANGE( input->faces.face[i].direction.nRoll            , STB_FACE_DIR_ROLL_MIN    , STB_FACE_DIR_ROLL_MAX )    ){ return STB_FALSE;}
-            if( IS_OUT_RANGE( input->faces.face[i].direction.nConfidence    , STB_FACE_DIR_CONF_MIN    , STB_FACE_DIR_CONF_MAX )    ){ return STB_FALSE;}
+            if( IS_OUT_RANGE( face[i].direction.nLR            , STB_FACE_DIR_LR_MIN    , STB_FACE_DIR_LR_MAX    )    ){ return STB_FALSE;}
+            if( IS_OUT_RANGE( face[i].direction.nUD            , STB_FACE_DIR_UD_MIN    , STB_FACE_DIR_UD_MAX    )    ){ return STB_FALSE;}
+            if( IS_OUT_RANGE( face[i].direction.nRoll            , STB_FACE_DIR_ROLL_MIN    , STB_FACE_DIR_ROLL_MAX )    ){ return STB_FALSE;}
+            if( IS_OUT_RANGE( face[i].direction.nConfidence    , STB_FACE_DIR_CONF_MIN    , STB_FACE_DIR_CONF_MAX )    ){ return STB_FALSE;}
         }
     }
 
 
     if(    execFlg->age    == STB_TRUE )
     {
-        for( i = 0 ; i < input->faces.nCount ; i++)
+        for( i = 0 ; i < nFaceCount ; i++)
         {
-            if( IS_OUT_VALUE( input->faces.face[i].age.nAge            , STB_FACE_AGE_VAL_MIN    , STB_FACE_AGE_VAL_MAX    ,STB_ERR_PE_CANNOT )    ){ return STB_FALSE;}
-            if( IS_OUT_VALUE( input->faces.face[i].age.nConfidence    , STB_FACE_AGE_CONF_MIN    , STB_FACE_AGE_CONF_MAX    ,STB_ERR_PE_CANNOT )    ){ return STB_FALSE;}
+            if( IS_OUT_VALUE( face[i].age.nAge            , STB_FACE_AGE_VAL_MIN    , STB_FACE_AGE_VAL_MAX    ,STB_ERR_PE_CANNOT )    ){ return STB_FALSE;}
+            if( IS_OUT_VALUE( face[i].age.nConfidence    , STB_FACE_AGE_CONF_MIN    , STB_FACE_AGE_CONF_MAX    ,STB_ERR_PE_CANNOT )    ){ return STB_FALSE;}
         }
     }
 
     if(    execFlg->gen    == STB_TRUE )
     {
-        for( i = 0 ; i < input->faces.nCount ; i++)
+        for( i = 0 ; i < nFaceCount ; i++)
         {
-            if( IS_OUT_VALUE( input->faces.face[i].gender.nGender        , STB_FACE_GEN_VAL_MIN    , STB_FACE_GEN_VAL_MAX    ,STB_ERR_PE_CANNOT )    ){ return STB_FALSE;}
-            if( IS_OUT_VALUE( input->faces.face[i].gender.nConfidence    , STB_FACE_GEN_CONF_MIN    , STB_FACE_GEN_CONF_MAX    ,STB_ERR_PE_CANNOT )    ){ return STB_FALSE;}
+            if( IS_OUT_VALUE( face[i].gender.nGender        , STB_FACE_GEN_VAL_MIN    , STB_FACE_GEN_VAL_MAX    ,STB_ERR_PE_CANNOT )    ){ return STB_FALSE;}
+            if( IS_OUT_VALUE( face[i].gender.nConfidence    , STB_FACE_GEN_CONF_MIN    , STB_FACE_GEN_CONF_MAX    ,STB_ERR_PE_CANNOT )    ){ return STB_FALSE;}
         }
     }
 
     if(    execFlg->gaz    == STB_TRUE )
     {
-        for( i = 0 ; i < input->faces.nCount ; i++)
+        for( i = 0 ; i < nFaceCount ; i++)
         {
-            if( IS_OUT_VALUE( input->faces.face[i].gaze.nLR    , STB_FACE_GAZE_LR_MIN    , STB_FACE_GAZE_LR_MAX    ,STB_ERR_PE_CANNOT )    ){ return STB_FALSE;}
-            if( IS_OUT_VALUE( input->faces.face[i].gaze.nUD    , STB_FACE_GAZE_UD_MIN    , STB_FACE_GAZE_UD_MAX    ,STB_ERR_PE_CANNOT )    ){ return STB_FALSE;}
+            if( IS_OUT_VALUE( face[i].gaze.nLR    , STB_FACE_GAZE_LR_MIN    , STB_FACE_GAZE_LR_MAX    ,STB_ERR_PE_CANNOT )    ){ return STB_FALSE;}
+            if( IS_OUT_VALUE( face[i].gaze.nUD    , STB_FACE_GAZE_UD_MIN    , STB_FACE_GAZE_UD_MAX    ,STB_ERR_PE_CANNOT )    ){ return STB_FALSE;}
         }
     }
 
     if(    execFlg->bli    == STB_TRUE )
     {
-        for( i = 0 ; i < input->faces.nCount ; i++)
+        for( i = 0 ; i < nFaceCount ; i++)
         {
-            if( IS_OUT_VALUE( input->faces.face[i].blink.nLeftEye    , STB_FACE_BLI_L_MIN    , STB_FACE_BLI_L_MAX    ,STB_ERR_PE_CANNOT)    ){ return STB_FALSE;}
-            if( IS_OUT_VALUE( input->faces.face[i].blink.nRightEye    , STB_FACE_BLI_R_MIN    , STB_FACE_BLI_R_MAX    ,STB_ERR_PE_CANNOT)    ){ return STB_FALSE;}
+            if( IS_OUT_VALUE( face[i].blink.nLeftEye    , STB_FACE_BLI_L_MIN    , STB_FACE_BLI_L_MAX    ,STB_ERR_PE_CANNOT)    ){ return STB_FALSE;}
+            if( IS_OUT_VALUE( face[i].blink.nRightEye    , STB_FACE_BLI_R_MIN    , STB_FACE_BLI_R_MAX    ,STB_ERR_PE_CANNOT)    ){ return STB_FALSE;}
         }
     }
 
     if(    execFlg->exp    == STB_TRUE )
     {
-        for( i = 0 ; i < input->faces.nCount ; i++)
+        for( i = 0 ; i < nFaceCount ; i++)
         {
-            if( IS_OUT_VALUE( input->faces.face[i].expression.nDegree    , STB_FACE_EXP_DEG_MIN    , STB_FACE_EXP_DEG_MAX    ,STB_ERR_PE_CANNOT)    ){ return STB_FALSE;}
+            if( IS_OUT_VALUE( face[i].expression.nDegree    , STB_FACE_EXP_DEG_MIN    , STB_FACE_EXP_DEG_MAX    ,STB_ERR_PE_CANNOT)    ){ return STB_FALSE;}
             for( j = 0 ; j < STB_EX_MAX ; j++)
             {
-                if( IS_OUT_VALUE( input->faces.face[i].expression.anScore[j]    ,STB_FACE_EXP_SCORE_MIN    , STB_FACE_EXP_SCORE_MAX    ,STB_ERR_PE_CANNOT)    ){ return STB_FALSE;}
+                if( IS_OUT_VALUE( face[i].expression.anScore[j]    ,STB_FACE_EXP_SCORE_MIN    , STB_FACE_EXP_SCORE_MAX    ,STB_ERR_PE_CANNOT)    ){ return STB_FALSE;}
             }
             
         }
@@ -126,13 +120,107 @@ STB_INT32 STB_IsValidValue(const STB_FRAME_RESULT *input, STBExecFlg *execFlg)
 
     if(    execFlg->fr    == STB_TRUE )
     {
-        for( i = 0 ; i < input->faces.nCount ; i++)
+        for( i = 0 ; i < nFaceCount ; i++)
+        {
+            if( IS_OUT_FR_UID( face[i].recognition.nUID    , STB_FACE_FR_UID_MIN    , STB_FACE_FR_UID_MAX    ,STB_ERR_FR_CANNOT ,STB_ERR_FR_NOID ,STB_ERR_FR_NOALBUM ) ){ return STB_FALSE;}
+            if( IS_OUT_FR_SCORE( face[i].recognition.nScore    , STB_FACE_FR_SCORE_MIN    , STB_FACE_FR_SCORE_MAX    ,STB_ERR_FR_CANNOT ,STB_ERR_FR_NOALBUM)    ){ return STB_FALSE;}
+        }
+    }
+
+
+    return STB_TRUE;
+}
+/*------------------------------------------------------------------------------------------------------------------*/
+/* STB_IsValidLayout : Check the counts and the layout given to SetFrameResultLayout (the values are checked as read) */
+/*------------------------------------------------------------------------------------------------------------------*/
+#define IS_OUT_STRIDE( stride )             ( (stride) <= 0 || (stride) % (STB_INT32)sizeof(STB_INT32) != 0 )
+#define IS_OUT_OFFSET( offset , stride )    ( (offset) < 0 || (offset) % (STB_INT32)sizeof(STB_INT32) != 0 || (offset) > (stride) - (STB_INT32)sizeof(STB_INT32) )
+#define IS_OUT_OPTION( offset , stride )    ( (offset) != STB_LAYOUT_NONE && IS_OUT_OFFSET( offset , stride ) )
+STB_INT32 STB_IsValidLayout(STB_INT32 nBodyCount, const STB_FRAME_LAYOUT_DETECTION *bodyLayout, STB_INT32 nFaceCount, const STB_FRAME_LAYOUT_FACE *faceLayout, STB_INT32 nCntMax, STBExecFlg *execFlg)
+{
+    STB_INT32 j;
+
+
+
+    if( execFlg->bodyTr == STB_TRUE )
+    {
+        if( IS_OUT_RANGE( nBodyCount , STB_BODY_CNT_MIN , nCntMax )    ){ return STB_FALSE;}
+        if( nBodyCount > 0 )
+        {
+            if( IS_OUT_STRIDE( bodyLayout->nStride )    ){ return STB_FALSE;}
+            if( IS_OUT_OFFSET( bodyLayout->center.nX , bodyLayout->nStride )    ){ return STB_FALSE;}
+            if( IS_OUT_OFFSET( bodyLayout->center.nY , bodyLayout->nStride )    ){ return STB_FALSE;}
+            if( IS_OUT_OFFSET( bodyLayout->nSize , bodyLayout->nStride )    ){ return STB_FALSE;}
+            if( IS_OUT_OFFSET( bodyLayout->nConfidence , bodyLayout->nStride )    ){ return STB_FALSE;}
+        }
+    }
+
+    if( execFlg->faceTr == STB_TRUE )
+    {
+        if( IS_OUT_RANGE( nFaceCount , STB_FACE_CNT_MIN , nCntMax )    ){ return STB_FALSE;}
+        if( nFaceCount > 0 )
         {
-            if( IS_OUT_FR_UID( input->faces.face[i].recognition.nUID    , STB_FACE_FR_UID_MIN    , STB_FACE_FR_UID_MAX    ,STB_ERR_FR_CANNOT ,STB_ERR_FR_NOID ,STB_ERR_FR_NOALBUM ) ){ return STB_FALSE;}
-            if( IS_OUT_FR_SCORE( input->faces.face[i].recognition.nScore    , STB_FACE_FR_SCORE_MIN    , STB_FACE_FR_SCORE_MAX    ,STB_ERR_FR_CANNOT ,STB_ERR_FR_NOALBUM)    ){ return STB_FALSE;}
+            if( IS_OUT_STRIDE( faceLayout->nStride )    ){ return STB_FALSE;}
+            if( IS_OUT_OFFSET( faceLayout->center.nX , faceLayout->nStride )    ){ return STB_FALSE;}
+            if( IS_OUT_OFFSET( faceLayout->center.nY , faceLayout->nStride )    ){ return STB_FALSE;}
+            if( IS_OUT_OFFSET( faceLayout->nSize , faceLayout->nStride )    ){ return STB_FALSE;}
+            if( IS_OUT_OFFSET( faceLayout->nConfidence , faceLayout->nStride )    ){ return STB_FALSE;}
         }
     }
 
+    if( nFaceCount <= 0 )
+    {
+        return STB_TRUE;
+    }
+
+    if(        execFlg->gen    == STB_TRUE     
+        ||    execFlg->age    == STB_TRUE 
+        ||    execFlg->fr        == STB_TRUE 
+        ||    execFlg->exp    == STB_TRUE     
+        ||    execFlg->dir    == STB_TRUE     
+        ||    execFlg->gaz    == STB_TRUE 
+        ||    execFlg->bli    == STB_TRUE 
+        )
+    {
+        if( IS_OUT_OPTION( faceLayout->direction.nLR , faceLayout->nStride )    ){ return STB_FALSE;}
+        if( IS_OUT_OPTION( faceLayout->direction.nUD , faceLayout->nStride )    ){ return STB_FALSE;}
+        if( IS_OUT_OPTION( faceLayout->direction.nRoll , faceLayout->nStride )    ){ return STB_FALSE;}
+        if( IS_OUT_OPTION( faceLayout->direction.nConfidence , faceLayout->nStride )    ){ return STB_FALSE;}
+    }
+    if(    execFlg->age    == STB_TRUE )
+    {
+        if( IS_OUT_OPTION( faceLayout->age.nAge , faceLayout->nStride )    ){ return STB_FALSE;}
+        if( IS_OUT_OPTION( faceLayout->age.nConfidence , faceLayout->nStride )    ){ return STB_FALSE;}
+    }
+    if(    execFlg->gen    == STB_TRUE )
+    {
+        if( IS_OUT_OPTION( faceLayout->gender.nGender , faceLayout->nStride )    ){ return STB_FALSE;}
+        if( IS_OUT_OPTION( faceLayout->gender.nConfidence , faceLayout->nStride )    ){ return STB_FALSE;}
+    }
+    if(    execFlg->gaz    == STB_TRUE )
+    {
+        if( IS_OUT_OPTION( faceLayout->gaze.nLR , faceLayout->nStride )    ){ return STB_FALSE;}
+        if( IS_OUT_OPTION( faceLayout->gaze.nUD , faceLayout->nStride )    ){ return STB_FALSE;}
+    }
+    if(    execFlg->bli    == STB_TRUE )
+    {
+        if( IS_OUT_OPTION( faceLayout->blink.nLeftEye , faceLayout->nStride )    ){ return STB_FALSE;}
+        if( IS_OUT_OPTION( faceLayout->blink.nRightEye , faceLayout->nStride )    ){ return STB_FALSE;}
+    }
+    if(    execFlg->exp    == STB_TRUE )
+    {
+        if( IS_OUT_OPTION( faceLayout->expression.nDegree , faceLayout->nStride )    ){ return STB_FALSE;}
+        for( j = 0 ; j < STB_EX_MAX ; j++)
+        {
+            if( IS_OUT_OPTION( faceLayout->expression.anScore[j] , faceLayout->nStride )    ){ return STB_FALSE;}
+        }
+    }
+    if(    execFlg->fr    == STB_TRUE )
+    {
+        if( IS_OUT_OPTION( faceLayout->recognition.nUID , faceLayout->nStride )    ){ return STB_FALSE;}
+        if( IS_OUT_OPTION( faceLayout->recognition.nScore , faceLayout->nStride )    ){ return STB_FALSE;}
+    }
+
 
     return STB_TRUE;
 }
\ No newline at end of file
@@ -25,7 +25,6 @@
 /*Threshold for checking input value*/
 /*-------------------------------------------------------------------*/
 #define     STB_BODY_CNT_MIN        0    // body
-#define     STB_BODY_CNT_MAX        35
 #define     STB_BODY_XY_MIN            0
 #define     STB_BODY_XY_MAX            8191
 #define     STB_BODY_SIZE_MIN        20
@@ -33,7 +32,6 @@
 #define     STB_BODY_CONF_MIN        0
 #define     STB_BODY_CONF_MAX        1000
 #define     STB_FACE_CNT_MIN        0    // face
-#define     STB_FACE_CNT_MAX        35
 #define     STB_FACE_XY_MIN            0
 #define     STB_FACE_XY_MAX            8191
 #define     STB_FACE_SIZE_MIN        20
@@ -84,11 +82,19 @@
 /*For collaboration with child library*/
 /*-------------------------------------------------------------------*/
 #define     STB_ERR_DIR_CANNOT        -256 /*Unable to angle estimation*/
+/*-------------------------------------------------------------------*/
+/*Value range check*/
+/*-------------------------------------------------------------------*/
+#define IS_OUT_RANGE( val , min , max ) ( ( (val) < (min) ) || ( (max) < (val) ) )
+#define IS_OUT_VALUE( val , min , max , accept ) ( IS_OUT_RANGE( val , min , max ) && ( (val) != (accept) )  )
+#define IS_OUT_FR_UID( val , min , max , acceptA , acceptB , acceptC  ) ( IS_OUT_RANGE( val , min , max ) && ( (val) != (acceptA) ) && ( (val) != (acceptB) ) && ( (val) != (acceptC) ) )
+#define IS_OUT_FR_SCORE( val , min , max , acceptA , acceptB ) ( IS_OUT_RANGE( val , min , max ) && ( (val) != (acceptA) ) && ( (val) != (acceptB) )  )
 
 /*-------------------------------------------------------------------*/
 /*  Func                                                             */
 /*-------------------------------------------------------------------*/
-STB_INT32 STB_IsValidValue(const STB_FRAME_RESULT *input, STBExecFlg *execFlg);
+STB_INT32 STB_IsValidValue(STB_INT32 nBodyCount, const STB_FRAME_RESULT_DETECTION *body, STB_INT32 nFaceCount, const STB_FRAME_RESULT_FACE *face, STB_INT32 nCntMax, STBExecFlg *execFlg);
+STB_INT32 STB_IsValidLayout(STB_INT32 nBodyCount, const STB_FRAME_LAYOUT_DETECTION *bodyLayout, STB_INT32 nFaceCount, const STB_FRAME_LAYOUT_FACE *faceLayout, STB_INT32 nCntMax, STBExecFlg *execFlg);
 
 #endif  /* COMMONDEF_H__ */
 
@@ -47,23 +47,37 @@ static STB_INT32 FrIsValidPointer( const VOID* pPointer )
     return nRet;
 }
 
+/*------------------------------------------------------------------------------------------------------------------*/
+/*    CalcFrHashSize                                                                                                    */
+/*------------------------------------------------------------------------------------------------------------------*/
+STB_UINT32 CalcFrHashSize ( STB_UINT32 nCnt )
+{
+    //power of 2, at least twice the number of the keys so that the probe sequences stay short
+    STB_UINT32 retVal ;
+
+    retVal = 1 ;
+    while( retVal < nCnt * 2 )
+    {
+        retVal *= 2 ;
+    }
+    return retVal;
+}
 /*------------------------------------------------------------------------------------------------------------------*/
 /*    CalcFrSize                                                                                                        */
 /*------------------------------------------------------------------------------------------------------------------*/
-STB_UINT32 CalcFrSize ( STB_UINT32 nTraCntMax )
+STB_UINT32 CalcFrSize ( STB_UINT32 nTraCntMax , STB_UINT32 nBackMax )
 {
     STB_UINT32 retVal ;
 
     retVal = 0 ;
 
-    retVal += 100 ;///Margin  : alignment
-
-
-
-    retVal    +=    sizeof( FR_DET        ) * nTraCntMax                ;    // frDet.fcDet
-    retVal    +=    sizeof( STB_FR_DET    ) * STB_FR_BACK_MAX            ;    // frDetRec
-    retVal    +=    sizeof( FR_DET        ) * nTraCntMax * nTraCntMax    ;    // frDetRec[t].fcDet
-    retVal    +=    sizeof( FR_RES        ) * nTraCntMax                ;    // frRes.frFace
+    retVal    +=    STB_MEM_AREA( sizeof( FR_DET        ) * nTraCntMax )            ;    // frDet.fcDet
+    retVal    +=    STB_MEM_AREA( sizeof( STB_FR_DET    ) * nBackMax )            ;    // frDetRec
+    retVal    +=    STB_MEM_AREA( sizeof( FR_DET        ) * nTraCntMax ) * nBackMax    ;    // frDetRec[t].fcDet
+    retVal    +=    STB_MEM_AREA( sizeof( FR_RES        ) * nTraCntMax )            ;    // frRes.frFace
+    retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * nBackMax ) * 3        ;    // frWork.recUID/recConf/accSlot
+    retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * CalcFrHashSize( nBackMax ) ) * 3;    // frWork.accUID/accCnt/accFirst
+    retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * CalcFrHashSize( nTraCntMax ) );    // frWork.traIdx
 
     return retVal;
 }
@@ -76,41 +90,90 @@ void ShareFrSize ( FRHANDLE    handle )
     STB_UINT32    t;
     STB_INT8    *stbPtr        = handle->frPtr        ;
     STB_UINT32    nTraCntMax    = handle->frCntMax    ;
+    STB_UINT32    nBackMax    = handle->frBackMax    ;
+    STB_UINT32    nVoteSize    = handle->frWork.hashMask + 1;
+    STB_UINT32    nTraSize    = handle->frWork.traHashMask + 1;
 
-    handle->frDet.fcDet        =    ( FR_DET*        ) stbPtr;        stbPtr    += ( sizeof( FR_DET        ) * nTraCntMax    );
-    handle->frDetRec        =    ( STB_FR_DET*    ) stbPtr;        stbPtr    += ( sizeof( STB_FR_DET    ) * STB_FR_BACK_MAX);
-    for( t = 0 ; t < STB_FR_BACK_MAX ; t++ )
+    handle->frDet.fcDet        =    ( FR_DET*        ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( FR_DET        ) * nTraCntMax    );
+    handle->frDetRec        =    ( STB_FR_DET*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_FR_DET    ) * nBackMax    );
+    for( t = 0 ; t < nBackMax ; t++ )
     {
-        handle->frDetRec[t].fcDet = ( FR_DET*    ) stbPtr;        stbPtr    += ( sizeof( FR_DET        ) * nTraCntMax    );
+        handle->frDetRec[t].fcDet = ( FR_DET*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( FR_DET        ) * nTraCntMax    );
     }
-    handle->frRes.frFace    =    ( FR_RES    *    ) stbPtr;        stbPtr    += ( sizeof( FR_RES        ) * nTraCntMax    );
+    handle->frRes.frFace    =    ( FR_RES    *    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( FR_RES        ) * nTraCntMax    );
+    handle->frWork.recUID    =    ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nBackMax    );
+    handle->frWork.recConf    =    ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nBackMax    );
+    handle->frWork.accSlot    =    ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nBackMax    );
+    handle->frWork.accUID    =    ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nVoteSize    );
+    handle->frWork.accCnt    =    ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nVoteSize    );
+    handle->frWork.accFirst    =    ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nVoteSize    );
+    handle->frWork.traIdx    =    ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraSize    );
 
 }
+/*------------------------------------------------------------------------------------------------------------------*/
+/*    FrClearRec                                                                                                        */
+/*------------------------------------------------------------------------------------------------------------------*/
+void FrClearRec ( FRHANDLE    handle )
+{
+    //The past data is referred only within "num", so only the counts are reset.
+    STB_INT32    t;
+
+    for( t = 0 ; t < handle->frBackMax ; t++ )
+    {
+        handle->frDetRec[t].num = 0;
+    }
+    for( t = 0 ; t <= handle->frWork.traHashMask ; t++ )
+    {
+        handle->frWork.traIdx[t] = -1;
+    }
+    handle->frRecTop   = 0;
+    handle->frRecEpoch = handle->frClearEpoch;
+}
 /*---------------------------------------------------------------------
 ---------------------------------------------------------------------*/
-/*Create handle*/
-FRHANDLE FrCreateHandle(  const STB_INT32 nTraCntMax    )
+/*Get the memory size necessary for the handle (0 : invalid parameter)*/
+STB_UINT32 FrGetRequiredMemorySize(  const STB_INT32 nTraCntMax , const STB_INT32 nBackMax )
+{
+    FRHANDLE    handle    = NULL;
+
+    if( nTraCntMax < 1 || STB_FR_TRA_CNT_MAX < nTraCntMax )
+    {
+        return 0;
+    }
+    if( nBackMax < STB_FR_BACK_MIN || STB_FR_BACK_MAX < nBackMax )
+    {
+        return 0;
+    }
+
+    /*the handle is placed at the cache line boundary, and the areas follow it*/
+    return STB_MEM_ALIGN_TOP - 1 + STB_MEM_AREA( sizeof( *handle ) ) + CalcFrSize (    nTraCntMax , nBackMax    );
+}
+/*---------------------------------------------------------------------
+---------------------------------------------------------------------*/
+/*Create handle in the memory given by the caller*/
+FRHANDLE FrCreateHandleInPlace( STB_INT8 *pMem , const STB_UINT32 nMemSize , const STB_INT32 nTraCntMax , const STB_INT32 nBackMax )
 
 {
 
     FRHANDLE    handle;
     STB_INT32    t , i ;
-    STB_INT32    tmpVal;
-
-
+    STB_UINT32    tmpVal;
+    STB_INT32    nRet;
 
-    if( nTraCntMax < 1 || STB_FR_TRA_CNT_MAX < nTraCntMax )
+    nRet = FrIsValidPointer(pMem);
+    if(nRet != STB_NORMAL)
     {
         return NULL;
     }
 
-    /*do handle's Malloc here*/
-    handle = (FRHANDLE)malloc(sizeof(*handle));
-    if(handle == NULL)
+    tmpVal = FrGetRequiredMemorySize( nTraCntMax , nBackMax );
+    if( tmpVal == 0 || nMemSize < tmpVal )
     {
         return NULL;
     }
 
+    handle = ( FRHANDLE )STB_MEM_TOP( pMem );
+
 
     /*initial value---------------------------------------------------------------------*/
     handle->frFaceDirUDMax     = STB_FR_DIR_MAX_UD_INI        ;
@@ -118,33 +181,39 @@ FRHANDLE FrCreateHandle(  const STB_INT32 nTraCntMax    )
     handle->frFaceDirLRMax     = STB_FR_DIR_MAX_LR_INI        ;
     handle->frFaceDirLRMin    = STB_FR_DIR_MIN_LR_INI        ;
     handle->frCntMax        = nTraCntMax                ;//Maximum number of tracking people
+    handle->frBackMax        = nBackMax                    ;//a number of past frames kept
     handle->frFaceDirThr    = STB_FR_DIR_THR_INI            ;//If the confidence of Face direction estimation doesn't exceed the reference value, the recognition result isn't trusted.
-    handle->frFrameCount    = STB_FR_FRAME_CNT_INI            ;
+    handle->frFrameCount    = ( STB_FR_FRAME_CNT_INI < nBackMax ) ? STB_FR_FRAME_CNT_INI : nBackMax;
     handle->frFrameRatio    = STB_FR_FRAME_RATIO_INI        ;
     handle->frPtr            = NULL;
+    handle->frClearEpoch    = 0;
+    handle->frRecEpoch        = 0;
     handle->frDet.num        = 0;
     handle->frDet.fcDet        = NULL;
     handle->frDetRec        = NULL;
+    handle->frRecTop        = 0;
     handle->frRes.frCnt        = 0;
     handle->frRes.frFace    = NULL;
-
-    tmpVal            = CalcFrSize (    nTraCntMax        );    /*calculate necessary amount in the Fr handle*/
-    handle->frPtr    = NULL;
-    handle->frPtr    = ( STB_INT8 * )malloc( tmpVal    );    /*keeping necessary amount in the Fr handle*/
-    if( handle->frPtr == NULL )
-    {
-        free ( handle->frPtr    );
-        free ( handle            );
-        return NULL;
-    }
-
-    /* Malloc-area is allocated to things that need Malloc in FR handle */
+    handle->frWork.recUID    = NULL;
+    handle->frWork.recConf    = NULL;
+    handle->frWork.accUID    = NULL;
+    handle->frWork.accCnt    = NULL;
+    handle->frWork.accFirst    = NULL;
+    handle->frWork.accSlot    = NULL;
+    handle->frWork.hashMask    = (STB_INT32)CalcFrHashSize( nBackMax ) - 1;
+    handle->frWork.traIdx    = NULL;
+    handle->frWork.traHashMask    = (STB_INT32)CalcFrHashSize( nTraCntMax ) - 1;
+    handle->frMem            = NULL;
+
+    handle->frPtr    = ( STB_INT8 * )handle + STB_MEM_AREA( sizeof( *handle ) );    /*the areas of the Fr handle follow the handle*/
+
+    /* the areas are allocated to things that need them in FR handle */
     ShareFrSize ( handle     );
 
 
 
 
-    for( t = 0 ; t < STB_FR_BACK_MAX  ;  t++ ) 
+    for( t = 0 ; t < handle->frBackMax  ;  t++ ) 
     {
         handle->frDetRec [ t ].num = 0;
         for( i = 0 ; i < handle->frCntMax ;  i++ ) 
@@ -161,6 +230,50 @@ FRHANDLE FrCreateHandle(  const STB_INT32 nTraCntMax    )
 
         }
     }
+    //The vote table is kept empty between the stabilization of each tracking person.
+    for( i = 0 ; i <= handle->frWork.hashMask ;  i++ ) 
+    {
+        handle->frWork.accUID    [ i ] = STB_FR_INVALID_UID;
+        handle->frWork.accCnt    [ i ] = 0;
+        handle->frWork.accFirst    [ i ] = 0;
+    }
+    //No tracking ID of the previous frame.
+    for( i = 0 ; i <= handle->frWork.traHashMask ;  i++ ) 
+    {
+        handle->frWork.traIdx    [ i ] = -1;
+    }
+
+    return handle;
+}
+/*---------------------------------------------------------------------
+---------------------------------------------------------------------*/
+/*Create handle*/
+FRHANDLE FrCreateHandle(  const STB_INT32 nTraCntMax , const STB_INT32 nBackMax )
+{
+    FRHANDLE    handle;
+    STB_UINT32    tmpVal;
+    STB_INT8    *pMem;
+
+    tmpVal = FrGetRequiredMemorySize( nTraCntMax , nBackMax );    /*calculate necessary amount in the Fr handle*/
+    if( tmpVal == 0 )
+    {
+        return NULL;
+    }
+
+    /*do Malloc of the handle and its areas at once here*/
+    pMem = ( STB_INT8 * )malloc( tmpVal );
+    if( pMem == NULL )
+    {
+        return NULL;
+    }
+
+    handle = FrCreateHandleInPlace( pMem , tmpVal , nTraCntMax , nBackMax );
+    if( handle == NULL )
+    {
+        free ( pMem );
+        return NULL;
+    }
+    handle->frMem = pMem;
 
     return handle;
 }
@@ -173,12 +286,14 @@ STB_INT32 FrDeleteHandle(FRHANDLE handle){
 
     /*NULL check*/
     nRet = FrIsValidPointer(handle);
-    if(nRet != STB_ERR_NOHANDLE){
-        return nRet;
+    if(nRet != STB_NORMAL){
+        return STB_ERR_NOHANDLE;
     }
 
-    free ( handle->frPtr    );
-    free ( handle            );
+    if( handle->frMem != NULL )/*NULL : created in the memory given by the caller*/
+    {
+        free ( handle->frMem );
+    }
 
     return STB_NORMAL;
 }
@@ -247,6 +362,12 @@ STB_INT32 FrExecute(FRHANDLE handle){
         return STB_ERR_NOHANDLE;
     }
 
+    /*The past data before the clear processing is not referred*/
+    if( handle->frRecEpoch != handle->frClearEpoch )
+    {
+        FrClearRec ( handle );
+    }
+
     /*Main processing here*/
     nRet = StbFrExec ( handle );
 
@@ -366,8 +487,6 @@ STB_INT32 FrGetFaceDirMinMax(FRHANDLE handle , STB_INT32 *pnMinUDAngle    , STB_
 STB_INT32    FrClear            ( FRHANDLE handle  )
 {
     //clear processing
-
-    STB_INT32 t , i ;
     STB_INT32 nRet;
 
     /*NULL check*/
@@ -376,26 +495,10 @@ STB_INT32    FrClear            ( FRHANDLE handle  )
         return STB_ERR_NOHANDLE;
     }
 
-    for( t = 0 ; t < STB_FR_BACK_MAX  ;  t++ ) 
-    {
-        handle->frDetRec [ t ].num = 0;
-        for( i = 0 ; i < handle->frCntMax ;  i++ ) 
-        {
-            handle->frDetRec [ t ].fcDet[i].nDetID        = STB_STATUS_NO_DATA ;
-            handle->frDetRec [ t ].fcDet[i].nTraID        = STB_STATUS_NO_DATA ;
-            handle->frDetRec [ t ].fcDet[i].dirDetPitch    = STB_STATUS_NO_DATA ;
-            handle->frDetRec [ t ].fcDet[i].dirDetRoll    = STB_STATUS_NO_DATA ;
-            handle->frDetRec [ t ].fcDet[i].dirDetYaw    = STB_STATUS_NO_DATA ;
-            handle->frDetRec [ t ].fcDet[i].dirDetConf    = STB_STATUS_NO_DATA ;
-            handle->frDetRec [ t ].fcDet[i].frDetID        = STB_STATUS_NO_DATA ;
-            handle->frDetRec [ t ].fcDet[i].frDetConf    = STB_STATUS_NO_DATA ;
-            handle->frDetRec [ t ].fcDet[i].frStatus    = STB_STATUS_NO_DATA ;
+    //The past data is not rewritten here. It is regarded as empty at the next execution (FrClearRec).
+    handle->frClearEpoch++;
 
-        }
-    }
     return STB_NORMAL;
-
-
 }
 /*---------------------------------------------------------------------
 ---------------------------------------------------------------------*/
@@ -447,7 +550,7 @@ STB_INT32 FrSetFrameCount(FRHANDLE handle , STB_INT32 nFrameCount )
     if(nRet != STB_NORMAL){
         return STB_ERR_NOHANDLE;
     }
-    if( nFrameCount < STB_FR_FRAME_CNT_MIN || STB_FR_FRAME_CNT_MAX < nFrameCount)
+    if( nFrameCount < STB_FR_FRAME_CNT_MIN || handle->frBackMax < nFrameCount)
     {
         return STB_ERR_INVALIDPARAM;
     }
@@ -34,9 +34,10 @@ extern "C" {
 //////////////////////////////////////////////////////////////////////////////////
     
 
-#define STB_FR_BACK_MAX        20 /* refer to past "STB_BACK_MAX" frames of results */
+#define STB_FR_BACK_MIN        2 /* refer to past "frBackMax" frames of results : lower limit */
+#define STB_FR_BACK_MAX        128 /* refer to past "frBackMax" frames of results : upper limit */
 
-#define STB_FR_TRA_CNT_MAX 35
+#define STB_FR_TRA_CNT_MAX 256
     
 #define STB_FR_INVALID_UID  -999
 
@@ -62,7 +63,7 @@ extern "C" {
 
 #define STB_FR_FRAME_CNT_INI    5
 #define STB_FR_FRAME_CNT_MIN    0
-#define STB_FR_FRAME_CNT_MAX    20
+#define STB_FR_FRAME_CNT_MAX    STB_FR_BACK_MAX    /* also limited by frBackMax of the handle */
 
 #define STB_FR_FRAME_RATIO_INI    60
 #define STB_FR_FRAME_RATIO_MIN    0
@@ -73,12 +74,26 @@ extern "C" {
 ///////////                            Struct                            //////////////
 //////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////    
+typedef struct {
+    STB_INT32        *recUID        ;//UIDs of one tracking person (frBackMax)
+    STB_INT32        *recConf    ;//confidences of recUID (frBackMax)
+    STB_INT32        *accUID        ;//UID vote table : UID (open addressing, hashMask+1)
+    STB_INT32        *accCnt        ;//UID vote table : a number of votes
+    STB_INT32        *accFirst    ;//UID vote table : index of the first vote in recUID
+    STB_INT32        *accSlot    ;//used entries of the vote table (frBackMax)
+    STB_INT32        hashMask    ;//a number of vote table entries - 1
+    STB_INT32        *traIdx        ;//index in the previous frame for each tracking ID (open addressing, traHashMask+1, -1 : empty)
+    STB_INT32        traHashMask    ;//a number of traIdx entries - 1
+} FR_WORK;
+
 typedef struct tagFRHANDLE {
     
+    STB_INT8        *frMem            ;//block allocated by FrCreateHandle (NULL : memory given by the caller)
     STB_INT8        *frPtr            ;
 
     /* param */
     STB_INT32        frCntMax        ;//Maximum number of tracking people
+    STB_INT32        frBackMax        ;//a number of past frames kept
     STB_INT32        frFaceDirUDMax    ;//The face on top/down allowable range max.
     STB_INT32        frFaceDirUDMin    ;//The face on top/down allowable range min.
     STB_INT32        frFaceDirLRMax    ;//The face on left /right side allowable range max.
@@ -86,10 +101,14 @@ typedef struct tagFRHANDLE {
     STB_INT32        frFaceDirThr    ;//If the confidence of Face direction estimation doesn't exceed the reference value, the recognition result isn't trusted.
     STB_INT32        frFrameCount    ;
     STB_INT32        frFrameRatio    ;
+    STB_UINT32        frClearEpoch    ;//incremented by the clear processing
+    STB_UINT32        frRecEpoch    ;//frClearEpoch that frDetRec belongs to
     /* FR_Face */
     STB_FR_DET        frDet        ;//Present data before the stabilization(input).
-    STB_FR_DET        *frDetRec    ;//past data before the stabilization
+    STB_FR_DET        *frDetRec    ;//past data before the stabilization (ring buffer)
+    STB_INT32        frRecTop    ;//index of the present data in frDetRec. frDetRec[(frRecTop+t)%frBackMax] is t frames before.
     STB_FR_RES        frRes        ;//present data after the stabilization(output)
+    FR_WORK            frWork        ;//work area of the stabilization
 
 } *FRHANDLE;
 
@@ -99,7 +118,9 @@ typedef struct tagFRHANDLE {
 ///////////                            Func                            //////////////
 //////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////
-FRHANDLE    FrCreateHandle    ( const STB_INT32 nTraCntMax );
+STB_UINT32    FrGetRequiredMemorySize( const STB_INT32 nTraCntMax , const STB_INT32 nBackMax );
+FRHANDLE    FrCreateHandleInPlace( STB_INT8 *pMem , const STB_UINT32 nMemSize , const STB_INT32 nTraCntMax , const STB_INT32 nBackMax );
+FRHANDLE    FrCreateHandle    ( const STB_INT32 nTraCntMax , const STB_INT32 nBackMax );
 STB_INT32    FrDeleteHandle    ( FRHANDLE handle);
 STB_INT32    FrSetDetect        ( FRHANDLE handle,const STB_FR_DET *stbPeDet);
 STB_INT32    FrExecute        ( FRHANDLE handle);
@@ -17,51 +17,33 @@
 #include "STBFrAPI.h"
 
 /*---------------------------------------------------------------------*/
-//    FrSlideFacesRec
+//    FrHashID
 /*---------------------------------------------------------------------*/
-void FrSlideFacesRec ( STB_FR_DET *facesRec )
+STB_INT32 FrHashID ( STB_INT32 id , STB_INT32 hashMask )
 {
-    STB_INT32 t , i ;
-
-    for( t = STB_FR_BACK_MAX  - 2 ; t >= 0 ;  t-- ) 
-    {
-        facesRec [ t + 1 ].num = facesRec[ t + 0 ].num;
-        for( i = 0 ; i < facesRec [ t + 1 ].num ;  i++ ) 
-        {
-            facesRec [ t + 1 ].fcDet[i].nDetID            = facesRec [ t ].fcDet[i].nDetID        ;
-            facesRec [ t + 1 ].fcDet[i].nTraID            = facesRec [ t ].fcDet[i].nTraID        ;
-
-            facesRec [ t + 1 ].fcDet[i].dirDetPitch        = facesRec [ t ].fcDet[i].dirDetPitch    ;
-            facesRec [ t + 1 ].fcDet[i].dirDetRoll        = facesRec [ t ].fcDet[i].dirDetRoll    ;
-            facesRec [ t + 1 ].fcDet[i].dirDetYaw        = facesRec [ t ].fcDet[i].dirDetYaw        ;
-            facesRec [ t + 1 ].fcDet[i].dirDetConf        = facesRec [ t ].fcDet[i].dirDetConf    ;
-            facesRec [ t + 1 ].fcDet[i].frDetID            = facesRec [ t ].fcDet[i].frDetID        ;
-            facesRec [ t + 1 ].fcDet[i].frDetConf        = facesRec [ t ].fcDet[i].frDetConf        ;
-            facesRec [ t + 1 ].fcDet[i].frStatus        = facesRec [ t ].fcDet[i].frStatus        ;
-
-        }
-    }
+    //UIDs of one person and tracking IDs are often close to each other, multiplying by an odd constant spreads them over the table.
+    return (STB_INT32)( ( (STB_UINT32)id * 2654435761U ) & (STB_UINT32)hashMask );
 }
 /*---------------------------------------------------------------------*/
 //    FrCurFaces
 /*---------------------------------------------------------------------*/
-void FrCurFaces ( STB_FR_DET *facesRec , STB_FR_DET *srcFace )
+void FrCurFaces ( STB_FR_DET *curRec , STB_FR_DET *srcFace )
 {
     STB_INT32  i ;
 
 
-    facesRec [ 0 ].num = srcFace->num;
-    for( i = 0 ; i < facesRec [ 0 ].num ;  i++ ) 
+    curRec->num = srcFace->num;
+    for( i = 0 ; i < curRec->num ;  i++ ) 
     {
-            facesRec [ 0 ].fcDet[i].nDetID        = srcFace->fcDet[i].nDetID        ;
-            facesRec [ 0 ].fcDet[i].nTraID        = srcFace->fcDet[i].nTraID        ;
-            facesRec [ 0 ].fcDet[i].dirDetPitch    = srcFace->fcDet[i].dirDetPitch    ;
-            facesRec [ 0 ].fcDet[i].dirDetRoll    = srcFace->fcDet[i].dirDetRoll    ;
-            facesRec [ 0 ].fcDet[i].dirDetYaw    = srcFace->fcDet[i].dirDetYaw    ;
-            facesRec [ 0 ].fcDet[i].dirDetConf    = srcFace->fcDet[i].dirDetConf    ;
-            facesRec [ 0 ].fcDet[i].frDetID        = srcFace->fcDet[i].frDetID        ;
-            facesRec [ 0 ].fcDet[i].frDetConf    = srcFace->fcDet[i].frDetConf    ;
-            facesRec [ 0 ].fcDet[i].frStatus    = STB_STATUS_NO_DATA            ;
+            curRec->fcDet[i].nDetID        = srcFace->fcDet[i].nDetID        ;
+            curRec->fcDet[i].nTraID        = srcFace->fcDet[i].nTraID        ;
+            curRec->fcDet[i].dirDetPitch    = srcFace->fcDet[i].dirDetPitch    ;
+            curRec->fcDet[i].dirDetRoll    = srcFace->fcDet[i].dirDetRoll    ;
+            curRec->fcDet[i].dirDetYaw    = srcFace->fcDet[i].dirDetYaw    ;
+            curRec->fcDet[i].dirDetConf    = srcFace->fcDet[i].dirDetConf    ;
+            curRec->fcDet[i].frDetID        = srcFace->fcDet[i].frDetID        ;
+            curRec->fcDet[i].frDetConf    = srcFace->fcDet[i].frDetConf    ;
+            curRec->fcDet[i].frStatus    = STB_STATUS_NO_DATA            ;
 
     }
 
@@ -76,6 +58,9 @@ FrStbFaceEasy
     (
         STB_FR_RES*    peRes        , 
         STB_FR_DET*    peRec        , 
+        STB_INT32    recTop        , 
+        STB_INT32    backMax        , 
+        FR_WORK*    work        , 
         STB_INT32    dirThr        , 
         STB_INT32    dirUDMax    , 
         STB_INT32    dirUDMin    ,
@@ -89,54 +74,60 @@ FrStbFaceEasy
 {
     STB_INT32    i, t, k;
     STB_INT32    trID;
+    STB_FR_DET*    cur;//present data
+    STB_FR_DET*    pre;//data of the previous frame
+    STB_FR_DET*    frm;//data of the previous t frame
     STB_INT32    recCnt;
-    STB_INT32    recUID  [STB_FR_BACK_MAX];
-    STB_INT32    recConf [STB_FR_BACK_MAX];
-
-    STB_INT32    accUID  [STB_FR_BACK_MAX];
-    STB_INT32    accCnt  [STB_FR_BACK_MAX];
+    STB_INT32    *recUID        = work->recUID    ;
+    STB_INT32    *recConf    = work->recConf    ;
+
+    STB_INT32    *accUID        = work->accUID    ;//empty (STB_FR_INVALID_UID) on entry and on exit
+    STB_INT32    *accCnt        = work->accCnt    ;
+    STB_INT32    *accFirst    = work->accFirst;
+    STB_INT32    *accSlot    = work->accSlot    ;
+    STB_INT32    *traIdx        = work->traIdx    ;//index of each tracking ID in "pre"
     STB_INT32    accKind;
-    STB_INT32    tmpUID;
-    STB_INT32    tmpCnt;
+    STB_INT32    h;
     STB_INT32    tmpConf;
     STB_INT32    topUID;
     STB_INT32    topCnt;
+    STB_INT32    topFirst;
     STB_STATUS    preStatus    ;
     STB_INT32    preUID        ;
     STB_INT32    preConf        ;
 
 
-    for( t = 0; t < STB_FR_BACK_MAX    ; t++) 
+    for( t = 0; t < backMax    ; t++) 
     { 
         recUID  [t] = STB_FR_INVALID_UID;
         recConf [t] = 0;
-        accUID  [t] = STB_FR_INVALID_UID;
-        accCnt  [t] = 0;
     }
 
 
     /*Checking the past data here, fill in all peRes.*/
     /*do stabilization processing each tracking person*/
 
-    peRes->frCnt = peRec[0].num;
+    cur = &(peRec[ recTop ]);
+    pre = &(peRec[ ( recTop + 1 ) % backMax ]);
+    peRes->frCnt = cur->num;
     for( k = 0; k < peRes->frCnt; k++)
     {
         /*Tracking person number in the through frame*/
-        trID = peRec[0].fcDet[k].nTraID;
+        trID = cur->fcDet[k].nTraID;
 
         // peRes Add    -------------------------------------------------------------------------------------------------
         peRes->frFace[k].nTraID = trID;
 
 
         //in case of unregistered album for present UID(no album files)
-        if( peRec[0].fcDet[k].frDetID == STB_ERR_FR_NOALBUM )
+        if( cur->fcDet[k].frDetID == STB_ERR_FR_NOALBUM )
         {
             peRes->frFace[k].frRecog.value  = STB_ERR_FR_NOALBUM    ;
             peRes->frFace[k].frRecog.status = STB_STATUS_NO_DATA    ;
             peRes->frFace[k].frRecog.conf    = STB_CONF_NO_DATA        ;
-            peRec[0].fcDet[k].frDetID        = STB_ERR_FR_NOALBUM    ;
-            peRec[0].fcDet[k].frStatus        = STB_STATUS_NO_DATA    ;
-            peRec[0].fcDet[k].frDetConf        = STB_CONF_NO_DATA        ;
+            cur->fcDet[k].frDetID        = STB_ERR_FR_NOALBUM    ;
+            cur->fcDet[k].frStatus        = STB_STATUS_NO_DATA    ;
+            cur->fcDet[k].frDetConf        = STB_CONF_NO_DATA        ;
             continue;
         }
 
@@ -144,15 +135,18 @@ FrStbFaceEasy
         preStatus    = STB_STATUS_NO_DATA    ;
         preUID        = STB_FR_INVALID_UID    ;
         preConf        = 0    ;
-        for( i = 0; i < peRec[1].num    ; i++) 
+        h = FrHashID( trID , work->traHashMask );
+        while( traIdx[ h ] >= 0 )
         { 
-            if(    peRec[1].fcDet[i].nTraID ==    trID  )
+            i = traIdx[ h ];
+            if(    pre->fcDet[i].nTraID ==    trID  )
             {
-                preUID        = peRec[1].fcDet[i].frDetID        ;
-                preStatus    = peRec[1].fcDet[i].frStatus    ;
-                preConf        = peRec[1].fcDet[i].frDetConf    ;
+                preUID        = pre->fcDet[i].frDetID        ;
+                preStatus    = pre->fcDet[i].frStatus    ;
+                preConf        = pre->fcDet[i].frDetConf    ;
                 break;
             }
+            h = ( h + 1 ) & work->traHashMask;
         }
 
 
@@ -166,24 +160,25 @@ FrStbFaceEasy
             //Setting "recUID" to past data of Tracking ID(trID) : (Up to "frmCnt")
             //    -------------------------------------------------------------------------------------------------
             recCnt = 0;
-            for( t = 0; t < STB_FR_BACK_MAX    ; t++) //previous t frame
+            for( t = 0; t < backMax    ; t++) //previous t frame
             { 
-                for( i = 0; i < peRec[t].num    ; i++) //a number of tracking people(previous t frame)
+                frm = &(peRec[ ( recTop + t ) % backMax ]);
+                for( i = 0; i < frm->num    ; i++) //a number of tracking people(previous t frame)
                 { 
                     if(    
-                            peRec [ t ].fcDet[i].nTraID            ==  trID    //the same tracking number
-                        &&    peRec [ t ].fcDet[i].nDetID            >=    0        //not lost
-                        &&    peRec [ t ].fcDet[i].dirDetConf        >=    dirThr    // Face angle : confidence
-                        &&    peRec [ t ].fcDet[i].dirDetPitch    >=    dirUDMin     // Face angle : pitch
-                        &&    peRec [ t ].fcDet[i].dirDetPitch    <=    dirUDMax    // Face angle : pitch
-                        &&    peRec [ t ].fcDet[i].dirDetYaw        >=    dirLRMin     // Face angle : yaw
-                        &&    peRec [ t ].fcDet[i].dirDetYaw        <=    dirLRMax    // Face angle : yaw
-                        &&    peRec [ t ].fcDet[i].frDetID        !=    STB_ERR_FR_CANNOT    //Recognition impossible
-                        &&    peRec [ t ].fcDet[i].frDetID        !=    STB_ERR_FR_NOALBUM    // Not-registered in Album
+                            frm->fcDet[i].nTraID            ==  trID    //the same tracking number
+                        &&    frm->fcDet[i].nDetID            >=    0        //not lost
+                        &&    frm->fcDet[i].dirDetConf        >=    dirThr    // Face angle : confidence
+                        &&    frm->fcDet[i].dirDetPitch    >=    dirUDMin     // Face angle : pitch
+                        &&    frm->fcDet[i].dirDetPitch    <=    dirUDMax    // Face angle : pitch
+                        &&    frm->fcDet[i].dirDetYaw        >=    dirLRMin     // Face angle : yaw
+                        &&    frm->fcDet[i].dirDetYaw        <=    dirLRMax    // Face angle : yaw
+                        &&    frm->fcDet[i].frDetID        !=    STB_ERR_FR_CANNOT    //Recognition impossible
+                        &&    frm->fcDet[i].frDetID        !=    STB_ERR_FR_NOALBUM    // Not-registered in Album
                         )
                     {
-                        recUID [ recCnt ] = peRec [ t ].fcDet[ i ].frDetID    ;
-                        recConf[ recCnt ] = peRec [ t ].fcDet[ i ].frDetConf;
+                        recUID [ recCnt ] = frm->fcDet[ i ].frDetID    ;
+                        recConf[ recCnt ] = frm->fcDet[ i ].frDetConf;
                         recCnt++;
                         break;
                     }
@@ -209,57 +204,47 @@ FrStbFaceEasy
                 tmpConf = 0    ;
             }
             //    -------------------------------------------------------------------------------------------------
-            //Create a cumulative frequency distribution of recUID and set it to accUID [accKind] accCnt [accKind].
-            //AccCnt [i] pieces of data (in the past) determined to be "accUID [i]".
+            //Count recUID in the vote table accUID [h] accCnt [h] (open addressing) in one pass,
+            //and keep the ID whose frequency is the maximum in topUID.
+            //For the same frequency, the ID that appears first in recUID (the newest) is chosen.
             //    -------------------------------------------------------------------------------------------------
-            accKind = 0;
-            for(;;)
+            accKind    =    0                    ;
+            topUID    =    STB_FR_INVALID_UID    ;
+            topCnt    =    0                    ;
+            topFirst=    0                    ;
+            for( i = 0 ; i < recCnt ; i++)
             {
-                tmpUID = STB_FR_INVALID_UID;
-                for( i = 0 ; i < recCnt ; i++)
+                h = FrHashID( recUID[ i ] , work->hashMask );
+                while( accUID[ h ] != STB_FR_INVALID_UID && accUID[ h ] != recUID[ i ] )
                 {
-                    if( recUID[ i ] != STB_FR_INVALID_UID )
-                    {
-                        tmpUID = recUID[ i ];
-                        break;
-                    }
+                    h = ( h + 1 ) & work->hashMask;
                 }
-                if( tmpUID == STB_FR_INVALID_UID )
+                if( accUID[ h ] == STB_FR_INVALID_UID )
                 {
-                    break;
+                    accUID  [ h ] = recUID[ i ];
+                    accCnt  [ h ] = 0;
+                    accFirst[ h ] = i;
+                    accSlot [ accKind ] = h;
+                    accKind++;
                 }
-                tmpCnt = 0;
-                for( i = 0 ; i < recCnt ; i++)
+                accCnt[ h ]++;
+                if( topCnt < accCnt[ h ] || ( topCnt == accCnt[ h ] && accFirst[ h ] < topFirst ) )
                 {
-                    if( recUID[ i ] == tmpUID )
-                    {
-                        recUID[ i ] = STB_FR_INVALID_UID ;
-                        tmpCnt++;
-                    }
+                    topCnt    = accCnt  [ h ] ;
+                    topUID    = accUID  [ h ] ;
+                    topFirst= accFirst[ h ] ;
                 }
-                accUID[accKind] = tmpUID;
-                accCnt[accKind] = tmpCnt;
-                accKind++;
             }
-            //    -------------------------------------------------------------------------------------------------
-            //Find the ID whose frequency is the maximum from the cumulative frequency distribution and set it to topUID.
-            //    -------------------------------------------------------------------------------------------------
-            topUID    =    STB_FR_INVALID_UID    ;
-            topCnt    =    0            ;
             for( i = 0 ; i < accKind ; i++)
             {
-                if( topCnt < accCnt[i] )
-                {
-                    topCnt = accCnt[i] ;
-                    topUID = accUID[i] ;
-                }
+                accUID[ accSlot[ i ] ] = STB_FR_INVALID_UID;//only the used entries are returned to empty
             }
             if( topUID == STB_FR_INVALID_UID )
             {
                 peRes->frFace[k].frRecog.value  = STB_STATUS_NO_DATA    ;
                 peRes->frFace[k].frRecog.conf   = STB_CONF_NO_DATA        ;
                 peRes->frFace[k].frRecog.status = STB_STATUS_NO_DATA;//during stabilization : a number of data for relevant people aren't enough(a number of frames that relevant people are taken)
-                peRec[0].fcDet[k].frStatus        = STB_STATUS_NO_DATA;
+                cur->fcDet[k].frStatus        = STB_STATUS_NO_DATA;
             }else
             {
                 if( topCnt < frmCnt * frmRatio / 100 )
@@ -267,15 +252,15 @@ FrStbFaceEasy
                     peRes->frFace[k].frRecog.value  = topUID                ;
                     peRes->frFace[k].frRecog.conf   = STB_CONF_NO_DATA        ;
                     peRes->frFace[k].frRecog.status = STB_STATUS_CALCULATING;//during stabilization : a number of data for relevant people aren't enough(a number of frames that relevant people are taken)
-                    peRec[0].fcDet[k].frStatus        = STB_STATUS_CALCULATING;
+                    cur->fcDet[k].frStatus        = STB_STATUS_CALCULATING;
                 }else
                 {
                     peRes->frFace[k].frRecog.value  = topUID                ;
                     peRes->frFace[k].frRecog.conf   = tmpConf               ;
                     peRes->frFace[k].frRecog.status = STB_STATUS_COMPLETE    ;//Just after stabilization : The state immediately after the number of data of the relevant person is sufficient and fixed. When creating an entry log, it is better to log data immediately after stabilization.
-                    peRec[0].fcDet[k].frDetID        = topUID                ;
-                    peRec[0].fcDet[k].frStatus        = STB_STATUS_COMPLETE    ;
-                    peRec[0].fcDet[k].frDetConf        = tmpConf                ;
+                    cur->fcDet[k].frDetID        = topUID                ;
+                    cur->fcDet[k].frStatus        = STB_STATUS_COMPLETE    ;
+                    cur->fcDet[k].frDetConf        = tmpConf                ;
                 }
             }
         }else if    (        preStatus == STB_STATUS_COMPLETE        //Just after stabilization
@@ -285,14 +270,35 @@ FrStbFaceEasy
             peRes->frFace[k].frRecog.value  = preUID            ;
             peRes->frFace[k].frRecog.status = STB_STATUS_FIXED    ;
             peRes->frFace[k].frRecog.conf    = preConf;
-            peRec[0].fcDet[k].frDetID        = preUID            ;
-            peRec[0].fcDet[k].frStatus        = STB_STATUS_FIXED    ;
-            peRec[0].fcDet[k].frDetConf        = preConf;
+            cur->fcDet[k].frDetID        = preUID            ;
+            cur->fcDet[k].frStatus        = STB_STATUS_FIXED    ;
+            cur->fcDet[k].frDetConf        = preConf;
             
         }
 
 
     }
+
+    //    -------------------------------------------------------------------------------------------------
+    //The present data becomes "pre" of the next frame : traIdx is rebuilt for it.
+    //For the same tracking ID, the first one is registered like the search of the previous frame.
+    //    -------------------------------------------------------------------------------------------------
+    for( h = 0 ; h <= work->traHashMask ; h++)
+    {
+        traIdx[ h ] = -1;
+    }
+    for( k = 0 ; k < cur->num ; k++)
+    {
+        h = FrHashID( cur->fcDet[k].nTraID , work->traHashMask );
+        while( traIdx[ h ] >= 0 && cur->fcDet[ traIdx[ h ] ].nTraID != cur->fcDet[k].nTraID )
+        {
+            h = ( h + 1 ) & work->traHashMask;
+        }
+        if( traIdx[ h ] < 0 )
+        {
+            traIdx[ h ] = k;
+        }
+    }
 }
 /*---------------------------------------------------------------------*/
 //    StbFrExec
@@ -303,12 +309,15 @@ int  StbFrExec ( FRHANDLE handle )
     int retVal = 0 ;
 
     /* Face --------------------------------------*/
-    FrSlideFacesRec    (   handle->frDetRec        );//Shift the time series of past data before stabilization.
-    FrCurFaces        (   handle->frDetRec    ,
+    handle->frRecTop = ( handle->frRecTop + handle->frBackMax - 1 ) % handle->frBackMax;//The oldest past data is overwritten by the present data.
+    FrCurFaces        ( &(handle->frDetRec[ handle->frRecTop ])    ,
                       &(handle->frDet)            );//Setting "present data before the stabilization" to past data before the stabilization.
 
     FrStbFaceEasy        ( &(handle->frRes)            ,      
                         handle->frDetRec        ,
+                        handle->frRecTop        ,
+                        handle->frBackMax        ,
+                        &(handle->frWork)        ,
                         handle->frFaceDirThr    ,
                         handle->frFaceDirUDMax    ,
                         handle->frFaceDirUDMin    ,
@@ -20,8 +20,16 @@
 /*This layer only defines the API function */
 
 /*Create/Delete handle*/
-STB_FR_HANDLE STB_Fr_CreateHandle( const STB_INT32 nTraCntMax ){
-    return (STB_FR_HANDLE)FrCreateHandle( nTraCntMax );
+STB_FR_HANDLE STB_Fr_CreateHandle( const STB_INT32 nTraCntMax , const STB_INT32 nBackMax ){
+    return (STB_FR_HANDLE)FrCreateHandle( nTraCntMax , nBackMax );
+}
+
+STB_UINT32 STB_Fr_GetRequiredMemorySize( const STB_INT32 nTraCntMax , const STB_INT32 nBackMax ){
+    return FrGetRequiredMemorySize( nTraCntMax , nBackMax );
+}
+
+STB_FR_HANDLE STB_Fr_CreateHandleInPlace( VOID* pMem , const STB_UINT32 nMemSize , const STB_INT32 nTraCntMax , const STB_INT32 nBackMax ){
+    return (STB_FR_HANDLE)FrCreateHandleInPlace( (STB_INT8*)pMem , nMemSize , nTraCntMax , nBackMax );
 }
 
 STB_INT32 STB_Fr_DeleteHandle(STB_FR_HANDLE handle){
@@ -23,7 +23,9 @@
     typedef  VOID*  STB_FR_HANDLE;
 #endif
 
-STB_FR_HANDLE    STB_Fr_CreateHandle            ( const STB_INT32 nTraCntMax                            );/*Create/Delete handle*/
+STB_FR_HANDLE    STB_Fr_CreateHandle            ( const STB_INT32 nTraCntMax , const STB_INT32 nBackMax    );/*Create/Delete handle*/
+STB_UINT32        STB_Fr_GetRequiredMemorySize( const STB_INT32 nTraCntMax , const STB_INT32 nBackMax    );/*Memory size for STB_Fr_CreateHandleInPlace*/
+STB_FR_HANDLE    STB_Fr_CreateHandleInPlace    ( VOID* pMem , const STB_UINT32 nMemSize , const STB_INT32 nTraCntMax , const STB_INT32 nBackMax    );/*Create handle in the memory given by the caller*/
 STB_INT32        STB_Fr_DeleteHandle            ( STB_FR_HANDLE handle                                    );/*Create/Delete handle*/
 STB_INT32        STB_Fr_SetDetect            ( STB_FR_HANDLE handle, const STB_FR_DET *stbFrDet        );/*Frame information settings*/
 STB_INT32        STB_Fr_Execute                ( STB_FR_HANDLE handle                                    );/*Main process execution*/
@@ -47,24 +47,37 @@ static STB_INT32 PeIsValidPointer( const VOID* pPointer )
     return nRet;
 }
 
+/*------------------------------------------------------------------------------------------------------------------*/
+/*    PeCalcHashSize                                                                                                    */
+/*------------------------------------------------------------------------------------------------------------------*/
+STB_UINT32 PeCalcHashSize ( STB_UINT32 nTraCntMax )
+{
+    //power of 2, at least twice the number of the tracking people so that the probe sequences stay short
+    STB_UINT32 retVal ;
+
+    retVal = 1 ;
+    while( retVal < nTraCntMax * 2 )
+    {
+        retVal *= 2 ;
+    }
+    return retVal;
+}
 /*------------------------------------------------------------------------------------------------------------------*/
 /*    PeCalcPeSize                                                                                                        */
 /*------------------------------------------------------------------------------------------------------------------*/
-STB_UINT32 PeCalcPeSize ( STB_UINT32 nTraCntMax )
+STB_UINT32 PeCalcPeSize ( STB_UINT32 nTraCntMax , STB_UINT32 nBackMax )
 {
     STB_UINT32 retVal ;
 
     retVal = 0 ;
 
-    retVal += 100 ;///Margin  : alignment
-
-
-
-    retVal    +=    sizeof( FACE_DET    ) * nTraCntMax                    ;    // peDet.fcDet
-    retVal    +=    sizeof( STB_PE_DET    ) * STB_PE_BACK_MAX                ;    // peDetRec
-    retVal    +=    sizeof( FACE_DET    ) * nTraCntMax * STB_PE_BACK_MAX;    // handle->peDetRec[t].fcDet
-    retVal    +=    sizeof( STB_PE_FACE ) * nTraCntMax                    ;    // peRes.peFace
-    retVal    +=    sizeof( STBExecFlg  )                                ;    // execFlg
+    retVal    +=    STB_MEM_AREA( sizeof( PE_TRACK    ) * nTraCntMax )                ;    // peTrack
+    retVal    +=    STB_MEM_AREA( sizeof( FACE_DET    ) * nTraCntMax )                ;    // peDet.fcDet
+    retVal    +=    STB_MEM_AREA( sizeof( FACE_DET    ) * nBackMax ) * nTraCntMax    ;    // handle->peTrack[i].rec
+    retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax )                ;    // peSlot
+    retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * PeCalcHashSize( nTraCntMax ) );    // peHash
+    retVal    +=    STB_MEM_AREA( sizeof( STB_PE_FACE ) * nTraCntMax )                ;    // peRes.peFace
+    retVal    +=    STB_MEM_AREA( sizeof( STBExecFlg  ) )                            ;    // execFlg
 
     return retVal;
 }
@@ -74,108 +87,123 @@ STB_UINT32 PeCalcPeSize ( STB_UINT32 nTraCntMax )
 void PeSharePeSize ( PEHANDLE    handle )
 {
 
-    STB_UINT32    t;
+    STB_UINT32    i;
     STB_INT8    *stbPtr        = handle->pePtr        ;
     STB_UINT32    nTraCntMax    = handle->peCntMax;
 
-    handle->peDet.fcDet        =    ( FACE_DET*        ) stbPtr;        stbPtr    += ( sizeof( FACE_DET    ) * nTraCntMax    );
-    handle->peDetRec        =    ( STB_PE_DET*    ) stbPtr;        stbPtr    += ( sizeof( STB_PE_DET    ) * STB_PE_BACK_MAX);
-    for( t = 0 ; t < STB_PE_BACK_MAX ; t++ )
+    handle->peTrack            =    ( PE_TRACK*        ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( PE_TRACK    ) * nTraCntMax    );
+    handle->peDet.fcDet        =    ( FACE_DET*        ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( FACE_DET    ) * nTraCntMax    );
+    for( i = 0 ; i < nTraCntMax ; i++ )
     {
-        handle->peDetRec[t].fcDet = ( FACE_DET*    ) stbPtr;        stbPtr    += ( sizeof( FACE_DET    ) * nTraCntMax    );
+        handle->peTrack[i].rec    = ( FACE_DET*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( FACE_DET    ) * handle->peBackMax    );
     }
-    handle->peRes.peFace    =    ( STB_PE_FACE*    ) stbPtr;        stbPtr    += ( sizeof( STB_PE_FACE) * nTraCntMax    );
-    handle->execFlg            =    ( STBExecFlg*    ) stbPtr;        stbPtr    += ( sizeof( STBExecFlg    )                );
+    handle->peSlot            =    ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+    handle->peHash            =    ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * ( handle->peHashMask + 1 ) );
+    handle->peRes.peFace    =    ( STB_PE_FACE*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_PE_FACE) * nTraCntMax    );
+    handle->execFlg            =    ( STBExecFlg*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STBExecFlg    )                );
 
 }
+/*------------------------------------------------------------------------------------------------------------------*/
+/*    PeClearRec                                                                                                        */
+/*------------------------------------------------------------------------------------------------------------------*/
+void PeClearRec ( PEHANDLE    handle )
+{
+    //The past data is referred only within "cnt", so only the slots are released.
+    STB_INT32    i;
+
+    for( i = 0 ; i < handle->peCntMax ; i++ )
+    {
+        handle->peTrack[i].nTraID    = STB_STATUS_NO_DATA;
+        handle->peTrack[i].cnt        = 0;
+        handle->peTrack[i].top        = handle->peBackMax - 1;
+        handle->peTrack[i].used        = STB_FALSE;
+    }
+    for( i = 0 ; i <= handle->peHashMask ; i++ )
+    {
+        handle->peHash[i] = STB_PE_SLOT_NONE;
+    }
+    handle->peRecEpoch = handle->peClearEpoch;
+}
 /*---------------------------------------------------------------------
 ---------------------------------------------------------------------*/
-/*Create handle*/
-PEHANDLE PeCreateHandle(  const STBExecFlg* execFlg ,const STB_INT32 nTraCntMax  ){
-    
-    PEHANDLE    handle;
-    STB_INT32    t , i ,j;
-    STB_INT32    tmpVal    ;
+/*Get the memory size necessary for the handle (0 : invalid parameter)*/
+STB_UINT32 PeGetRequiredMemorySize(  const STBExecFlg* execFlg ,const STB_INT32 nTraCntMax ,const STB_INT32 nBackMax ){
+
+    PEHANDLE    handle    = NULL;
     STB_INT32    nRet    ;
 
     nRet = PeIsValidPointer(execFlg);
     if(nRet != STB_NORMAL)
     {
-        return NULL;
+        return 0;
     }
 
     if( nTraCntMax < 1 || STB_PE_TRA_CNT_MAX < nTraCntMax )
     {
-        return NULL;
+        return 0;
+    }
+    if( nBackMax < STB_PE_BACK_MIN || STB_PE_BACK_MAX < nBackMax )
+    {
+        return 0;
     }
 
+    /*the handle is placed at the cache line boundary, and the areas follow it*/
+    return STB_MEM_ALIGN_TOP - 1 + STB_MEM_AREA( sizeof( *handle ) ) + PeCalcPeSize (    nTraCntMax , nBackMax    );
+}
+/*---------------------------------------------------------------------
+---------------------------------------------------------------------*/
+/*Create handle in the memory given by the caller*/
+PEHANDLE PeCreateHandleInPlace( STB_INT8 *pMem , const STB_UINT32 nMemSize , const STBExecFlg* execFlg ,const STB_INT32 nTraCntMax ,const STB_INT32 nBackMax ){
+    
+    PEHANDLE    handle;
+    STB_UINT32    tmpVal    ;
+    STB_INT32    nRet    ;
 
+    nRet = PeIsValidPointer(pMem);
+    if(nRet != STB_NORMAL)
+    {
+        return NULL;
+    }
 
-    /*do handle's Malloc here*/
-    handle = ( PEHANDLE )malloc( sizeof(*handle) );
-    if(handle == NULL)
+    tmpVal = PeGetRequiredMemorySize( execFlg , nTraCntMax , nBackMax );
+    if( tmpVal == 0 || nMemSize < tmpVal )
     {
         return NULL;
     }
 
+    handle = ( PEHANDLE )STB_MEM_TOP( pMem );
+
     /*initial value---------------------------------------------------------------------*/
     handle->peFaceDirUDMin    = STB_PE_DIR_MIN_UD_INI;//The face on top/down allowable range min.
     handle->peFaceDirUDMax    = STB_PE_DIR_MAX_UD_INI;//The face on top/down allowable range max.
     handle->peFaceDirLRMin    = STB_PE_DIR_MIN_LR_INI;//The face on left /right side allowable range min.
     handle->peFaceDirLRMax    = STB_PE_DIR_MAX_LR_INI;//The face on left /right side allowable range max.
     handle->peFaceDirThr    = STB_PE_DIR_THR_INI    ;//If the confidence of Face direction estimation doesn't exceed the reference value, the recognition result isn't trusted.
-    handle->peFrameCount    = STB_PE_FRAME_CNT_INI    ;
+    handle->peFrameCount    = ( STB_PE_FRAME_CNT_INI < nBackMax ) ? STB_PE_FRAME_CNT_INI : nBackMax;
     handle->peCntMax        = nTraCntMax        ;//Maximum number of tracking people
+    handle->peBackMax        = nBackMax            ;//a number of past frames kept for each tracking person
     handle->pePtr            = NULL;
+    handle->peClearEpoch    = 0;
+    handle->peRecEpoch        = 0;
     handle->peDet.num        = 0;
     handle->peDet.fcDet        = NULL;
-    handle->peDetRec        = NULL;
+    handle->peTrack            = NULL;
+    handle->peSlot            = NULL;
+    handle->peHash            = NULL;
+    handle->peHashMask        = (STB_INT32)PeCalcHashSize( nTraCntMax ) - 1;
+    handle->peAccValid        = STB_TRUE;
+    handle->peSettledAll    = -1;
     handle->peRes.peCnt        = 0;
     handle->peRes.peFace    = NULL;
     handle->execFlg            = NULL;
+    handle->peMem            = NULL;
 
-    tmpVal            = PeCalcPeSize (    nTraCntMax        );    /*calculate necessary amount in the Pe handle*/
-    handle->pePtr    = NULL;
-    handle->pePtr    = ( STB_INT8 * )malloc( tmpVal    );    /*keeping necessary amount in the Pe handle*/
-    if( handle->pePtr == NULL )
-    {
-        free ( handle->pePtr    );
-        free ( handle            );
-        return NULL;
-    }
+    handle->pePtr    = ( STB_INT8 * )handle + STB_MEM_AREA( sizeof( *handle ) );    /*the areas of the Pe handle follow the handle*/
 
-    /*Malloc-area is allocated to things that need Malloc in TR handle*/
+    /*the areas are allocated to things that need them in Pe handle*/
     PeSharePeSize ( handle     );
 
-    for( t = 0 ; t < STB_PE_BACK_MAX ;  t++ ) 
-    {
-        handle->peDetRec [ t ].num = 0;
-        for( i = 0 ; i < handle->peCntMax ;  i++ ) 
-        {
-            handle->peDetRec[t].fcDet[i].nDetID            = STB_STATUS_NO_DATA            ;
-            handle->peDetRec[t].fcDet[i].nTraID            = STB_STATUS_NO_DATA            ;
-            handle->peDetRec[t].fcDet[i].dirDetRoll        = STB_STATUS_NO_DATA            ;
-            handle->peDetRec[t].fcDet[i].dirDetPitch    = STB_STATUS_NO_DATA            ;
-            handle->peDetRec[t].fcDet[i].dirDetYaw        = STB_STATUS_NO_DATA            ;
-            handle->peDetRec[t].fcDet[i].dirDetConf        = STB_STATUS_NO_DATA            ;
-            handle->peDetRec[t].fcDet[i].ageDetVal        = STB_STATUS_NO_DATA            ;
-            handle->peDetRec[t].fcDet[i].ageStatus        = STB_STATUS_NO_DATA            ;
-            handle->peDetRec[t].fcDet[i].ageDetConf        = STB_STATUS_NO_DATA            ;
-            handle->peDetRec[t].fcDet[i].genDetVal        = STB_STATUS_NO_DATA            ;
-            handle->peDetRec[t].fcDet[i].genStatus        = STB_STATUS_NO_DATA            ;
-            handle->peDetRec[t].fcDet[i].genDetConf        = STB_STATUS_NO_DATA            ;
-            handle->peDetRec[t].fcDet[i].gazDetLR        = STB_STATUS_NO_DATA            ;
-            handle->peDetRec[t].fcDet[i].gazDetUD        = STB_STATUS_NO_DATA            ;
-            handle->peDetRec[t].fcDet[i].bliDetL        = STB_STATUS_NO_DATA            ;
-            handle->peDetRec[t].fcDet[i].bliDetR        = STB_STATUS_NO_DATA            ;
-
-            handle->peDetRec[t].fcDet[i].expDetConf        = STB_STATUS_NO_DATA            ;
-            for( j = 0 ; j < STB_EX_MAX ; j++)
-            {
-                handle->peDetRec[t].fcDet[i].expDetVal[ j ]    = STB_STATUS_NO_DATA;
-            }
-        }
-    }
+    PeClearRec ( handle );
 
     handle->execFlg->pet        = execFlg->pet        ;
     handle->execFlg->hand        = execFlg->hand        ;
@@ -189,6 +217,49 @@ PEHANDLE PeCreateHandle(  const STBExecFlg* execFlg ,const STB_INT32 nTraCntMax
     handle->execFlg->dir        = execFlg->dir        ;
     handle->execFlg->bli        = execFlg->bli        ;
 
+    //Only age/gender stop referring to the past data once stabilized.
+    if(        handle->execFlg->gaz != STB_TRUE
+        &&    handle->execFlg->exp != STB_TRUE
+        &&    handle->execFlg->bli != STB_TRUE
+        &&    handle->execFlg->dir != STB_TRUE
+        )
+    {
+        handle->peSettledAll    = ( handle->execFlg->age == STB_TRUE ? STB_PE_SETTLED_AGE : 0 )
+                                | ( handle->execFlg->gen == STB_TRUE ? STB_PE_SETTLED_GEN : 0 );
+    }
+
+
+    return handle;
+}
+/*---------------------------------------------------------------------
+---------------------------------------------------------------------*/
+/*Create handle*/
+PEHANDLE PeCreateHandle(  const STBExecFlg* execFlg ,const STB_INT32 nTraCntMax ,const STB_INT32 nBackMax ){
+
+    PEHANDLE    handle;
+    STB_UINT32    tmpVal    ;
+    STB_INT8    *pMem    ;
+
+    tmpVal = PeGetRequiredMemorySize( execFlg , nTraCntMax , nBackMax );    /*calculate necessary amount in the Pe handle*/
+    if( tmpVal == 0 )
+    {
+        return NULL;
+    }
+
+    /*do Malloc of the handle and its areas at once here*/
+    pMem = ( STB_INT8 * )malloc( tmpVal );
+    if( pMem == NULL )
+    {
+        return NULL;
+    }
+
+    handle = PeCreateHandleInPlace( pMem , tmpVal , execFlg , nTraCntMax , nBackMax );
+    if( handle == NULL )
+    {
+        free ( pMem );
+        return NULL;
+    }
+    handle->peMem = pMem;
 
     return handle;
 }
@@ -204,8 +275,10 @@ STB_INT32 PeDeleteHandle(PEHANDLE handle){
         return STB_ERR_NOHANDLE;
     }
 
-    free ( handle->pePtr    );
-    free ( handle            );
+    if( handle->peMem != NULL )/*NULL : created in the memory given by the caller*/
+    {
+        free ( handle->peMem );
+    }
 
     return STB_NORMAL;
 }
@@ -303,6 +376,12 @@ STB_INT32 PeExecute(PEHANDLE handle){
         return STB_ERR_NOHANDLE;
     }
 
+    /*The past data before the clear processing is not referred*/
+    if( handle->peRecEpoch != handle->peClearEpoch )
+    {
+        PeClearRec ( handle );
+    }
+
     /*Main processing here*/
     nRet = StbPeExec ( handle );
 
@@ -402,7 +481,7 @@ STB_INT32 PeSetFaceDirMinMax(PEHANDLE handle , STB_INT32 nMinUDAngle    , STB_IN
     handle->peFaceDirUDMax = nMaxUDAngle;
     handle->peFaceDirLRMin = nMinLRAngle;
     handle->peFaceDirLRMax = nMaxLRAngle;
-
+    handle->peAccValid     = STB_FALSE;//The sums of the past data are recalculated at the next execution.
 
     return STB_NORMAL;
 }
@@ -445,7 +524,6 @@ STB_INT32 PeGetFaceDirMinMax(PEHANDLE handle ,STB_INT32 *pnMinUDAngle, STB_INT32
 STB_INT32    PeClear            ( PEHANDLE handle  )
 {
     //clear processing
-    STB_INT32 t , i ,j;
     STB_INT32 nRet;
 
     /*NULL check*/
@@ -454,52 +532,8 @@ STB_INT32    PeClear            ( PEHANDLE handle  )
         return STB_ERR_NOHANDLE;
     }
 
-    for( t = 0 ; t < STB_PE_BACK_MAX ;  t++ ) 
-    {
-        handle->peDetRec [ t ].num = 0;
-        for( i = 0 ; i < handle->peCntMax ;  i++ ) 
-        {
-            handle->peDetRec[t].fcDet[i].nDetID            = STB_STATUS_NO_DATA            ;
-            handle->peDetRec[t].fcDet[i].nTraID            = STB_STATUS_NO_DATA            ;
-            if( handle->execFlg->dir == STB_TRUE )
-            {
-                handle->peDetRec[t].fcDet[i].dirDetRoll        = STB_STATUS_NO_DATA            ;
-                handle->peDetRec[t].fcDet[i].dirDetPitch    = STB_STATUS_NO_DATA            ;
-                handle->peDetRec[t].fcDet[i].dirDetYaw        = STB_STATUS_NO_DATA            ;
-                handle->peDetRec[t].fcDet[i].dirDetConf        = STB_STATUS_NO_DATA            ;
-            }
-            if( handle->execFlg->age == STB_TRUE )
-            {
-                handle->peDetRec[t].fcDet[i].ageDetVal        = STB_STATUS_NO_DATA            ;
-                handle->peDetRec[t].fcDet[i].ageStatus        = STB_STATUS_NO_DATA            ;
-                handle->peDetRec[t].fcDet[i].ageDetConf        = STB_STATUS_NO_DATA            ;
-            }
-            if( handle->execFlg->gen == STB_TRUE )
-            {
-                handle->peDetRec[t].fcDet[i].genDetVal        = STB_STATUS_NO_DATA            ;
-                handle->peDetRec[t].fcDet[i].genStatus        = STB_STATUS_NO_DATA            ;
-                handle->peDetRec[t].fcDet[i].genDetConf        = STB_STATUS_NO_DATA            ;
-            }
-            if( handle->execFlg->gaz == STB_TRUE )
-            {
-                handle->peDetRec[t].fcDet[i].gazDetLR        = STB_STATUS_NO_DATA            ;
-                handle->peDetRec[t].fcDet[i].gazDetUD        = STB_STATUS_NO_DATA            ;
-            }
-            if( handle->execFlg->bli == STB_TRUE )
-            {
-                handle->peDetRec[t].fcDet[i].bliDetL        = STB_STATUS_NO_DATA            ;
-                handle->peDetRec[t].fcDet[i].bliDetR        = STB_STATUS_NO_DATA            ;
-            }
-            if( handle->execFlg->exp == STB_TRUE )
-            {
-                handle->peDetRec[t].fcDet[i].expDetConf        = STB_STATUS_NO_DATA            ;
-                for( j = 0 ; j < STB_EX_MAX ; j++)
-                {
-                    handle->peDetRec[t].fcDet[i].expDetVal[j]    = STB_STATUS_NO_DATA            ;
-                }
-            }
-        }
-    }
+    //The past data is not rewritten here. It is regarded as empty at the next execution (PeClearRec).
+    handle->peClearEpoch++;
 
     return STB_NORMAL;
 }
@@ -517,6 +551,7 @@ STB_INT32 PeSetFaceDirThreshold(PEHANDLE handle , STB_INT32 threshold )
     }
 
     handle->peFaceDirThr = threshold;
+    handle->peAccValid   = STB_FALSE;//The sums of the past data are recalculated at the next execution.
     return STB_NORMAL;
 }
 /*---------------------------------------------------------------------
@@ -547,7 +582,7 @@ STB_INT32 PeSetFrameCount(PEHANDLE handle , STB_INT32 nFrameCount )
         return STB_ERR_NOHANDLE;
     }
     
-    if( nFrameCount < 1 || nFrameCount > STB_PE_BACK_MAX  )
+    if( nFrameCount < STB_PE_FRAME_CNT_MIN || nFrameCount > handle->peBackMax  )
     {
         return STB_ERR_INVALIDPARAM;
     }
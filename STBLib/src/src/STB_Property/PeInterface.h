@@ -31,10 +31,15 @@ extern "C" {
 //////////////////////////////////////////////////////////////////////////////////
     
 
-#define STB_PE_BACK_MAX        20     /* refer to past "STB_BACK_MAX" frames of results */
+#define STB_PE_BACK_MIN        2     /* refer to past "peBackMax" frames of results : lower limit */
+#define STB_PE_BACK_MAX        128     /* refer to past "peBackMax" frames of results : upper limit */
 #define STB_PE_EX_MAX            5    //A type of Facial expression
 
-#define STB_PE_TRA_CNT_MAX 35
+#define STB_PE_TRA_CNT_MAX 256
+#define STB_PE_SLOT_NONE    -1    //no slot of the tracking person
+
+#define STB_PE_SETTLED_AGE    0x01    //Age is FIXED : its past data is no longer referred
+#define STB_PE_SETTLED_GEN    0x02    //Gender is FIXED : its past data is no longer referred
 
 #define STB_PE_DIR_MIN_UD_INI -15
 #define STB_PE_DIR_MIN_UD_MIN -90
@@ -55,7 +60,7 @@ extern "C" {
 
 #define STB_PE_FRAME_CNT_INI    5
 #define STB_PE_FRAME_CNT_MIN    1
-#define STB_PE_FRAME_CNT_MAX    20
+#define STB_PE_FRAME_CNT_MAX    STB_PE_BACK_MAX    /* also limited by peBackMax of the handle */
 
 #define STB_PE_DIR_THR_INI        300
 #define STB_PE_DIR_THR_MIN        0
@@ -66,21 +71,69 @@ extern "C" {
 ///////////                            Struct                            //////////////
 //////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////    
+typedef struct {
+    STB_INT32        ageCnt            ;//Age : a number of the data
+    STB_INT32        ageVal            ;//Age : sum of the values
+    STB_INT32        ageConf            ;//Age : sum of the confidences
+    STB_INT32        genCnt            ;//Gender
+    STB_INT32        genVal            ;
+    STB_INT32        genConf            ;
+    STB_INT32        gazLRCnt        ;//Gaze
+    STB_INT32        gazLR            ;
+    STB_INT32        gazUDCnt        ;
+    STB_INT32        gazUD            ;
+    STB_INT32        expCnt            ;//Facial expression : a number of the data
+    STB_INT32        expVal[STB_EX_MAX];//Facial expression : a number of the data of each expression
+    STB_INT32        bliLCnt            ;//Blink
+    STB_INT32        bliL            ;
+    STB_INT32        bliRCnt            ;
+    STB_INT32        bliR            ;
+    STB_INT32        dirCnt            ;//Face direction
+    STB_INT32        dirYaw            ;
+    STB_INT32        dirRoll            ;
+    STB_INT32        dirPitch        ;
+} PE_ACC;
+
+typedef struct {
+    STB_INT32        nTraID            ;//Tracking ID of the slot
+    STB_INT32        cnt                ;//a number of past data (up to peBackMax)
+    STB_INT32        top                ;//index of the present data in rec
+    STB_INT32        used            ;//the tracking person is in the present frame
+    FACE_DET        *rec            ;//past data before the stabilization (ring buffer of peBackMax)
+    PE_ACC            acc                ;//sums of rec, updated as the data enters/leaves rec
+    STB_STATUS        ageStatus        ;//Age : stabilization status of the previous frame
+    STB_INT32        ageVal            ;//Age : stabilized value
+    STB_INT32        ageConf            ;//Age : stabilized confidence
+    STB_STATUS        genStatus        ;//Gender
+    STB_INT32        genVal            ;
+    STB_INT32        genConf            ;
+    STB_INT32        settled            ;//STB_PE_SETTLED_xxx of the properties already stabilized
+} PE_TRACK;
+
 typedef struct tagPEHANDLE {
 
+    STB_INT8        *peMem            ;//block allocated by PeCreateHandle (NULL : memory given by the caller)
     STB_INT8        *pePtr            ;
     /* param */
     STB_INT32        peCntMax        ;//Maximum number of tracking people
+    STB_INT32        peBackMax        ;//a number of past frames kept for each tracking person
     STB_INT32        peFaceDirUDMin    ;//The face on top/down allowable range min.
     STB_INT32        peFaceDirUDMax    ;//The face on top/down allowable range max.
     STB_INT32        peFaceDirLRMin    ;//The face on left /right side allowable range min.
     STB_INT32        peFaceDirLRMax    ;//The face on left /right side allowable range max.
     STB_INT32        peFaceDirThr    ;//If the confidence of Face direction estimation doesn't exceed the reference value, the recognition result isn't trusted.
     STB_INT32        peFrameCount    ;
+    STB_UINT32        peClearEpoch    ;//incremented by the clear processing
+    STB_UINT32        peRecEpoch    ;//peClearEpoch that peTrack belongs to
+    STB_INT32        peHashMask        ;//a number of peHash entries - 1
+    STB_INT32        peAccValid        ;//PE_TRACK.acc matches the present face direction parameters
+    STB_INT32        peSettledAll    ;//PE_TRACK.settled with which no past data is referred at all (-1 : never)
 
     /* PE_Face */
     STB_PE_DET        peDet            ;//Present data before the stabilization(input).
-    STB_PE_DET        *peDetRec        ;//past data before the stabilization
+    PE_TRACK        *peTrack        ;//past data before the stabilization, per tracking person
+    STB_INT32        *peSlot            ;//slot of peTrack for each present face
+    STB_INT32        *peHash            ;//tracking ID -> slot of peTrack (open addressing)
     STB_PE_RES        peRes            ;//present data after the stabilization(output)
     STBExecFlg        *execFlg        ;
 
@@ -91,7 +144,9 @@ typedef struct tagPEHANDLE {
 ///////////                            Func                            //////////////
 //////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////
-PEHANDLE    PeCreateHandle        ( const STBExecFlg* execFlg ,const STB_INT32 nTraCntMax);
+STB_UINT32    PeGetRequiredMemorySize( const STBExecFlg* execFlg ,const STB_INT32 nTraCntMax ,const STB_INT32 nBackMax);
+PEHANDLE    PeCreateHandleInPlace( STB_INT8 *pMem , const STB_UINT32 nMemSize , const STBExecFlg* execFlg ,const STB_INT32 nTraCntMax ,const STB_INT32 nBackMax);
+PEHANDLE    PeCreateHandle        ( const STBExecFlg* execFlg ,const STB_INT32 nTraCntMax ,const STB_INT32 nBackMax);
 STB_INT32    PeDeleteHandle        ( PEHANDLE handle);
 STB_INT32    PeSetDetect            ( PEHANDLE handle,const STB_PE_DET *stbPeDet);
 STB_INT32    PeExecute            ( PEHANDLE handle);
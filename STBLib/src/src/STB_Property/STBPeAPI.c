@@ -18,114 +18,29 @@
 
 
 /*---------------------------------------------------------------------*/
-//    PeSlideFacesRec
+//    PeHashTrID
 /*---------------------------------------------------------------------*/
-void PeSlideFacesRec ( STB_PE_DET *facesRec ,        STBExecFlg    *execFlg)
+STB_INT32 PeHashTrID ( STB_INT32 nTraID , STB_INT32 hashMask )
 {
-    STB_INT32 t , i ,j;
-
-    for( t = STB_PE_BACK_MAX -2 ; t >= 0 ;  t-- ) 
-    {
-        facesRec [ t + 1 ].num = facesRec[ t + 0 ].num;
-        for( i = 0 ; i < facesRec [ t + 1 ].num ;  i++ ) 
-        {
-            facesRec[ t + 1 ].fcDet[i].nDetID        = facesRec[ t ].fcDet[i].nDetID        ;
-            facesRec[ t + 1 ].fcDet[i].nTraID        = facesRec[ t ].fcDet[i].nTraID        ;
-            if( execFlg->gen == STB_TRUE )
-            {
-                facesRec[ t + 1 ].fcDet[i].genDetVal    = facesRec[ t ].fcDet[i].genDetVal    ;
-                facesRec[ t + 1 ].fcDet[i].genStatus    = facesRec[ t ].fcDet[i].genStatus    ;
-                facesRec[ t + 1 ].fcDet[i].genDetConf    = facesRec[ t ].fcDet[i].genDetConf    ;
-            }
-            if( execFlg->age == STB_TRUE )
-            {
-                facesRec[ t + 1 ].fcDet[i].ageDetVal    = facesRec[ t ].fcDet[i].ageDetVal    ;
-                facesRec[ t + 1 ].fcDet[i].ageStatus    = facesRec[ t ].fcDet[i].ageStatus    ;
-                facesRec[ t + 1 ].fcDet[i].ageDetConf    = facesRec[ t ].fcDet[i].ageDetConf    ;
-            }
-            if( execFlg->exp == STB_TRUE )
-            {
-                facesRec[ t + 1 ].fcDet[i].expDetConf    = facesRec[ t ].fcDet[i].expDetConf    ;
-                for( j = 0 ; j < STB_EX_MAX ; j++)
-                {
-                        facesRec[ t + 1 ].fcDet[ i ].expDetVal[ j ]    
-                    = facesRec[ t + 0 ].fcDet[ i ].expDetVal[ j ];
-                }
-            }
-            if( execFlg->gaz == STB_TRUE )
-            {
-                facesRec[ t + 1 ].fcDet[i].gazDetLR        = facesRec[ t ].fcDet[i].gazDetLR    ;
-                facesRec[ t + 1 ].fcDet[i].gazDetUD        = facesRec[ t ].fcDet[i].gazDetUD    ;
-            }
-            //if( execFlg->dir == STB_TRUE )
-            //{
-                facesRec[ t + 1 ].fcDet[i].dirDetRoll    = facesRec[ t ].fcDet[i].dirDetRoll    ;
-                facesRec[ t + 1 ].fcDet[i].dirDetPitch    = facesRec[ t ].fcDet[i].dirDetPitch;
-                facesRec[ t + 1 ].fcDet[i].dirDetYaw    = facesRec[ t ].fcDet[i].dirDetYaw    ;
-                facesRec[ t + 1 ].fcDet[i].dirDetConf    = facesRec[ t ].fcDet[i].dirDetConf    ;
-            //}
-            if( execFlg->bli == STB_TRUE )
-            {
-                facesRec[ t + 1 ].fcDet[i].bliDetL        = facesRec[ t ].fcDet[i].bliDetL    ;
-                facesRec[ t + 1 ].fcDet[i].bliDetR        = facesRec[ t ].fcDet[i].bliDetR    ;
-            }
-        }
-    }
-
+    //Tracking IDs are mostly sequential, multiplying by an odd constant spreads them over the table.
+    return (STB_INT32)( ( (STB_UINT32)nTraID * 2654435761U ) & (STB_UINT32)hashMask );
 }
 /*---------------------------------------------------------------------*/
-//    PeCurFaces
+//    PeFindTrack
 /*---------------------------------------------------------------------*/
-void PeCurFaces ( STB_PE_DET *facesRec , STB_PE_DET *srcFace ,STBExecFlg    *execFlg)
+STB_INT32 PeFindTrack ( PEHANDLE handle , STB_INT32 nTraID )
 {
-    STB_INT32  i ,j;
+    STB_INT32 h;
 
-
-    facesRec [ 0 ].num = srcFace->num;
-    for( i = 0 ; i < facesRec [ 0 ].num ;  i++ ) 
+    for( h = PeHashTrID( nTraID , handle->peHashMask ) ; handle->peHash[h] != STB_PE_SLOT_NONE ; h = ( h + 1 ) & handle->peHashMask )
     {
-        facesRec[ 0 ].fcDet[ i ].nDetID            = srcFace[ 0 ].fcDet[ i ].nDetID    ;
-        facesRec[ 0 ].fcDet[ i ].nTraID            = srcFace[ 0 ].fcDet[ i ].nTraID    ;
-        if( execFlg->gen == STB_TRUE )
-        {
-            facesRec[ 0 ].fcDet[ i ].genDetVal        = srcFace[ 0 ].fcDet[ i ].genDetVal    ;
-            facesRec[ 0 ].fcDet[ i ].genStatus        = STB_STATUS_NO_DATA                ;
-            facesRec[ 0 ].fcDet[ i ].genDetConf        = srcFace[ 0 ].fcDet[ i ].genDetConf;
-        }
-        if( execFlg->age == STB_TRUE )
+        if( handle->peTrack[ handle->peHash[h] ].nTraID == nTraID )
         {
-            facesRec[ 0 ].fcDet[ i ].ageDetVal        = srcFace[ 0 ].fcDet[ i ].ageDetVal    ;
-            facesRec[ 0 ].fcDet[ i ].ageStatus        = STB_STATUS_NO_DATA                ;
-            facesRec[ 0 ].fcDet[ i ].ageDetConf        = srcFace[ 0 ].fcDet[ i ].ageDetConf;
-        }
-        if( execFlg->exp == STB_TRUE )
-        {
-            facesRec[ 0 ].fcDet[ i ].expDetConf        = srcFace[ 0 ].fcDet[ i ].expDetConf    ;
-            for( j = 0 ; j < STB_EX_MAX ; j++)
-            {
-                facesRec[ 0 ].fcDet[ i ].expDetVal[ j]    = srcFace[ 0 ].fcDet[ i ].expDetVal[ j];
-            }
-        }
-        if( execFlg->gaz == STB_TRUE )
-        {
-            facesRec[ 0 ].fcDet[ i ].gazDetLR        = srcFace[ 0 ].fcDet[ i ].gazDetLR    ;
-            facesRec[ 0 ].fcDet[ i ].gazDetUD        = srcFace[ 0 ].fcDet[ i ].gazDetUD    ;
-        }
-        //if( execFlg->dir == STB_TRUE )
-        //{
-            facesRec[ 0 ].fcDet[ i ].dirDetRoll        = srcFace[ 0 ].fcDet[ i ].dirDetRoll    ;
-            facesRec[ 0 ].fcDet[ i ].dirDetYaw        = srcFace[ 0 ].fcDet[ i ].dirDetYaw    ;
-            facesRec[ 0 ].fcDet[ i ].dirDetPitch    = srcFace[ 0 ].fcDet[ i ].dirDetPitch    ;
-            facesRec[ 0 ].fcDet[ i ].dirDetConf        = srcFace[ 0 ].fcDet[ i ].dirDetConf    ;
-        //}
-        if( execFlg->bli == STB_TRUE )
-        {
-            facesRec[ 0 ].fcDet[ i ].bliDetL        = srcFace[ 0 ].fcDet[ i ].bliDetL        ;
-            facesRec[ 0 ].fcDet[ i ].bliDetR        = srcFace[ 0 ].fcDet[ i ].bliDetR        ;
+            return handle->peHash[h];
         }
     }
+    return STB_PE_SLOT_NONE;
 }
-
 /*----------------------------------------------------------------------------------------------------*/
 /* PeExpressID */
 /*----------------------------------------------------------------------------------------------------*/
@@ -148,17 +63,271 @@ STB_INT32 PeExpressID( STB_INT32* exp )
     return retVal;
 }
 /*---------------------------------------------------------------------*/
-//    PeStbFaceEasy
+//    PeAccSample
 /*---------------------------------------------------------------------*/
-void PeStbFaceEasy
+void PeAccSample
     (
-        STB_PE_RES *peRes        , 
-        STB_PE_DET *peRec        , 
+        PE_ACC        *acc        , 
+        FACE_DET    *rec        , 
+        STB_INT32    sign        , //1 : the data enters , -1 : the data leaves
+        STB_INT32    settled        , //STB_PE_SETTLED_xxx : the property is not summed any more
+        STB_INT32    dirThr        , 
+        STB_INT32    dirUDMax    , 
+        STB_INT32    dirUDMin    ,
+        STB_INT32    dirLRMax    , 
+        STB_INT32    dirLRMin    ,
+        STBExecFlg    *execFlg
+    )
+{
+    /*Add (or remove) one past data to the sums of all properties.*/
+    if(    
+            rec->nDetID            <    0            //lost
+        ||    rec->dirDetConf        <    dirThr        // Face angle : confidence
+        ||    rec->dirDetPitch    <    dirUDMin     // Face angle : pitch
+        ||    rec->dirDetPitch    >    dirUDMax    // Face angle : pitch
+        ||    rec->dirDetYaw        <    dirLRMin     // Face angle : yaw
+        ||    rec->dirDetYaw        >    dirLRMax    // Face angle : yaw
+        )
+    {
+        return;
+    }
+
+    // age
+    if(    execFlg->age == STB_TRUE
+        &&    ( settled & STB_PE_SETTLED_AGE ) == 0
+        &&    rec->ageDetVal        !=    STB_ERR_PE_CANNOT
+        &&    rec->ageDetConf        !=    STB_ERR_PE_CANNOT
+        )
+    {
+        acc->ageCnt        += sign                        ;
+        acc->ageVal        += sign * rec->ageDetVal    ;
+        acc->ageConf    += sign * rec->ageDetConf    ;
+    }
+    // gender
+    if(    execFlg->gen == STB_TRUE
+        &&    ( settled & STB_PE_SETTLED_GEN ) == 0
+        &&    rec->genDetVal        !=    STB_ERR_PE_CANNOT
+        &&    rec->genDetConf        !=    STB_ERR_PE_CANNOT
+        )
+    {
+        acc->genCnt        += sign                        ;
+        acc->genVal        += sign * rec->genDetVal    ;// 1:man 0:woman
+        acc->genConf    += sign * rec->genDetConf    ;
+    }
+    // gaze
+    if( execFlg->gaz == STB_TRUE )
+    {
+        if( rec->gazDetLR != STB_ERR_PE_CANNOT )
+        {
+            acc->gazLRCnt    += sign                    ;
+            acc->gazLR        += sign * rec->gazDetLR    ;
+        }
+        if( rec->gazDetUD != STB_ERR_PE_CANNOT )
+        {
+            acc->gazUDCnt    += sign                    ;
+            acc->gazUD        += sign * rec->gazDetUD    ;
+        }
+    }
+    // expression
+    if( execFlg->exp == STB_TRUE && rec->expDetConf != STB_ERR_PE_CANNOT )
+    {
+        acc->expCnt                                    += sign    ;
+        acc->expVal[ PeExpressID ( rec->expDetVal ) ]    += sign    ;
+    }
+    // blink
+    if( execFlg->bli == STB_TRUE )
+    {
+        if( rec->bliDetL != STB_ERR_PE_CANNOT )
+        {
+            acc->bliLCnt    += sign                    ;
+            acc->bliL        += sign * rec->bliDetL    ;
+        }
+        if( rec->bliDetR != STB_ERR_PE_CANNOT )
+        {
+            acc->bliRCnt    += sign                    ;
+            acc->bliR        += sign * rec->bliDetR    ;
+        }
+    }
+    // direction
+    if( execFlg->dir == STB_TRUE )
+    {
+        acc->dirCnt        += sign                        ;
+        acc->dirYaw        += sign * rec->dirDetYaw    ;
+        acc->dirRoll    += sign * rec->dirDetRoll    ;
+        acc->dirPitch    += sign * rec->dirDetPitch    ;
+    }
+}
+/*---------------------------------------------------------------------*/
+//    PeAccFace
+/*---------------------------------------------------------------------*/
+void PeAccFace
+    (
+        PE_ACC        *acc        , 
+        FACE_DET    *rec        , 
+        STB_INT32    recCnt        , 
+        STB_INT32    settled        , 
         STB_INT32    dirThr        , 
         STB_INT32    dirUDMax    , 
         STB_INT32    dirUDMin    ,
         STB_INT32    dirLRMax    , 
         STB_INT32    dirLRMin    ,
+        STBExecFlg    *execFlg
+    )
+{
+    /*Recalculate the sums from all past data of one tracking person.*/
+    STB_INT32    t , i ;
+
+    acc->ageCnt        = 0;
+    acc->ageVal        = 0;
+    acc->ageConf    = 0;
+    acc->genCnt        = 0;
+    acc->genVal        = 0;
+    acc->genConf    = 0;
+    acc->gazLRCnt    = 0;
+    acc->gazLR        = 0;
+    acc->gazUDCnt    = 0;
+    acc->gazUD        = 0;
+    acc->expCnt        = 0;
+    for( i = 0; i < STB_EX_MAX; i++ )
+    {
+        acc->expVal[i] = 0;
+    }
+    acc->bliLCnt    = 0;
+    acc->bliL        = 0;
+    acc->bliRCnt    = 0;
+    acc->bliR        = 0;
+    acc->dirCnt        = 0;
+    acc->dirYaw        = 0;
+    acc->dirRoll    = 0;
+    acc->dirPitch    = 0;
+
+    for( t = 0; t < recCnt    ; t++) //past data of the tracking person
+    { 
+        PeAccSample ( acc , &(rec[t]) , 1 , settled , dirThr , dirUDMax , dirUDMin , dirLRMax , dirLRMin , execFlg );
+    }
+}
+/*---------------------------------------------------------------------*/
+//    PeSetTrackRec
+/*---------------------------------------------------------------------*/
+void PeSetTrackRec ( PEHANDLE handle )
+{
+    //Setting "present data before the stabilization" to the past data of each tracking person.
+    //A tracking person who isn't in the present frame releases the slot.
+    STB_INT32    i , s , h;
+    PE_TRACK    *track;
+
+    for( s = 0 ; s < handle->peCntMax ; s++ )
+    {
+        handle->peTrack[s].used = STB_FALSE;
+    }
+    //the tracking people of the previous frame
+    for( i = 0 ; i < handle->peDet.num ; i++ )
+    {
+        s = PeFindTrack( handle , handle->peDet.fcDet[i].nTraID );
+        if( s != STB_PE_SLOT_NONE && handle->peTrack[s].used == STB_TRUE )
+        {
+            s = STB_PE_SLOT_NONE;//the same tracking ID twice in a frame
+        }
+        if( s != STB_PE_SLOT_NONE )
+        {
+            handle->peTrack[s].used = STB_TRUE;
+        }
+        handle->peSlot[i] = s;
+    }
+    for( s = 0 ; s < handle->peCntMax ; s++ )
+    {
+        if( handle->peTrack[s].used == STB_FALSE )
+        {
+            handle->peTrack[s].cnt = 0;
+        }
+    }
+    //new tracking people
+    s = 0;
+    for( i = 0 ; i < handle->peDet.num ; i++ )
+    {
+        if( handle->peSlot[i] != STB_PE_SLOT_NONE )
+        {
+            continue;
+        }
+        while( handle->peTrack[s].used == STB_TRUE )
+        {
+            s++;
+        }
+        handle->peTrack[s].nTraID    = handle->peDet.fcDet[i].nTraID;
+        handle->peTrack[s].cnt        = 0;
+        handle->peTrack[s].top        = handle->peBackMax - 1;
+        handle->peTrack[s].used        = STB_TRUE;
+        handle->peTrack[s].ageStatus= STB_STATUS_NO_DATA;
+        handle->peTrack[s].ageVal    = 0;
+        handle->peTrack[s].ageConf    = 0;
+        handle->peTrack[s].genStatus= STB_STATUS_NO_DATA;
+        handle->peTrack[s].genVal    = 0;
+        handle->peTrack[s].genConf    = 0;
+        handle->peTrack[s].settled    = 0;
+        PeAccFace ( &(handle->peTrack[s].acc) , handle->peTrack[s].rec , 0 , 0 , 0 , 0 , 0 , 0 , 0 , handle->execFlg );
+        handle->peSlot[i]            = s;
+    }
+
+    //tracking ID -> slot
+    for( h = 0 ; h <= handle->peHashMask ; h++ )
+    {
+        handle->peHash[h] = STB_PE_SLOT_NONE;
+    }
+    for( i = 0 ; i < handle->peDet.num ; i++ )
+    {
+        for( h = PeHashTrID( handle->peDet.fcDet[i].nTraID , handle->peHashMask ) ; handle->peHash[h] != STB_PE_SLOT_NONE ; h = ( h + 1 ) & handle->peHashMask )
+        {
+        }
+        handle->peHash[h] = handle->peSlot[i];
+    }
+
+    //present data : the oldest data leaves the sums and the present data enters them
+    for( i = 0 ; i < handle->peDet.num ; i++ )
+    {
+        track = &(handle->peTrack[ handle->peSlot[i] ]);
+        if( track->settled == handle->peSettledAll )
+        {
+            continue;//all properties are already stabilized : the past data is not referred any more
+        }
+        track->top = ( track->top + 1 ) % handle->peBackMax;
+        if( track->cnt < handle->peBackMax )
+        {
+            track->cnt++;
+        }else if( handle->peAccValid == STB_TRUE )
+        {
+            PeAccSample ( &(track->acc) , &(track->rec[ track->top ]) , -1 , track->settled , handle->peFaceDirThr ,
+                        handle->peFaceDirUDMax , handle->peFaceDirUDMin , handle->peFaceDirLRMax , handle->peFaceDirLRMin , handle->execFlg );
+        }
+        track->rec[ track->top ] = handle->peDet.fcDet[i];
+        if( handle->peAccValid == STB_TRUE )
+        {
+            PeAccSample ( &(track->acc) , &(track->rec[ track->top ]) , 1 , track->settled , handle->peFaceDirThr ,
+                        handle->peFaceDirUDMax , handle->peFaceDirUDMin , handle->peFaceDirLRMax , handle->peFaceDirLRMin , handle->execFlg );
+        }
+    }
+
+    //The face direction parameters were changed : recalculate the sums
+    if( handle->peAccValid != STB_TRUE )
+    {
+        for( i = 0 ; i < handle->peDet.num ; i++ )
+        {
+            track = &(handle->peTrack[ handle->peSlot[i] ]);
+            PeAccFace ( &(track->acc) , track->rec , track->cnt , track->settled , handle->peFaceDirThr ,
+                        handle->peFaceDirUDMax , handle->peFaceDirUDMin , handle->peFaceDirLRMax , handle->peFaceDirLRMin , handle->execFlg );
+        }
+        handle->peAccValid = STB_TRUE;
+    }
+}
+
+/*---------------------------------------------------------------------*/
+//    PeStbFaceEasy
+/*---------------------------------------------------------------------*/
+void PeStbFaceEasy
+    (
+        STB_PE_RES *peRes        , 
+        STB_PE_DET *peDet        , 
+        PE_TRACK   *peTrack        , 
+        STB_INT32  *peSlot        , 
         STB_INT32    frmMax        ,
         STBExecFlg    *execFlg
     )
@@ -166,15 +335,16 @@ void PeStbFaceEasy
     
 
     /*Checking the past data here, fill in all peRes.*/
-    STB_INT32    k ,t,i ;
+    STB_INT32    k ;
     STB_INT32    trID;
+    PE_TRACK    *track;
+    PE_ACC        *acc;
 
     STB_INT32    recCnt;
-    STB_INT32    recVal    [STB_PE_BACK_MAX];
-    STB_INT32    recConf    [STB_PE_BACK_MAX];
     STB_INT32    tmpVal;
     STB_INT32    tmpConf;
-    STB_INT32    expVal    [STB_EX_MAX] = {0};
+    STB_INT32    ageFlg;
+    STB_INT32    genFlg;
     
     STB_STATUS    preSAge    ;
     STB_STATUS    preSGen    ;
@@ -186,18 +356,13 @@ void PeStbFaceEasy
 
 
 
-    for( t = 0; t < STB_PE_BACK_MAX    ; t++) 
-    { 
-        recVal [t] = 0;
-        recConf[t] = 0;
-    }
-    
-
     /*do stabilization processing each tracking person*/
-    peRes->peCnt = peRec[0].num    ;//a number of tracking people(present)
+    peRes->peCnt = peDet->num    ;//a number of tracking people(present)
     for( k = 0; k < peRes->peCnt ; k++) 
     {
-        trID = peRec[0].fcDet[k].nTraID;/*Tracking person number in the through frame*/
+        trID = peDet->fcDet[k].nTraID;/*Tracking person number in the through frame*/
+        track    = &(peTrack[ peSlot[k] ]);
+        acc        = &(track->acc);//sums of the past data of the tracking person
 
 
         // peRes Add    -------------------------------------------------------------------------------------------------
@@ -213,73 +378,40 @@ void PeStbFaceEasy
         preCGen = 0    ;
         if( execFlg->age == STB_TRUE  || execFlg->gen == STB_TRUE  )
         {
-            for( i = 0; i < peRec[1].num    ; i++) 
-            { 
-                if(    peRec[1].fcDet[i].nTraID ==    trID  )
-                {
-                    preSAge    = peRec[1].fcDet[i].ageStatus    ;
-                    preSGen    = peRec[1].fcDet[i].genStatus    ;
-                    preVAge    = peRec[1].fcDet[i].ageDetVal    ;
-                    preVGen    = peRec[1].fcDet[i].genDetVal    ;
-                    preCAge    = peRec[1].fcDet[i].ageDetConf    ;
-                    preCGen    = peRec[1].fcDet[i].genDetConf    ;
-                    break;
-                }
-            }
+            //the result of the previous frame (NO_DATA for a new tracking person)
+            preSAge    = track->ageStatus    ;
+            preSGen    = track->genStatus    ;
+            preVAge    = track->ageVal        ;
+            preVGen    = track->genVal        ;
+            preCAge    = track->ageConf    ;
+            preCGen    = track->genConf    ;
         }
+        //stabilization impossible / during stabilization : the past data is referred
+        ageFlg = ( execFlg->age == STB_TRUE && ( preSAge == STB_STATUS_NO_DATA || preSAge == STB_STATUS_CALCULATING ) ) ? STB_TRUE : STB_FALSE;
+        genFlg = ( execFlg->gen == STB_TRUE && ( preSGen == STB_STATUS_NO_DATA || preSGen == STB_STATUS_CALCULATING ) ) ? STB_TRUE : STB_FALSE;
 
         // age            -------------------------------------------------------------------------------------------------
         if( execFlg->age == STB_TRUE )
         {
-            if            (        preSAge == STB_STATUS_NO_DATA        //stabilization impossible: no data of the relevant people 
-                            ||    preSAge == STB_STATUS_CALCULATING    //during stabilization : a number of data for relevant people aren't enough(a number of frames that relevant people are taken)
-                )
+            if( ageFlg == STB_TRUE )
             {
-                recCnt = 0;
-                for( t = 0; t < STB_PE_BACK_MAX    ; t++) //previous t frame
-                { 
-                for( i = 0; i < peRec[t].num    ; i++) //a number of tracking people(previous t frame)
-                { 
-                    if(    
-                            peRec[t].fcDet[i].nTraID        ==  trID        //the same tracking number
-                        &&    peRec[t].fcDet[i].nDetID        >=    0            //not lost
-                        &&    peRec[t].fcDet[i].dirDetConf    >=    dirThr        // Face angle : confidence
-                        &&    peRec[t].fcDet[i].dirDetPitch    >=    dirUDMin     // Face angle : pitch
-                        &&    peRec[t].fcDet[i].dirDetPitch    <=    dirUDMax    // Face angle : pitch
-                        &&    peRec[t].fcDet[i].dirDetYaw        >=    dirLRMin     // Face angle : yaw
-                        &&    peRec[t].fcDet[i].dirDetYaw        <=    dirLRMax    // Face angle : yaw
-                        &&    peRec[t].fcDet[i].ageDetVal        !=    STB_ERR_PE_CANNOT    // 
-                        &&    peRec[t].fcDet[i].ageDetConf    !=    STB_ERR_PE_CANNOT    // 
-                        )
-                    {
-                        recVal [ recCnt ] = peRec[ t ].fcDet[ i ].ageDetVal        ;
-                        recConf[ recCnt ] = peRec[ t ].fcDet[ i ].ageDetConf    ;
-                        recCnt++;
-                    }
-                }
-                }
+                recCnt    = acc->ageCnt;
                 tmpS    = STB_STATUS_NO_DATA;
                 if        ( recCnt == 0            )        {    tmpS    = STB_STATUS_NO_DATA    ;    }//stabilization impossible
                 else if    ( recCnt <  frmMax      )        {    tmpS    = STB_STATUS_CALCULATING;    }//during stabilization
                 else if    ( recCnt >= frmMax      )        {    tmpS    = STB_STATUS_COMPLETE    ;    }//Just after stabilization
-                tmpVal    = 0;
-                tmpConf = 0;
-                for( i = 0; i < recCnt    ; i++    )        
-                {     
-                    tmpVal    += recVal [ i ]            ;    
-                    tmpConf    += recConf[ i ]            ;    
-                }
                 if ( recCnt == 0                )        {    recCnt    =  1                    ;    }
-                tmpVal    /= recCnt;
-                tmpConf /= recCnt;
+                tmpVal    = acc->ageVal    / recCnt;
+                tmpConf = acc->ageConf    / recCnt;
                 peRes->peFace[k].age.value            = tmpVal            ;
                 peRes->peFace[k].age.conf            = STB_CONF_NO_DATA    ;
                 peRes->peFace[k].age.status            = tmpS                ;
-                peRec[0].fcDet[k].ageStatus            = tmpS                ;
+                track->ageStatus                    = tmpS                ;
                 if( tmpS    == STB_STATUS_COMPLETE    )//Just after stabilization
                 {
-                    peRec[0].fcDet[k].ageDetVal        = tmpVal        ;
-                    peRec[0].fcDet[k].ageDetConf    = tmpConf        ;
+                    track->ageVal        = tmpVal        ;
+                    track->ageConf        = tmpConf        ;
+                    track->settled        |= STB_PE_SETTLED_AGE;
                 }
             }else if    (        preSAge == STB_STATUS_COMPLETE        //Just after stabilization
                             ||    preSAge == STB_STATUS_FIXED            //already stabilized
@@ -288,9 +420,9 @@ void PeStbFaceEasy
                 peRes->peFace[k].age.value        = preVAge            ;
                 peRes->peFace[k].age.conf        = preCAge;
                 peRes->peFace[k].age.status        = STB_STATUS_FIXED    ;//already stabilized
-                peRec[0].fcDet[k].ageDetVal        = preVAge            ;
-                peRec[0].fcDet[k].ageDetConf    = preCAge            ;
-                peRec[0].fcDet[k].ageStatus        = STB_STATUS_FIXED    ;//already stabilized
+                track->ageVal        = preVAge            ;
+                track->ageConf        = preCAge            ;
+                track->ageStatus    = STB_STATUS_FIXED    ;//already stabilized
             }
         }
 
@@ -298,69 +430,25 @@ void PeStbFaceEasy
         // gender        -------------------------------------------------------------------------------------------------
         if( execFlg->gen == STB_TRUE )
         {
-            if            (        preSGen == STB_STATUS_NO_DATA        //stabilization impossible: no data of the relevant people 
-                            ||    preSGen == STB_STATUS_CALCULATING    //during stabilization : a number of data for relevant people aren't enough(a number of frames that relevant people are taken)
-                )
+            if( genFlg == STB_TRUE )
             {
-                recCnt = 0;
-                for( t = 0; t < STB_PE_BACK_MAX    ; t++) 
-                { 
-                for( i = 0; i < peRec[t].num    ; i++) //a number of tracking people(previous t frame)
-                { 
-                    if(    
-                            peRec[t].fcDet[i].nTraID        ==  trID        //the same tracking number
-                        &&    peRec[t].fcDet[i].nDetID        >=    0            //not lost
-                        &&    peRec[t].fcDet[i].dirDetConf    >=    dirThr        // Face angle : confidence
-                        &&    peRec[t].fcDet[i].dirDetPitch    >=    dirUDMin     // Face angle : pitch
-                        &&    peRec[t].fcDet[i].dirDetPitch    <=    dirUDMax    // Face angle : pitch
-                        &&    peRec[t].fcDet[i].dirDetYaw        >=    dirLRMin     // Face angle : yaw
-                        &&    peRec[t].fcDet[i].dirDetYaw        <=    dirLRMax    // Face angle : yaw
-                        &&    peRec[t].fcDet[i].genDetVal        !=    STB_ERR_PE_CANNOT    // 
-                        &&    peRec[t].fcDet[i].genDetConf    !=    STB_ERR_PE_CANNOT    // 
-                        )
-                    {
-                        recVal [ recCnt ] = peRec[ t ].fcDet[ i ].genDetVal ;// 1:man 0:woman
-                        recConf[ recCnt ] = peRec[ t ].fcDet[ i ].genDetConf;
-                        recCnt++;
-                    }
-                }
-                }
+                recCnt    = acc->genCnt;
                 tmpS    = STB_STATUS_NO_DATA;
                 if        ( recCnt == 0            )        {    tmpS    = STB_STATUS_NO_DATA    ;    }//stabilization impossible
                 else if    ( recCnt <  frmMax      )        {    tmpS    = STB_STATUS_CALCULATING;    }//during stabilization
                 else if    ( recCnt >= frmMax      )        {    tmpS    = STB_STATUS_COMPLETE    ;    }//Just after stabilization
-                tmpVal  = 0;
-                tmpConf = 0;
-                for( i = 0; i < recCnt    ; i++    )        
-                {     
-                    tmpVal  += recVal [ i ]                ;
-                    tmpConf += recConf[ i ]                ;    
-                }
                 if ( recCnt == 0                )        {    recCnt    =  1                        ;        }
-                tmpConf /= recCnt;
-                if        ( tmpVal * 2 <= recCnt    )    
-                {    
-                    peRes->peFace[k].gen.value    = 0                    ;// 1:man 0:woman    
-                    peRes->peFace[k].gen.status    = tmpS                ;
-                    peRes->peFace[k].gen.conf    = STB_CONF_NO_DATA    ;
-                    peRec[0].fcDet[k].genStatus = tmpS                ;
-                    if( tmpS    == STB_STATUS_COMPLETE    )//Just after stabilization
-                    {
-                        peRec[0].fcDet[k].genDetVal        = 0            ;
-                        peRec[0].fcDet[k].genDetConf    = tmpConf    ;
-                    }
-                }
-                else
+                tmpVal    = ( acc->genVal * 2 <= recCnt ) ? 0 : 1 ;// 1:man 0:woman    
+                tmpConf = acc->genConf / recCnt;
+                peRes->peFace[k].gen.value    = tmpVal            ;
+                peRes->peFace[k].gen.status    = tmpS                ;
+                peRes->peFace[k].gen.conf    = STB_CONF_NO_DATA    ;
+                track->genStatus            = tmpS                ;
+                if( tmpS    == STB_STATUS_COMPLETE    )//Just after stabilization
                 {
-                    peRes->peFace[k].gen.value    = 1                    ;// 1:man 0:woman    
-                    peRes->peFace[k].gen.status    = tmpS                ;
-                    peRes->peFace[k].gen.conf    = STB_CONF_NO_DATA    ;
-                    peRec[0].fcDet[k].genStatus = tmpS                ;
-                    if( tmpS    == STB_STATUS_COMPLETE    )//Just after stabilization
-                    {
-                        peRec[0].fcDet[k].genDetVal        = 1            ;
-                        peRec[0].fcDet[k].genDetConf    = tmpConf    ;
-                    }    
+                    track->genVal        = tmpVal    ;
+                    track->genConf        = tmpConf    ;
+                    track->settled        |= STB_PE_SETTLED_GEN;
                 }
             }else if    (        preSGen == STB_STATUS_COMPLETE        //Just after stabilization
                             ||    preSGen == STB_STATUS_FIXED        //already stabilized
@@ -369,244 +457,53 @@ void PeStbFaceEasy
                 peRes->peFace[k].gen.value        = preVGen            ;
                 peRes->peFace[k].gen.conf        = preCGen;
                 peRes->peFace[k].gen.status        = STB_STATUS_FIXED    ;//already stabilized
-                peRec[0].fcDet[k].genDetVal        = preVGen            ;
-                peRec[0].fcDet[k].genStatus        = STB_STATUS_FIXED    ;//already stabilized
-                peRec[0].fcDet[k].genDetConf    = preCGen            ;
+                track->genVal        = preVGen            ;
+                track->genStatus    = STB_STATUS_FIXED    ;//already stabilized
+                track->genConf        = preCGen            ;
             }
         }
 
-        // gazeLR                -------------------------------------------------------------------------------------------------
+        // gaze                -------------------------------------------------------------------------------------------------
         if( execFlg->gaz == STB_TRUE )
         {
-            recCnt = 0;
-            for( t = 0; t < STB_PE_BACK_MAX    ; t++) 
-            { 
-            for( i = 0; i < peRec[t].num    ; i++) //a number of tracking people(previous t frame)
-            { 
-                if(    
-                            peRec[t].fcDet[i].nTraID        ==  trID        //the same tracking number
-                        &&    peRec[t].fcDet[i].nDetID        >=    0            //not lost
-                        &&    peRec[t].fcDet[i].dirDetConf    >=    dirThr        // Face angle : confidence
-                        &&    peRec[t].fcDet[i].dirDetPitch    >=    dirUDMin     // Face angle : pitch
-                        &&    peRec[t].fcDet[i].dirDetPitch    <=    dirUDMax    // Face angle : pitch
-                        &&    peRec[t].fcDet[i].dirDetYaw        >=    dirLRMin     // Face angle : yaw
-                        &&    peRec[t].fcDet[i].dirDetYaw        <=    dirLRMax    // Face angle : yaw
-                        &&    peRec[t].fcDet[i].gazDetLR        !=    STB_ERR_PE_CANNOT    // 
-                    )
-                {
-                    recVal[ recCnt ] = peRec[ t ].fcDet [ i ].gazDetLR    ;
-                    recCnt++;
-                }
-            }
-            }
-            if        ( recCnt     == 0                )        {    peRes->peFace[k].gaz.status    = STB_STATUS_NO_DATA    ;        }//stabilization impossible
-            else                                            {    peRes->peFace[k].gaz.status    = STB_STATUS_CALCULATING;        }//during stabilization
+            if        ( acc->gazLRCnt    == 0        )        {    peRes->peFace[k].gaz.status    = STB_STATUS_NO_DATA    ;        }//stabilization impossible
+            else                                        {    peRes->peFace[k].gaz.status    = STB_STATUS_CALCULATING;        }//during stabilization
             peRes->peFace[k].gaz.conf    =  STB_CONF_NO_DATA;//no Confidence
-            tmpVal = 0;
-            for( i = 0; i < recCnt    ; i++            )        {     tmpVal        += recVal[ i ]    ;    }
-            if ( recCnt == 0                        )        {    recCnt        =  1            ;    }
-            peRes->peFace[k].gaz.LR    = tmpVal / recCnt;
-            // gazeUD                -------------------------------------------------------------------------------------------------
-            recCnt = 0;
-            for( t = 0; t < STB_PE_BACK_MAX    ; t++) 
-            { 
-            for( i = 0; i < peRec[t].num    ; i++) //a number of tracking people(previous t frame)
-            { 
-                if(    
-                            peRec[t].fcDet[i].nTraID        ==  trID        //the same tracking number
-                        &&    peRec[t].fcDet[i].nDetID        >=    0            //not lost
-                        &&    peRec[t].fcDet[i].dirDetConf    >=    dirThr        // Face angle : confidence
-                        &&    peRec[t].fcDet[i].dirDetPitch    >=    dirUDMin     // Face angle : pitch
-                        &&    peRec[t].fcDet[i].dirDetPitch    <=    dirUDMax    // Face angle : pitch
-                        &&    peRec[t].fcDet[i].dirDetYaw        >=    dirLRMin     // Face angle : yaw
-                        &&    peRec[t].fcDet[i].dirDetYaw        <=    dirLRMax    // Face angle : yaw
-                        &&    peRec[t].fcDet[i].gazDetUD        !=    STB_ERR_PE_CANNOT    // 
-                    )
-                {
-                    recVal[ recCnt ] = peRec[ t ].fcDet [ i ].gazDetUD    ;
-                    recCnt++;
-                }
-            }
-            }
-            tmpVal = 0;
-            for( i = 0; i < recCnt    ; i++            )        {     tmpVal        += recVal[ i ]    ;    }
-            if ( recCnt == 0                        )        {    recCnt        =  1            ;    }
-            peRes->peFace[k].gaz.UD    = tmpVal / recCnt;
+            peRes->peFace[k].gaz.LR        = acc->gazLR / ( acc->gazLRCnt == 0 ? 1 : acc->gazLRCnt );
+            peRes->peFace[k].gaz.UD        = acc->gazUD / ( acc->gazUDCnt == 0 ? 1 : acc->gazUDCnt );
         }
 
 
         // expression            -------------------------------------------------------------------------------------------------
         if( execFlg->exp == STB_TRUE )
         {
-            recCnt = 0;
-            for( t = 0; t < STB_PE_BACK_MAX    ; t++) 
-            { 
-            for( i = 0; i < peRec[t].num    ; i++) //a number of tracking people(previous t frame)
-            { 
-                if(    
-                            peRec[t].fcDet[i].nTraID        ==  trID        //the same tracking number
-                        &&    peRec[t].fcDet[i].nDetID        >=    0            //not lost
-                        &&    peRec[t].fcDet[i].dirDetConf    >=    dirThr        // Face angle : confidence
-                        &&    peRec[t].fcDet[i].dirDetPitch    >=    dirUDMin     // Face angle : pitch
-                        &&    peRec[t].fcDet[i].dirDetPitch    <=    dirUDMax    // Face angle : pitch
-                        &&    peRec[t].fcDet[i].dirDetYaw        >=    dirLRMin     // Face angle : yaw
-                        &&    peRec[t].fcDet[i].dirDetYaw        <=    dirLRMax    // Face angle : yaw
-                        &&    peRec[t].fcDet[i].expDetConf    !=    STB_ERR_PE_CANNOT    // 
-                    )
-                {
-                    recVal[ recCnt ] = PeExpressID (  peRec[ t ].fcDet[i].expDetVal );
-                    recCnt++;
-                }
-            }
-            }
-            for( i = 0; i < STB_EX_MAX; i++            )        {     expVal[ i ]                =  0        ;    }
-            for( i = 0; i < recCnt    ; i++            )        {     expVal[ recVal[ i ] ]    += 1        ;    }
-            peRes->peFace[k].exp.value    =  PeExpressID ( expVal );
+            peRes->peFace[k].exp.value    =  PeExpressID ( acc->expVal );
             peRes->peFace[k].exp.conf    =  STB_CONF_NO_DATA;//no Confidence
-            if        ( recCnt     == 0                )        {    peRes->peFace[k].exp.status    = STB_STATUS_NO_DATA    ;        }//stabilization impossible
-            else                                            {    peRes->peFace[k].exp.status    = STB_STATUS_CALCULATING;        }//during stabilization
+            if        ( acc->expCnt    == 0        )        {    peRes->peFace[k].exp.status    = STB_STATUS_NO_DATA    ;        }//stabilization impossible
+            else                                        {    peRes->peFace[k].exp.status    = STB_STATUS_CALCULATING;        }//during stabilization
         }
 
-        // blink L                -------------------------------------------------------------------------------------------------
+        // blink                -------------------------------------------------------------------------------------------------
         if( execFlg->bli == STB_TRUE )
         {
-            recCnt = 0;
-            for( t = 0; t < STB_PE_BACK_MAX    ; t++) 
-            { 
-            for( i = 0; i < peRec[t].num    ; i++) //a number of tracking people(previous t frame)
-            { 
-                if(    
-                            peRec[t].fcDet[i].nTraID        ==  trID        //the same tracking number
-                        &&    peRec[t].fcDet[i].nDetID        >=    0            //not lost
-                        &&    peRec[t].fcDet[i].dirDetConf    >=    dirThr        // Face angle : confidence
-                        &&    peRec[t].fcDet[i].dirDetPitch    >=    dirUDMin     // Face angle : pitch
-                        &&    peRec[t].fcDet[i].dirDetPitch    <=    dirUDMax    // Face angle : pitch
-                        &&    peRec[t].fcDet[i].dirDetYaw        >=    dirLRMin     // Face angle : yaw
-                        &&    peRec[t].fcDet[i].dirDetYaw        <=    dirLRMax    // Face angle : yaw
-                        &&    peRec[t].fcDet[i].bliDetL        !=    STB_ERR_PE_CANNOT    //
-                    )
-                {
-                    recVal[ recCnt ] = peRec[ t ].fcDet[ i ].bliDetL    ;
-                    recCnt++;
-                }
-            }
-            }
-            if        ( recCnt     == 0                )        {    peRes->peFace[k].bli.status    = STB_STATUS_NO_DATA    ;        }//stabilization impossible
-            else                                            {    peRes->peFace[k].bli.status    = STB_STATUS_CALCULATING;        }//during stabilization
-            tmpVal = 0;
-            for( i = 0; i < recCnt    ; i++            )        {     tmpVal        += recVal[ i ]    ;    }
-            if ( recCnt == 0                        )        {    recCnt        =  1            ;    }
-            peRes->peFace[k].bli.ratioL    = tmpVal / recCnt;
-            // blink R                -------------------------------------------------------------------------------------------------
-            recCnt = 0;
-            for( t = 0; t < STB_PE_BACK_MAX    ; t++) 
-            { 
-            for( i = 0; i < peRec[t].num    ; i++) //a number of tracking people(previous t frame)
-            { 
-                if(    
-                            peRec[t].fcDet[i].nTraID        ==  trID        //the same tracking number
-                        &&    peRec[t].fcDet[i].nDetID        >=    0            //not lost
-                        &&    peRec[t].fcDet[i].dirDetConf    >=    dirThr        // Face angle : confidence
-                        &&    peRec[t].fcDet[i].dirDetPitch    >=    dirUDMin     // Face angle : pitch
-                        &&    peRec[t].fcDet[i].dirDetPitch    <=    dirUDMax    // Face angle : pitch
-                        &&    peRec[t].fcDet[i].dirDetYaw        >=    dirLRMin     // Face angle : yaw
-                        &&    peRec[t].fcDet[i].dirDetYaw        <=    dirLRMax    // Face angle : yaw
-                        &&    peRec[t].fcDet[i].bliDetR        !=    STB_ERR_PE_CANNOT    //
-                    )
-                {
-                    recVal[ recCnt ] = peRec[ t ].fcDet [ i ].bliDetR;
-                    recCnt++;
-                }
-            }
-            }
-            tmpVal = 0;
-            for( i = 0; i < recCnt    ; i++            )        {     tmpVal        += recVal[ i ]    ;    }
-            if ( recCnt == 0                        )        {    recCnt        =  1            ;    }
-            peRes->peFace[k].bli.ratioR    = tmpVal / recCnt;
+            if        ( acc->bliLCnt    == 0        )        {    peRes->peFace[k].bli.status    = STB_STATUS_NO_DATA    ;        }//stabilization impossible
+            else                                        {    peRes->peFace[k].bli.status    = STB_STATUS_CALCULATING;        }//during stabilization
+            peRes->peFace[k].bli.ratioL    = acc->bliL / ( acc->bliLCnt == 0 ? 1 : acc->bliLCnt );
+            peRes->peFace[k].bli.ratioR    = acc->bliR / ( acc->bliRCnt == 0 ? 1 : acc->bliRCnt );
         }
 
 
 
-        // dirYaw                -------------------------------------------------------------------------------------------------
+        // direction            -------------------------------------------------------------------------------------------------
         if( execFlg->dir == STB_TRUE )
         {
-            recCnt = 0;
-            for( t = 0; t < STB_PE_BACK_MAX    ; t++) 
-            { 
-            for( i = 0; i < peRec[t].num    ; i++) //a number of tracking people(previous t frame)
-            { 
-                if(    
-                            peRec[t].fcDet[i].nTraID        ==  trID        //the same tracking number
-                        &&    peRec[t].fcDet[i].nDetID        >=    0            //not lost
-                        &&    peRec[t].fcDet[i].dirDetConf    >=    dirThr        // Face angle : confidence
-                        &&    peRec[t].fcDet[i].dirDetPitch    >=    dirUDMin     // Face angle : pitch
-                        &&    peRec[t].fcDet[i].dirDetPitch    <=    dirUDMax    // Face angle : pitch
-                        &&    peRec[t].fcDet[i].dirDetYaw        >=    dirLRMin     // Face angle : yaw
-                        &&    peRec[t].fcDet[i].dirDetYaw        <=    dirLRMax    // Face angle : yaw
-                    )
-                {
-                    recVal[ recCnt ] = peRec[ t ].fcDet [ i ].dirDetYaw    ;
-                    recCnt++;
-                }
-            }
-            }
-            if        ( recCnt     == 0                )        {    peRes->peFace[k].dir.status    = STB_STATUS_NO_DATA    ;        }//stabilization impossible
-            else                                            {    peRes->peFace[k].dir.status    = STB_STATUS_CALCULATING;        }//during stabilization
+            if        ( acc->dirCnt    == 0        )        {    peRes->peFace[k].dir.status    = STB_STATUS_NO_DATA    ;        }//stabilization impossible
+            else                                        {    peRes->peFace[k].dir.status    = STB_STATUS_CALCULATING;        }//during stabilization
             peRes->peFace[k].dir.conf    =  STB_CONF_NO_DATA;//no Confidence
-            tmpVal = 0;
-            for( i = 0; i < recCnt    ; i++            )        {     tmpVal        += recVal[ i ]    ;    }
-            if ( recCnt == 0                        )        {    recCnt        =  1            ;    }
-            peRes->peFace[k].dir.yaw    = tmpVal / recCnt;
-            // dirRoll                -------------------------------------------------------------------------------------------------
-            recCnt = 0;
-            for( t = 0; t < STB_PE_BACK_MAX    ; t++) 
-            { 
-            for( i = 0; i < peRec[t].num    ; i++) //a number of tracking people(previous t frame)
-            { 
-                if(    
-                            peRec[t].fcDet[i].nTraID        ==  trID        //the same tracking number
-                        &&    peRec[t].fcDet[i].nDetID        >=    0            //not lost
-                        &&    peRec[t].fcDet[i].dirDetConf    >=    dirThr        // Face angle : confidence
-                        &&    peRec[t].fcDet[i].dirDetPitch    >=    dirUDMin     // Face angle : pitch
-                        &&    peRec[t].fcDet[i].dirDetPitch    <=    dirUDMax    // Face angle : pitch
-                        &&    peRec[t].fcDet[i].dirDetYaw        >=    dirLRMin     // Face angle : yaw
-                        &&    peRec[t].fcDet[i].dirDetYaw        <=    dirLRMax    // Face angle : yaw
-                    )
-                {
-                    recVal[ recCnt ] = peRec[ t ].fcDet [ i ].dirDetRoll;
-                    recCnt++;
-                }
-            }
-            }
-            tmpVal = 0;
-            for( i = 0; i < recCnt    ; i++            )        {     tmpVal        += recVal[ i ]    ;    }
-            if ( recCnt == 0                        )        {    recCnt        =  1            ;    }
-            peRes->peFace[k].dir.roll    = tmpVal / recCnt;
-            // dirPitch                -------------------------------------------------------------------------------------------------
-            recCnt = 0;
-            for( t = 0; t < STB_PE_BACK_MAX    ; t++) 
-            { 
-            for( i = 0; i < peRec[t].num    ; i++) //a number of tracking people(previous t frame)
-            { 
-                if(    
-                            peRec[t].fcDet[i].nTraID        ==  trID        //the same tracking number
-                        &&    peRec[t].fcDet[i].nDetID        >=    0            //not lost
-                        &&    peRec[t].fcDet[i].dirDetConf    >=    dirThr        // Face angle : confidence
-                        &&    peRec[t].fcDet[i].dirDetPitch    >=    dirUDMin     // Face angle : pitch
-                        &&    peRec[t].fcDet[i].dirDetPitch    <=    dirUDMax    // Face angle : pitch
-                        &&    peRec[t].fcDet[i].dirDetYaw        >=    dirLRMin     // Face angle : yaw
-                        &&    peRec[t].fcDet[i].dirDetYaw        <=    dirLRMax    // Face angle : yaw
-                    )
-                {
-                    recVal[ recCnt ] = peRec[ t ].fcDet [ i ].dirDetPitch    ;
-                    recCnt++;
-                }
-            }
-            }
-            tmpVal = 0;
-            for( i = 0; i < recCnt    ; i++            )        {     tmpVal        += recVal[ i ]    ;    }
-            if ( recCnt == 0                        )        {    recCnt        =  1            ;    }
-            peRes->peFace[k].dir.pitch    = tmpVal / recCnt;
+            recCnt = ( acc->dirCnt == 0 ? 1 : acc->dirCnt );
+            peRes->peFace[k].dir.yaw    = acc->dirYaw    / recCnt;
+            peRes->peFace[k].dir.roll    = acc->dirRoll    / recCnt;
+            peRes->peFace[k].dir.pitch    = acc->dirPitch    / recCnt;
         }
 
     }//for( k = 0; k < peRes->peCnt ; k++) 
@@ -621,19 +518,12 @@ int  StbPeExec ( PEHANDLE handle )
     int retVal = 0 ;
 
     /* Face --------------------------------------*/
-    PeSlideFacesRec    (     handle->peDetRec        ,
-                          handle->execFlg            );//Shift the time series of past data before stabilization.
-    PeCurFaces        (     handle->peDetRec        ,
-                        &(handle->peDet)        ,    
-                          handle->execFlg            );//Setting "present data before the stabilization" to past data before the stabilization.
+    PeSetTrackRec    (     handle                    );//Setting "present data before the stabilization" to past data before the stabilization.
 
     PeStbFaceEasy        (   &(handle->peRes)        ,      
-                        handle->peDetRec        ,
-                        handle->peFaceDirThr    ,
-                        handle->peFaceDirUDMax    ,
-                        handle->peFaceDirUDMin    ,
-                        handle->peFaceDirLRMax    ,
-                        handle->peFaceDirLRMin    ,
+                        &(handle->peDet)        ,
+                        handle->peTrack            ,
+                        handle->peSlot            ,
                         handle->peFrameCount    ,
                         handle->execFlg            );//Calculate "current data after stabilization" from "past data before stabilization".
 
@@ -20,8 +20,16 @@
 /*This layer only defines the API function */
 
 /*Create/Delete handle*/
-STB_PE_HANDLE STB_Pe_CreateHandle(  const STBExecFlg* execFlg ,const STB_INT32 nTraCntMax  ){
-    return (STB_PE_HANDLE)PeCreateHandle(   execFlg , nTraCntMax );
+STB_PE_HANDLE STB_Pe_CreateHandle(  const STBExecFlg* execFlg ,const STB_INT32 nTraCntMax , const STB_INT32 nBackMax ){
+    return (STB_PE_HANDLE)PeCreateHandle(   execFlg , nTraCntMax , nBackMax );
+}
+
+STB_UINT32 STB_Pe_GetRequiredMemorySize(  const STBExecFlg* execFlg ,const STB_INT32 nTraCntMax , const STB_INT32 nBackMax ){
+    return PeGetRequiredMemorySize(   execFlg , nTraCntMax , nBackMax );
+}
+
+STB_PE_HANDLE STB_Pe_CreateHandleInPlace( VOID* pMem , const STB_UINT32 nMemSize , const STBExecFlg* execFlg ,const STB_INT32 nTraCntMax , const STB_INT32 nBackMax ){
+    return (STB_PE_HANDLE)PeCreateHandleInPlace( (STB_INT8*)pMem , nMemSize , execFlg , nTraCntMax , nBackMax );
 }
 
 STB_INT32 STB_Pe_DeleteHandle(STB_PE_HANDLE handle){
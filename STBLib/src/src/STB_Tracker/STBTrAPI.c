@@ -21,24 +21,10 @@
 /*---------------------------------------------------------------------*/
 //    TrSlideRec
 /*---------------------------------------------------------------------*/
-void TrSlideRec ( ROI_SYS *rec )
+void TrSlideRec ( STB_INT32 *recTop )
 {
-    STB_INT32 t , i ;
-
-    for( t = STB_TR_BACK_MAX  - 2 ; t >= 0 ;  t-- ) 
-    {
-        rec [ t + 1 ].cnt = rec[ t + 0 ].cnt;
-        for( i = 0 ; i < rec [ t + 1 ].cnt ;  i++ ) 
-        {
-            rec [ t + 1 ].nDetID    [i]    = rec [ t ].nDetID    [i] ;
-            rec [ t + 1 ].nTraID    [i]    = rec [ t ].nTraID    [i] ;
-            rec [ t + 1 ].posX        [i]    = rec [ t ].posX    [i] ;
-            rec [ t + 1 ].posY        [i]    = rec [ t ].posY    [i] ;
-            rec [ t + 1 ].size        [i]    = rec [ t ].size    [i]  ;
-            rec [ t + 1 ].conf        [i]    = rec [ t ].conf    [i]  ;
-            rec [ t + 1 ].retryN    [i]    = rec [ t ].retryN    [i]  ;
-        }
-    }
+    //The oldest data becomes the area of the current data, so that the past data is not copied.
+    *recTop = ( *recTop + STB_TR_BACK_MAX - 1 ) % STB_TR_BACK_MAX;
 }
 /*---------------------------------------------------------------------*/
 //    TrCurRec
@@ -58,16 +44,28 @@ void TrCurRec ( ROI_SYS *rec , ROI_DET *det , STB_INT32 num)
         rec [ 0 ].size        [i]    = det[i].size        ;
         rec [ 0 ].conf        [i]    = det[i].conf        ;
         rec [ 0 ].retryN    [i]    = 0                    ;
+        rec [ 0 ].velX        [i]    = 0                    ;
+        rec [ 0 ].velY        [i]    = 0                    ;
     }
 
 }
 
 
+/*---------------------------------------------------------------------*/
+//    TrAddEvent
+/*---------------------------------------------------------------------*/
+void
+TrAddEvent( STB_TR_EVENTS *events , STB_INT32 type , STB_INT32 nTraID )
+{
+    events->event[ events->cnt ].type    = type    ;
+    events->event[ events->cnt ].nTraID    = nTraID;
+    events->cnt++;
+}
 /*---------------------------------------------------------------------*/
 //    TrDelRetry
 /*---------------------------------------------------------------------*/
 void
-TrDelRetry( ROI_SYS *preData , STB_INT32 thrRetryCnt )
+TrDelRetry( ROI_SYS *preData , STB_INT32 thrRetryCnt , STB_TR_EVENTS *events )
 {
     //delete data exceeding the number of retries
     //If the face isn't find out during tracking, set until how many frames can look for it.
@@ -87,12 +85,104 @@ TrDelRetry( ROI_SYS *preData , STB_INT32 thrRetryCnt )
             preData->size        [tmpCnt    ]    = preData->size        [i]    ;
             preData->conf        [tmpCnt    ]    = preData->conf        [i]    ;
             preData->retryN        [tmpCnt    ]    = preData->retryN    [i]    ;
+            preData->velX        [tmpCnt    ]    = preData->velX        [i]    ;
+            preData->velY        [tmpCnt    ]    = preData->velY        [i]    ;
             tmpCnt++;
+        }else
+        {
+            TrAddEvent( events , STB_EVENT_EXIT , preData->nTraID[i] );//end of tracking
         }
     }
     preData->cnt    = tmpCnt    ;
 
 
+}
+/*---------------------------------------------------------------------*/
+//    TrPredictPos
+/*---------------------------------------------------------------------*/
+void
+TrPredictPos( ROI_SYS *preData )
+{
+    //Move the previous data by the velocity (constant-velocity model).
+    //The velocity is 1/100 pixel per frame, so it is rounded to the nearest pixel.
+    //A coasting track stops at the edge of the image instead of drifting out of the detectable range.
+    STB_INT32    i    ;
+
+    for( i = 0 ; i < preData->cnt ;  i++ ) 
+    {
+        preData->posX[i] += ( preData->velX[i] >= 0 ) ? ( ( preData->velX[i] + 50 ) / 100 ) : -( ( 50 - preData->velX[i] ) / 100 );
+        preData->posY[i] += ( preData->velY[i] >= 0 ) ? ( ( preData->velY[i] + 50 ) / 100 ) : -( ( 50 - preData->velY[i] ) / 100 );
+        if( preData->posX[i] < STB_TR_XY_MIN ){ preData->posX[i] = STB_TR_XY_MIN; }
+        if( preData->posX[i] > STB_TR_XY_MAX ){ preData->posX[i] = STB_TR_XY_MAX; }
+        if( preData->posY[i] < STB_TR_XY_MIN ){ preData->posY[i] = STB_TR_XY_MIN; }
+        if( preData->posY[i] > STB_TR_XY_MAX ){ preData->posY[i] = STB_TR_XY_MAX; }
+    }
+}
+/*---------------------------------------------------------------------*/
+//    TrUpdateVel
+/*---------------------------------------------------------------------*/
+STB_INT32
+TrUpdateVel( STB_INT32 preVel , STB_INT32 curPos , STB_INT32 prePos , STB_INT32 preSize , STB_INT32 motionGain )
+{
+    //Correct the velocity by "motionGain %" of the difference between the detected position and the predicted position.
+    //The velocity is limited to the size per frame, so that a wrong association doesn't throw the track away.
+    STB_INT32    retVal    ;
+    STB_INT32    tmpMax    ;
+
+    retVal = preVel + motionGain * ( curPos - prePos );
+    tmpMax = preSize * 100;
+    if( retVal > tmpMax )
+    {
+        retVal = tmpMax;
+    }
+    if( retVal < -tmpMax )
+    {
+        retVal = -tmpMax;
+    }
+    return retVal;
+}
+/*---------------------------------------------------------------------*/
+//    TrSqrtInt
+/*---------------------------------------------------------------------*/
+STB_UINT32
+TrSqrtInt( STB_UINT64 val )
+{
+    //Square root rounded down. The result is exact and does not depend on the floating point unit.
+    STB_UINT64    retVal    ;
+#if defined( STB_TR_INTEGER_SQRT )
+    //Calculated in integer only, one bit at a time.
+    STB_UINT64    bit        ;
+    STB_UINT64    tmpVal    ;
+    STB_UINT64    mask    ;
+
+    retVal    = 0;
+    bit        = (STB_UINT64)1 << 62;
+    while( bit > val )
+    {
+        bit >>= 2;
+    }
+    while( bit != 0 )
+    {
+        tmpVal    = retVal + bit;
+        mask    = (STB_UINT64)0 - (STB_UINT64)( val >= tmpVal );//all bits are 1 when the bit is taken
+        val        -= tmpVal & mask;
+        retVal    = ( retVal >> 1 ) + ( bit & mask );
+        bit        >>= 2;
+    }
+#else
+    //The estimate by floating point is corrected in integer.
+    retVal = (STB_UINT64)sqrt( (double)val );
+    while( retVal * retVal > val )
+    {
+        retVal--;
+    }
+    while( ( retVal + 1 ) * ( retVal + 1 ) <= val )
+    {
+        retVal++;
+    }
+#endif
+
+    return (STB_UINT32)retVal;
 }
 /*---------------------------------------------------------------------*/
 //    TrCheckSameROI
@@ -105,7 +195,7 @@ TrCheckSameROI(    STB_INT32 curX        ,STB_INT32 curY        ,STB_INT32 curS
 
     STB_INT32 difP    ;//the percentage of detection position change
     STB_INT32 difS    ;//the percentage of detection size change
-    float tmpVal;
+    STB_INT32 tmpX , tmpY , tmpS;
     STB_INT32 retVal;
 
     if( preS < 1 )
@@ -115,20 +205,220 @@ TrCheckSameROI(    STB_INT32 curX        ,STB_INT32 curY        ,STB_INT32 curS
 
     //the percentage of detect position change
     //It is "Absolute value of detected position change amount from previous frame / Detected size of previous frame * 100".
-    tmpVal = (float)sqrt( (float) (preX-curX)*(preX-curX) + (preY-curY)*(preY-curY) );
-    difP   = (STB_INT32)( tmpVal * 100 / preS );
+    //"Absolute value * 100" is calculated as sqrt( square of the change amount * 100 * 100 ) in integer.
+    tmpX   = preX - curX;
+    tmpY   = preY - curY;
+    difP   = (STB_INT32)( TrSqrtInt( ( (STB_UINT64)( (STB_INT64)tmpX * tmpX ) + (STB_UINT64)( (STB_INT64)tmpY * tmpY ) ) * 10000 ) / (STB_UINT32)preS );
     //the percentage of detect size change
     //It is "Absolute value of detected size change amount from previous frame / Detected size of previous frame * 100".
-    tmpVal =  (float)(preS-curS);
-    if( tmpVal < 0 )
+    tmpS   = preS - curS;
+    if( tmpS < 0 )
     {
-        tmpVal *= (-1);
+        tmpS *= (-1);
     }
-    difS   = (STB_INT32)( tmpVal * 100 / preS );
+    difS   = tmpS * 100 / preS;
     retVal = (difP+1)*(difS+1);
 
     return retVal;//The return value is the similarity of the rectangle. Always a value more than or equal to zero. The closer to zero, the more similar they are.
 
+}
+/*---------------------------------------------------------------------*/
+//    TrCheckSameROIRowC
+/*---------------------------------------------------------------------*/
+void
+TrCheckSameROIRowC
+    (
+        STB_INT32    *dstRow        ,    //dstTbl [ ip * traCntMax ] (the row of the previous data)
+        ROI_SYS        *curData    ,
+        STB_INT32    icTop        ,    //the current data from icTop to icEnd-1 are set
+        STB_INT32    icEnd        ,
+        STB_INT32    preX        ,STB_INT32 preY        ,STB_INT32 preS
+    )
+{
+    //Same as TrCheckSameROI for the current data. preS is 1 or more.
+    STB_INT32    ic        ;
+    STB_INT32    *curX    = curData->posX    ;
+    STB_INT32    *curY    = curData->posY    ;
+    STB_INT32    *curS    = curData->size    ;
+    STB_INT32    difP    ;
+    STB_INT32    difS    ;
+    STB_INT32    tmpX , tmpY , tmpS;
+
+    for( ic = icTop ; ic < icEnd ;  ic++ )        
+    {
+        tmpX    = preX - curX[ic];
+        tmpY    = preY - curY[ic];
+        tmpS    = preS - curS[ic];
+        if( tmpS < 0 )
+        {
+            tmpS *= (-1);
+        }
+        difP    = (STB_INT32)( TrSqrtInt( ( (STB_UINT64)( (STB_INT64)tmpX * tmpX ) + (STB_UINT64)( (STB_INT64)tmpY * tmpY ) ) * 10000 ) / (STB_UINT32)preS );
+        difS    = tmpS * 100 / preS;
+        dstRow[ic] = (difP+1)*(difS+1);
+    }
+}
+#if defined( STB_TR_SIMD_X86 )
+/*---------------------------------------------------------------------*/
+//    Row kernels by SSE2/AVX2
+/*---------------------------------------------------------------------*/
+//The differences are at most STB_TR_SIMD_DIF_MAX, so that "square of the change amount * 100 * 100" (< 2^53)
+//and all the other values are exact in double. The square root and the divisions rounded down are then the same as in integer.
+//Four current data whose difference is over it (not the case of the valid input) are calculated by TrCheckSameROIRowC.
+#define STB_TR_SIMD_DIF_MAX        ( 1 << 19 )
+
+static __m128i
+TrSimdOutOfRange( __m128i tmpX , __m128i tmpY , __m128i tmpS )
+{
+    //All bits of a lane are 1 if one of its differences is out of the range.
+    const __m128i    difMax    = _mm_set1_epi32(  STB_TR_SIMD_DIF_MAX );
+    const __m128i    difMin    = _mm_set1_epi32( -STB_TR_SIMD_DIF_MAX );
+    __m128i            retVal    ;
+
+    retVal    = _mm_or_si128( _mm_cmpgt_epi32( tmpX , difMax ) , _mm_cmplt_epi32( tmpX , difMin ) );
+    retVal    = _mm_or_si128( retVal , _mm_or_si128( _mm_cmpgt_epi32( tmpY , difMax ) , _mm_cmplt_epi32( tmpY , difMin ) ) );
+    retVal    = _mm_or_si128( retVal , _mm_or_si128( _mm_cmpgt_epi32( tmpS , difMax ) , _mm_cmplt_epi32( tmpS , difMin ) ) );
+    return retVal;
+}
+static __m128d
+TrSimdDifP2( __m128d dX , __m128d dY , __m128d dPreS )
+{
+    //"sqrt( square of the change amount * 100 * 100 ) / preS" rounded down, for two current data.
+    const __m128d    one        = _mm_set1_pd( 1.0 );
+    __m128d            val , rt , rt1;
+
+    val    = _mm_mul_pd( _mm_add_pd( _mm_mul_pd( dX , dX ) , _mm_mul_pd( dY , dY ) ) , _mm_set1_pd( 10000.0 ) );
+    rt    = _mm_cvtepi32_pd( _mm_cvttpd_epi32( _mm_sqrt_pd( val ) ) );
+    rt    = _mm_sub_pd( rt , _mm_and_pd( _mm_cmpgt_pd( _mm_mul_pd( rt , rt ) , val ) , one ) );
+    rt1    = _mm_add_pd( rt , one );
+    rt    = _mm_add_pd( rt , _mm_and_pd( _mm_cmple_pd( _mm_mul_pd( rt1 , rt1 ) , val ) , one ) );
+    return _mm_cvtepi32_pd( _mm_cvttpd_epi32( _mm_div_pd( rt , dPreS ) ) );
+}
+static void
+TrCheckSameROIRowSSE2
+    (
+        STB_INT32    *dstRow        ,
+        ROI_SYS        *curData    ,
+        STB_INT32    preX        ,STB_INT32 preY        ,STB_INT32 preS
+    )
+{
+    STB_INT32    ic        ;
+    STB_INT32    curCnt    = curData->cnt    ;
+    __m128i        vPreX    = _mm_set1_epi32( preX );
+    __m128i        vPreY    = _mm_set1_epi32( preY );
+    __m128i        vPreS    = _mm_set1_epi32( preS );
+    __m128d        dPreS    = _mm_set1_pd( (double)preS );
+    __m128d        dHundred= _mm_set1_pd( 100.0 );
+    __m128i        tmpX , tmpY , tmpS , sign , difP , difS , prdL , prdH;
+
+    for( ic = 0 ; ic + 4 <= curCnt ;  ic += 4 )        
+    {
+        tmpX    = _mm_sub_epi32( vPreX , _mm_loadu_si128( (const __m128i*)&curData->posX[ic] ) );
+        tmpY    = _mm_sub_epi32( vPreY , _mm_loadu_si128( (const __m128i*)&curData->posY[ic] ) );
+        tmpS    = _mm_sub_epi32( vPreS , _mm_loadu_si128( (const __m128i*)&curData->size[ic] ) );
+        if( _mm_movemask_epi8( TrSimdOutOfRange( tmpX , tmpY , tmpS ) ) != 0 )
+        {
+            TrCheckSameROIRowC( dstRow , curData , ic , ic + 4 , preX , preY , preS );
+            continue;
+        }
+        sign    = _mm_srai_epi32( tmpS , 31 );
+        tmpS    = _mm_sub_epi32( _mm_xor_si128( tmpS , sign ) , sign );
+        difP    = _mm_unpacklo_epi64(
+                    _mm_cvttpd_epi32( TrSimdDifP2( _mm_cvtepi32_pd( tmpX ) , _mm_cvtepi32_pd( tmpY ) , dPreS ) ) ,
+                    _mm_cvttpd_epi32( TrSimdDifP2( _mm_cvtepi32_pd( _mm_srli_si128( tmpX , 8 ) ) , _mm_cvtepi32_pd( _mm_srli_si128( tmpY , 8 ) ) , dPreS ) ) );
+        difS    = _mm_unpacklo_epi64(
+                    _mm_cvttpd_epi32( _mm_div_pd( _mm_mul_pd( _mm_cvtepi32_pd( tmpS ) , dHundred ) , dPreS ) ) ,
+                    _mm_cvttpd_epi32( _mm_div_pd( _mm_mul_pd( _mm_cvtepi32_pd( _mm_srli_si128( tmpS , 8 ) ) , dHundred ) , dPreS ) ) );
+        difP    = _mm_add_epi32( difP , _mm_set1_epi32( 1 ) );
+        difS    = _mm_add_epi32( difS , _mm_set1_epi32( 1 ) );
+        //(difP+1)*(difS+1) in 32 bits : SSE2 multiplies the even and the odd lanes separately.
+        prdL    = _mm_mul_epu32( difP , difS );
+        prdH    = _mm_mul_epu32( _mm_srli_epi64( difP , 32 ) , _mm_srli_epi64( difS , 32 ) );
+        _mm_storeu_si128( (__m128i*)&dstRow[ic] , _mm_unpacklo_epi32( _mm_shuffle_epi32( prdL , _MM_SHUFFLE( 0 , 0 , 2 , 0 ) ) ,
+                                                                      _mm_shuffle_epi32( prdH , _MM_SHUFFLE( 0 , 0 , 2 , 0 ) ) ) );
+    }
+    TrCheckSameROIRowC( dstRow , curData , ic , curCnt , preX , preY , preS );
+}
+__attribute__(( target( "avx2" ) ))
+static void
+TrCheckSameROIRowAVX2
+    (
+        STB_INT32    *dstRow        ,
+        ROI_SYS        *curData    ,
+        STB_INT32    preX        ,STB_INT32 preY        ,STB_INT32 preS
+    )
+{
+    STB_INT32    ic        ;
+    STB_INT32    curCnt    = curData->cnt    ;
+    const __m256d    one        = _mm256_set1_pd( 1.0 );
+    __m128i        vPreX    = _mm_set1_epi32( preX );
+    __m128i        vPreY    = _mm_set1_epi32( preY );
+    __m128i        vPreS    = _mm_set1_epi32( preS );
+    __m256d        dPreS    = _mm256_set1_pd( (double)preS );
+    __m128i        tmpX , tmpY , tmpS , difP , difS;
+    __m256d        dX , dY , val , rt , rt1;
+
+    for( ic = 0 ; ic + 4 <= curCnt ;  ic += 4 )        
+    {
+        tmpX    = _mm_sub_epi32( vPreX , _mm_loadu_si128( (const __m128i*)&curData->posX[ic] ) );
+        tmpY    = _mm_sub_epi32( vPreY , _mm_loadu_si128( (const __m128i*)&curData->posY[ic] ) );
+        tmpS    = _mm_sub_epi32( vPreS , _mm_loadu_si128( (const __m128i*)&curData->size[ic] ) );
+        if( _mm_movemask_epi8( TrSimdOutOfRange( tmpX , tmpY , tmpS ) ) != 0 )
+        {
+            TrCheckSameROIRowC( dstRow , curData , ic , ic + 4 , preX , preY , preS );
+            continue;
+        }
+        //Same as TrSimdDifP2 for four current data.
+        dX        = _mm256_cvtepi32_pd( tmpX );
+        dY        = _mm256_cvtepi32_pd( tmpY );
+        val        = _mm256_mul_pd( _mm256_add_pd( _mm256_mul_pd( dX , dX ) , _mm256_mul_pd( dY , dY ) ) , _mm256_set1_pd( 10000.0 ) );
+        rt        = _mm256_cvtepi32_pd( _mm256_cvttpd_epi32( _mm256_sqrt_pd( val ) ) );
+        rt        = _mm256_sub_pd( rt , _mm256_and_pd( _mm256_cmp_pd( _mm256_mul_pd( rt , rt ) , val , _CMP_GT_OQ ) , one ) );
+        rt1        = _mm256_add_pd( rt , one );
+        rt        = _mm256_add_pd( rt , _mm256_and_pd( _mm256_cmp_pd( _mm256_mul_pd( rt1 , rt1 ) , val , _CMP_LE_OQ ) , one ) );
+        difP    = _mm256_cvttpd_epi32( _mm256_div_pd( rt , dPreS ) );
+        difS    = _mm256_cvttpd_epi32( _mm256_div_pd( _mm256_mul_pd( _mm256_cvtepi32_pd( _mm_abs_epi32( tmpS ) ) , _mm256_set1_pd( 100.0 ) ) , dPreS ) );
+        _mm_storeu_si128( (__m128i*)&dstRow[ic] , _mm_mullo_epi32( _mm_add_epi32( difP , _mm_set1_epi32( 1 ) ) , _mm_add_epi32( difS , _mm_set1_epi32( 1 ) ) ) );
+    }
+    TrCheckSameROIRowC( dstRow , curData , ic , curCnt , preX , preY , preS );
+}
+#endif /* STB_TR_SIMD_X86 */
+/*---------------------------------------------------------------------*/
+//    TrCheckSameROIRow
+/*---------------------------------------------------------------------*/
+void
+TrCheckSameROIRow
+    (
+        STB_INT32    *dstRow        ,    //dstTbl [ ip * traCntMax ] (the row of the previous data)
+        ROI_SYS        *curData    ,
+        STB_INT32    preX        ,STB_INT32 preY        ,STB_INT32 preS
+    )
+{
+    //Same as TrCheckSameROI for all the current data.
+    STB_INT32    ic        ;
+    STB_INT32    curCnt    = curData->cnt    ;
+
+    if( preS < 1 )
+    {
+        for( ic = 0 ; ic < curCnt ;  ic++ )        
+        {
+            dstRow[ic] = STB_INT_MAX;
+        }
+        return;
+    }
+
+#if defined( STB_TR_SIMD_X86 )
+    //The results are the same as TrCheckSameROIRowC.
+    if( __builtin_cpu_supports( "avx2" ) )
+    {
+        TrCheckSameROIRowAVX2( dstRow , curData , preX , preY , preS );
+    }else
+    {
+        TrCheckSameROIRowSSE2( dstRow , curData , preX , preY , preS );
+    }
+#else
+    TrCheckSameROIRowC( dstRow , curData , 0 , curCnt , preX , preY , preS );
+#endif
 }
 /*---------------------------------------------------------------------*/
 //    TrSetDistTbl
@@ -142,31 +432,123 @@ TrSetDistTbl
         STB_INT32    traCntMax
     )
 {
-    STB_INT32    ip ,ic ;
-    STB_INT32    distMax = STB_INT_MAX;
+    STB_INT32    ip ;
 
-    // init
-    for( ip = 0 ; ip < traCntMax ;  ip++ ) 
+    //Only the area of preData->cnt x curData->cnt is set and referred.
+    for( ip = 0 ; ip < preData->cnt ;  ip++ )        
+    {
+        //The value is the similarity of the rectangle. Always a value more than or equal to zero. The closer to zero, the more similar they are.
+        TrCheckSameROIRow( &dst [ ip * traCntMax ] , curData , preData->posX[ip] , preData->posY[ip] , preData->size[ip] );
+    }
+
+}
+/*---------------------------------------------------------------------*/
+//    TrSetDistTblGrid
+/*---------------------------------------------------------------------*/
+void
+TrSetDistTblGrid
+    (
+        STB_INT32    *dst            ,    //distance table [ ip * traCntMax + ic ]
+        ROI_SYS        *curData        ,
+        ROI_SYS        *preData        ,
+        STB_INT32    traCntMax        ,
+        STB_INT32    thrRange        ,    //association range (percentage of the position change)
+        STB_INT32    fillAll            ,    //STB_TRUE : the pairs out of the range are also set (STB_INT_MAX)
+        STB_INT32    *candTop        ,    //[ curData->cnt + 1 ] : candidates of ic are candPre[ candTop[ic] ... candTop[ic+1]-1 ]
+        STB_INT32    *candPre        ,    //[ traCntMax * traCntMax ]
+        STB_INT32    *gridHead        ,    //[ traCntMax * 2 + 1 ]
+        STB_INT32    *gridNext        ,    //[ traCntMax ]
+        STB_INT32    *gridX            ,    //[ traCntMax ]
+        STB_INT32    *gridY                //[ traCntMax ]
+    )
+{
+    //Same as TrSetDistTbl, but only the pairs within the association range are set.
+    //The previous data is registered in a uniform grid whose cell is not smaller than the range,
+    //so that only the previous data in the 3x3 cells around the current data is evaluated.
+    STB_INT32    ip , ic , cnt ;
+    STB_INT32    cell , hashCnt , tmpVal ;
+    STB_INT32    cx , cy , gx , gy ;
+    STB_INT32    tmpX , tmpY ;
+    STB_UINT32    hash ;
+    STB_UINT64    tmpDst , tmpThr ;
+
+    //"position change <= thrRange %" is "distance * 100 < ( thrRange + 1 ) * previous size".
+    //The cell size is the largest "( thrRange + 1 ) * previous size / 100" (rounded up).
+    cell = 1;
+    for( ip = 0 ; ip < preData->cnt ;  ip++ )        
     {
-        for( ic = 0 ; ic < traCntMax ;  ic++ ) 
+        tmpVal = ( ( thrRange + 1 ) * preData->size[ip] + 99 ) / 100;
+        if( cell < tmpVal )
         {
-            dst [ ip * traCntMax + ic ] = distMax;
+            cell = tmpVal;
         }
     }
 
+    if( fillAll == STB_TRUE )
+    {
+        for( ip = 0 ; ip < preData->cnt ;  ip++ )        
+        {
+            for( ic = 0 ; ic < curData->cnt ;  ic++ )        
+            {
+                dst [ ip * traCntMax + ic ] = STB_INT_MAX;
+            }
+        }
+    }
 
-    for( ip = 0 ; ip < preData->cnt ;  ip++ )        
+    //Register the previous data in the grid (hashed by the cell).
+    hashCnt = preData->cnt * 2 + 1;
+    for( hash = 0 ; hash < (STB_UINT32)hashCnt ; hash++ )
+    {
+        gridHead[hash] = -1;
+    }
+    for( ip = preData->cnt - 1 ; ip >= 0 ;  ip-- )        
+    {
+        if( preData->size[ip] < 1 )
+        {
+            continue;//It is never associated.
+        }
+        gridX[ip]        = preData->posX[ip] / cell;
+        gridY[ip]        = preData->posY[ip] / cell;
+        hash            = ( (STB_UINT32)gridX[ip] * 73856093U ^ (STB_UINT32)gridY[ip] * 19349663U ) % (STB_UINT32)hashCnt;
+        gridNext[ip]    = gridHead[hash];
+        gridHead[hash]    = ip;
+    }
+
+    //Evaluate the previous data around each current data.
+    cnt = 0;
+    for( ic = 0 ; ic < curData->cnt ;  ic++ )        
     {
-        for( ic = 0 ; ic < curData->cnt ;  ic++ )        
+        candTop[ic] = cnt;
+        cx = curData->posX[ic] / cell;
+        cy = curData->posY[ic] / cell;
+        for( gy = cy - 1 ; gy <= cy + 1 ; gy++ )
         {
-            dst [ ip * traCntMax + ic ] 
-                = TrCheckSameROI//The return value is the similarity of the rectangle. Always a value more than or equal to zero. The closer to zero, the more similar they are.
-                    (
-                        curData->posX[ic],curData->posY[ic],curData->size[ic],
-                        preData->posX[ip],preData->posY[ip],preData->size[ip]
-                    );
+            for( gx = cx - 1 ; gx <= cx + 1 ; gx++ )
+            {
+                hash = ( (STB_UINT32)gx * 73856093U ^ (STB_UINT32)gy * 19349663U ) % (STB_UINT32)hashCnt;
+                for( ip = gridHead[hash] ; ip != -1 ; ip = gridNext[ip] )
+                {
+                    if( gridX[ip] != gx || gridY[ip] != gy )
+                    {
+                        continue;//another cell with the same hash
+                    }
+                    tmpX   = preData->posX[ip] - curData->posX[ic];
+                    tmpY   = preData->posY[ip] - curData->posY[ic];
+                    tmpDst = ( (STB_UINT64)( (STB_INT64)tmpX * tmpX ) + (STB_UINT64)( (STB_INT64)tmpY * tmpY ) ) * 10000;
+                    tmpThr = (STB_UINT64)( ( thrRange + 1 ) * preData->size[ip] );
+                    if( tmpDst >= tmpThr * tmpThr )
+                    {
+                        continue;//out of the range
+                    }
+                    dst [ ip * traCntMax + ic ] = TrCheckSameROI( curData->posX[ic] , curData->posY[ic] , curData->size[ic] ,
+                                                                  preData->posX[ip] , preData->posY[ip] , preData->size[ip] );
+                    candPre[cnt] = ip;
+                    cnt++;
+                }
+            }
         }
     }
+    candTop[ curData->cnt ] = cnt;
 
 }
 /*---------------------------------------------------------------------*/
@@ -182,9 +564,9 @@ TrSteadinessXYS
     )
 {
 
-    STB_INT32 difP    ;//the percentage of detection position change
-    STB_INT32 difS    ;//the percentage of detection size change
-    float tmpVal;
+    STB_INT32  tmpX , tmpY , tmpS;
+    STB_UINT64 tmpDst    ;
+    STB_UINT64 tmpThr    ;
 
 
     if( preS < 1 )
@@ -195,9 +577,13 @@ TrSteadinessXYS
 
     //the percentage of detect position change
     //It is "Absolute value of detected position change amount from previous frame / Detected size of previous frame * 100".
-    tmpVal = (float)sqrt( (float) (preX-curX)*(preX-curX) + (preY-curY)*(preY-curY) );
-    difP   = (STB_INT32)( tmpVal * 100 / preS );
-    if( difP <= thrP )
+    //"percentage <= thrP" is "Absolute value * 100 < ( thrP + 1 ) * Detected size", and it is compared in square.
+    tmpX   = preX - curX;
+    tmpY   = preY - curY;
+    tmpDst = ( (STB_UINT64)( (STB_INT64)tmpX * tmpX ) + (STB_UINT64)( (STB_INT64)tmpY * tmpY ) ) * 10000;
+    tmpThr = (STB_UINT64)( ( thrP + 1 ) * preS );
+    tmpThr = tmpThr * tmpThr;
+    if( tmpDst < tmpThr )
     {
         *dstX = preX    ;        *dstY = preY    ;
     }else
@@ -207,13 +593,13 @@ TrSteadinessXYS
 
     //the percentage of detect size change
     //It is "Absolute value of detected size change amount from previous frame / Detected size of previous frame * 100".
-    tmpVal =  (float)(preS-curS);
-    if( tmpVal < 0 )
+    //"percentage <= thrS" is "Absolute value * 100 < ( thrS + 1 ) * Detected size".
+    tmpS   = preS - curS;
+    if( tmpS < 0 )
     {
-        tmpVal *= (-1);
+        tmpS *= (-1);
     }
-    difS   = (STB_INT32)( tmpVal * 100 / preS );
-    if( difS <= thrS )
+    if( tmpS * 100 < ( thrS + 1 ) * preS )
     {
         *dstS = preS    ;
     }else
@@ -223,14 +609,364 @@ TrSteadinessXYS
 
 }
 /*---------------------------------------------------------------------*/
+//    TrSetMinDst
+/*---------------------------------------------------------------------*/
+void
+TrSetMinDst
+    (
+        STB_INT32    *dst            ,    //distance table [ ip * traCntMax + ic ]
+        STB_INT32    ic                ,
+        STB_INT32    preCnt            ,
+        STB_INT32    traCntMax        ,
+        STB_INT32    *idPreCur        ,
+        STB_INT32    *minDst            ,
+        STB_INT32    *minPre
+    )
+{
+    //Get the previous data that is not associated yet and minimizes the value of dstTbl.
+    //If the values are the same, the smaller previous data is taken.
+    STB_INT32    ip    ;
+
+    *minDst = STB_INT_MAX;    *minPre = -1;
+    for( ip = 0 ; ip < preCnt ;  ip++ )        
+    {
+        if( idPreCur[ip] == -1 && *minDst > dst [ ip * traCntMax + ic ] )
+        {
+            *minDst = dst [ ip * traCntMax + ic ] ;        *minPre = ip;
+        }
+    }
+}
+/*---------------------------------------------------------------------*/
+//    TrSetMinDstCand
+/*---------------------------------------------------------------------*/
+void
+TrSetMinDstCand
+    (
+        STB_INT32    *dst            ,    //distance table [ ip * traCntMax + ic ]
+        STB_INT32    ic                ,
+        STB_INT32    *candPre        ,    //candidates of ic
+        STB_INT32    candCnt            ,
+        STB_INT32    traCntMax        ,
+        STB_INT32    *idPreCur        ,
+        STB_INT32    *minDst            ,
+        STB_INT32    *minPre
+    )
+{
+    //Same as TrSetMinDst, but only the candidates of TrSetDistTblGrid are referred.
+    //The candidates are not sorted, so the smaller previous data is taken explicitly for the same value.
+    STB_INT32    k , ip , tmpVal ;
+
+    *minDst = STB_INT_MAX;    *minPre = -1;
+    for( k = 0 ; k < candCnt ;  k++ )        
+    {
+        ip = candPre[k];
+        if( idPreCur[ip] != -1 )
+        {
+            continue;
+        }
+        tmpVal = dst [ ip * traCntMax + ic ];
+        if( *minDst > tmpVal || ( *minDst == tmpVal && *minPre > ip ) )
+        {
+            *minDst = tmpVal ;        *minPre = ip;
+        }
+    }
+}
+/*---------------------------------------------------------------------*/
+//    TrDownDstHeap
+/*---------------------------------------------------------------------*/
+void
+TrDownDstHeap
+    (
+        STB_INT32    *dst            ,    //distance table [ ip * traCntMax + ic ]
+        STB_INT32    ic                ,
+        STB_INT32    *heap            ,    //previous data, the top is the one with the smallest ( dst , ip )
+        STB_INT32    heapCnt            ,
+        STB_INT32    idx                ,
+        STB_INT32    traCntMax
+    )
+{
+    //Move heap[idx] down to its place.
+    STB_INT32    ip , ipc , tmpVal , tmpValC , child ;
+
+    ip        = heap[idx];
+    tmpVal    = dst [ ip * traCntMax + ic ];
+    for( ;; )
+    {
+        child = idx * 2 + 1;
+        if( child >= heapCnt )
+        {
+            break;
+        }
+        if(        child + 1 < heapCnt 
+            &&    (        dst [ heap[child+1] * traCntMax + ic ] <  dst [ heap[child] * traCntMax + ic ]
+                    || (    dst [ heap[child+1] * traCntMax + ic ] == dst [ heap[child] * traCntMax + ic ] && heap[child+1] < heap[child] ) )
+            )
+        {
+            child++;
+        }
+        ipc        = heap[child];
+        tmpValC    = dst [ ipc * traCntMax + ic ];
+        if( tmpVal < tmpValC || ( tmpVal == tmpValC && ip < ipc ) )
+        {
+            break;
+        }
+        heap[idx] = ipc;
+        idx = child;
+    }
+    heap[idx] = ip;
+}
+/*---------------------------------------------------------------------*/
+//    TrMakeDstHeap
+/*---------------------------------------------------------------------*/
+STB_INT32
+TrMakeDstHeap
+    (
+        STB_INT32    *dst            ,    //distance table [ ip * traCntMax + ic ]
+        STB_INT32    ic                ,
+        STB_INT32    *heap            ,    //[in] candidates of ic , [out] heap of them
+        STB_INT32    candCnt            ,
+        STB_INT32    traCntMax        ,
+        STB_INT32    *idPreCur
+    )
+{
+    //Make the heap of the candidates that are not associated yet and can be linked, in place.
+    STB_INT32    k , heapCnt ;
+
+    heapCnt = 0;
+    for( k = 0 ; k < candCnt ;  k++ )        
+    {
+        if( idPreCur[ heap[k] ] == -1 && dst [ heap[k] * traCntMax + ic ] != STB_INT_MAX )
+        {
+            heap[heapCnt] = heap[k];
+            heapCnt++;
+        }
+    }
+    for( k = heapCnt / 2 - 1 ; k >= 0 ;  k-- )        
+    {
+        TrDownDstHeap( dst , ic , heap , heapCnt , k , traCntMax );
+    }
+    return heapCnt;
+}
+/*---------------------------------------------------------------------*/
+//    TrSetMinDstHeap
+/*---------------------------------------------------------------------*/
+void
+TrSetMinDstHeap
+    (
+        STB_INT32    *dst            ,    //distance table [ ip * traCntMax + ic ]
+        STB_INT32    ic                ,
+        STB_INT32    *heap            ,    //heap of TrMakeDstHeap
+        STB_INT32    *heapCnt        ,
+        STB_INT32    traCntMax        ,
+        STB_INT32    *idPreCur        ,
+        STB_INT32    *minDst            ,
+        STB_INT32    *minPre
+    )
+{
+    //Same as TrSetMinDst : remove the associated previous data from the top, then the top is the minimum.
+    while( *heapCnt > 0 && idPreCur[ heap[0] ] != -1 )
+    {
+        (*heapCnt)--;
+        heap[0] = heap[ *heapCnt ];
+        TrDownDstHeap( dst , ic , heap , *heapCnt , 0 , traCntMax );
+    }
+    if( *heapCnt > 0 )
+    {
+        *minDst = dst [ heap[0] * traCntMax + ic ] ;        *minPre = heap[0];
+    }else
+    {
+        *minDst = STB_INT_MAX;    *minPre = -1;
+    }
+}
+/*---------------------------------------------------------------------*/
+//    TrAssignOptimal
+/*---------------------------------------------------------------------*/
+//Compile-time check : the array size is negative if STB_TR_ASSOC_DST_MAX lets the potentials overflow.
+typedef char TrAssocDstMaxCheck[ ( STB_TR_ASSOC_DST_MAX <= STB_INT_MAX / ( STB_CNT_MAX_LIMIT + 1 ) ) ? 1 : -1 ];
+
+void
+TrAssignOptimal
+    (
+        STB_INT32    *dst            ,    //distance table [ ip * traCntMax + ic ]
+        STB_INT32    curCnt            ,
+        STB_INT32    preCnt            ,
+        STB_INT32    traCntMax        ,
+        STB_INT32    *idCurPre        ,
+        STB_INT32    *idPreCur        ,
+        STB_INT32    *work                //( traCntMax + 1 ) * 6
+    )
+{
+    //Hungarian method on the rectangular table.
+    //The smaller side is used as the row so that every row is linked to a column.
+    //Rows and columns are 1-origin, row 0 and column 0 are dummies.
+    STB_INT32    rowCnt , colCnt    ;
+    STB_INT32    bTrans            ;
+    STB_INT32    *u , *v , *p , *way , *minv , *used;
+    STB_INT32    i , j , i0 , j0 , j1;
+    STB_INT32    ip , ic            ;
+    STB_INT32    cur , delta        ;
+
+    bTrans    = ( curCnt > preCnt ) ? STB_TRUE : STB_FALSE;    //STB_TRUE : row is previous frame
+    rowCnt    = ( bTrans == STB_TRUE ) ? preCnt : curCnt;
+    colCnt    = ( bTrans == STB_TRUE ) ? curCnt : preCnt;
+
+    u        = work                            ;
+    v        = work + ( traCntMax + 1 ) * 1    ;
+    p        = work + ( traCntMax + 1 ) * 2    ;
+    way        = work + ( traCntMax + 1 ) * 3    ;
+    minv    = work + ( traCntMax + 1 ) * 4    ;
+    used    = work + ( traCntMax + 1 ) * 5    ;
+
+    for( j = 0 ; j <= colCnt ; j++ )
+    {
+        u[j] = 0;    v[j] = 0;    p[j] = 0;    way[j] = 0;
+    }
+
+    for( i = 1 ; i <= rowCnt ; i++ )
+    {
+        p[0]    = i    ;
+        j0        = 0    ;
+        for( j = 0 ; j <= colCnt ; j++ )
+        {
+            minv[j] = STB_INT_MAX;    used[j] = STB_FALSE;
+        }
+        do
+        {
+            //Extend the alternating tree by the column with the smallest reduced distance.
+            used[j0]    = STB_TRUE        ;
+            i0            = p[j0]            ;
+            delta        = STB_INT_MAX    ;
+            j1            = 0                ;
+            for( j = 1 ; j <= colCnt ; j++ )
+            {
+                if( used[j] == STB_TRUE )
+                {
+                    continue;
+                }
+                if( bTrans == STB_TRUE )
+                {
+                    ip = i0 - 1;    ic = j - 1;
+                }else
+                {
+                    ip = j - 1;        ic = i0 - 1;
+                }
+                cur = dst [ ip * traCntMax + ic ];
+                //Clamped : v[j] falls by at most the total distance of the rows (<= STB_CNT_MAX_LIMIT links),
+                //so cur - ( u[i0] + v[j] ) stays below ( STB_CNT_MAX_LIMIT + 1 ) * STB_TR_ASSOC_DST_MAX.
+                if( cur < 0 || STB_TR_ASSOC_DST_MAX < cur )
+                {
+                    cur = STB_TR_ASSOC_DST_MAX;
+                }
+                cur -= u[i0] + v[j];
+                if( cur < minv[j] )
+                {
+                    minv[j] = cur;    way[j] = j0;
+                }
+                if( minv[j] < delta )
+                {
+                    delta = minv[j];    j1 = j;
+                }
+            }
+            for( j = 0 ; j <= colCnt ; j++ )
+            {
+                if( used[j] == STB_TRUE )
+                {
+                    u[p[j]] += delta;    v[j] -= delta;
+                }else
+                {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while( p[j0] != 0 );
+        //Flip the augmenting path.
+        do
+        {
+            j1        = way[j0]    ;
+            p[j0]    = p[j1]        ;
+            j0        = j1        ;
+        } while( j0 != 0 );
+    }
+
+    //Link the result. The pairs that can not be the same ROI are not linked.
+    for( j = 1 ; j <= colCnt ; j++ )
+    {
+        if( p[j] == 0 )
+        {
+            continue;
+        }
+        if( bTrans == STB_TRUE )
+        {
+            ip = p[j] - 1;    ic = j - 1;
+        }else
+        {
+            ip = j - 1;        ic = p[j] - 1;
+        }
+        if( dst [ ip * traCntMax + ic ] == STB_INT_MAX )
+        {
+            continue;
+        }
+        idCurPre[ ic ]    = ip    ;
+        idPreCur[ ip ]    = ic    ;
+    }
+}
+/*---------------------------------------------------------------------*/
+//    TrSetLinkData
+/*---------------------------------------------------------------------*/
+void
+TrSetLinkData
+    (
+        ROI_SYS        *wData            ,
+        STB_INT32    wIdx            ,
+        ROI_SYS        *curData        ,
+        STB_INT32    icc                ,
+        ROI_SYS        *preData        ,
+        STB_INT32    ipp                ,
+        STB_INT32    stedinessPos    ,
+        STB_INT32    stedinessSize    ,
+        STB_INT32    motionGain
+    )
+{
+    STB_INT32    tmpX,tmpY,tmpS        ;
+
+    // steadiness
+    TrSteadinessXYS
+        (    
+            curData->posX[icc]    ,curData->posY[icc]    ,curData->size[icc]    ,
+            preData->posX[ipp]    ,preData->posY[ipp]    ,preData->size[ipp]    ,
+            &tmpX                ,&tmpY                ,&tmpS                ,
+            stedinessPos        ,stedinessSize
+        );
+    // set 
+    wData->nTraID[wIdx]    = preData->nTraID[ipp];
+    wData->nDetID[wIdx]    = curData->nDetID[icc];
+    wData->posX  [wIdx]    = tmpX    ;    
+    wData->posY  [wIdx]    = tmpY    ;    
+    wData->size  [wIdx]    = tmpS    ;    
+    wData->conf  [wIdx]    = ( ( curData->conf[icc] + preData->conf[ipp] ) /2 );
+    wData->retryN[wIdx]    = 0    ;//"It's reflected(linked) in the current frame"so that 0.
+    if( motionGain > 0 )
+    {
+        //The previous data is the predicted position.
+        wData->velX  [wIdx]    = TrUpdateVel( preData->velX[ipp] , curData->posX[icc] , preData->posX[ipp] , preData->size[ipp] , motionGain );
+        wData->velY  [wIdx]    = TrUpdateVel( preData->velY[ipp] , curData->posY[icc] , preData->posY[ipp] , preData->size[ipp] , motionGain );
+    }else
+    {
+        wData->velX  [wIdx]    = 0    ;
+        wData->velY  [wIdx]    = 0    ;
+    }
+}
+/*---------------------------------------------------------------------*/
 //    TrStabilizeTR
 /*---------------------------------------------------------------------*/
 void TrStabilizeTR
     (
         ROI_SYS        *wData            ,    //present data after the stabilization
         STB_INT32    *wCnt            ,    //a number of present data after the stabilization
-        ROI_SYS        *rec            ,    //past data
+        ROI_SYS        *curData        ,    //current frame data
+        ROI_SYS        *preData        ,    //previous frame data
         STB_INT32    *cntAcc            ,
+        STB_TR_EVENTS    *events        ,    //events of the present frame
         TRHANDLE    handle
     )
 {
@@ -242,14 +978,20 @@ void TrStabilizeTR
     STB_INT32    *idPreCur        = handle->wIdPreCur    ;
     STB_INT32    *idCurPre        = handle->wIdCurPre    ;
     STB_INT32    *dstTbl            = handle->wDstTbl    ;
-    ROI_SYS        *curData        = &rec[0];//current frame data
-    ROI_SYS        *preData        = &rec[1];//previous frame data
+    STB_INT32    *minDst            = handle->wMinDst    ;
+    STB_INT32    *minPre            = handle->wMinPre    ;
+    STB_INT32    *rescanN        = handle->wRescanN    ;
+    STB_INT32    *heapCnt        = handle->wHeapCnt    ;
+    STB_INT32    *heap            ;
+    STB_INT32    *candTop        = handle->wCandTop    ;
+    STB_INT32    *candPre        = handle->wCandPre    ;
+    STB_INT32    useGrid            = ( handle->assocRange > 0 ) ? STB_TRUE : STB_FALSE;
+    STB_INT32    motionGain        = handle->motionGain;
     STB_INT32   tmpAccCnt        ;
     STB_INT32    ip    ,ic        ;
     STB_INT32    ipp ,icc    ;
     STB_INT32    tmpWCnt    ;
     STB_INT32    tmpVal        ;
-    STB_INT32    tmpX,tmpY,tmpS        ;
     const STB_INT32 LinkNot        = -1    ;
     
 
@@ -267,7 +1009,12 @@ void TrStabilizeTR
     //previous preparation
     //------------------------------------------------------------------------------//
     //Delete the data exceeding the retry count from the previous frame data.
-    TrDelRetry ( preData    ,thrRetryCnt );
+    TrDelRetry ( preData    ,thrRetryCnt , events );
+    //Move the previous frame data to the predicted position of the current frame.
+    if( motionGain > 0 )
+    {
+        TrPredictPos( preData );
+    }
 
 
     //------------------------------------------------------------------------------//
@@ -277,60 +1024,124 @@ void TrStabilizeTR
 
     // "It's reflected in the previous frame" and "It's reflected in the current frame".
     //Create dstTbl. The value of dstTbl is the similarity of the rectangle. Always a value more than or equal to zero. The closer to zero, the more similar they are.
-    TrSetDistTbl( dstTbl,curData,preData,    traCntMax);
-    for( ;; )    
+    if( useGrid == STB_TRUE )
     {
-        //Get the combination (icc, ipp) that minimizes the value of dstTbl.
-        tmpVal = STB_INT_MAX;        icc = -1;        ipp = -1;
-        for( ic = 0 ; ic < curData->cnt ;  ic++ ) 
+        //Only the pairs within the association range are candidates.
+        TrSetDistTblGrid( dstTbl , curData , preData , traCntMax , handle->assocRange ,
+                          ( handle->assocMode == STB_TR_ASSOC_OPTIMAL ) ? STB_TRUE : STB_FALSE ,
+                          candTop , candPre , handle->wGridHead , handle->wGridNext , handle->wGridX , handle->wGridY );
+    }else
+    {
+        TrSetDistTbl( dstTbl,curData,preData,    traCntMax);
+    }
+    if( handle->assocMode == STB_TR_ASSOC_OPTIMAL )
+    {
+        //Get the combinations that minimize the total value of dstTbl.
+        TrAssignOptimal( dstTbl , curData->cnt , preData->cnt , traCntMax , idCurPre , idPreCur , handle->wAsgWork );
+        for( icc = 0 ; icc < curData->cnt ;  icc++ ) 
         {
-            for( ip = 0 ; ip < preData->cnt ;  ip++ )        
+            ipp = idCurPre[ icc ];
+            if( ipp == LinkNot )
             {
-                if( tmpVal > dstTbl [ ip * traCntMax + ic ]  )
-                {
-                    tmpVal = dstTbl [ ip * traCntMax + ic ] ;        icc = ic;    ipp = ip;
-                }
+                continue;
+            }
+            TrSetLinkData( wData , tmpWCnt , curData , icc , preData , ipp , stedinessPos , stedinessSize , motionGain );
+            if( preData->retryN[ipp] > 0 )
+            {
+                TrAddEvent( events , STB_EVENT_FOUND , preData->nTraID[ipp] );//found during the retry
+            }
+            tmpWCnt++;
+            if( tmpWCnt == traCntMax  )
+            {
+                *wCnt = tmpWCnt;
+                return;
             }
         }
-        if( tmpVal == STB_INT_MAX )
-        {
-            break;
-        }
-
-        //Link ipp and icc
-        idCurPre[ icc    ]    = ipp    ;
-        idPreCur[ ipp    ]    = icc    ;
-        // steadiness
-        TrSteadinessXYS
-            (    
-                curData->posX[icc]    ,curData->posY[icc]    ,curData->size[icc]    ,
-                preData->posX[ipp]    ,preData->posY[ipp]    ,preData->size[ipp]    ,
-                &tmpX                ,&tmpY                ,&tmpS                ,
-                stedinessPos        ,stedinessSize
-            );
-        // set 
-        wData->nTraID[tmpWCnt]    = preData->nTraID[ipp];
-        wData->nDetID[tmpWCnt]    = curData->nDetID[icc];
-        wData->posX  [tmpWCnt]    = tmpX    ;    
-        wData->posY  [tmpWCnt]    = tmpY    ;    
-        wData->size  [tmpWCnt]    = tmpS    ;    
-        wData->conf  [tmpWCnt]    = ( ( curData->conf[icc] + preData->conf[ipp] ) /2 );
-        wData->retryN[tmpWCnt]    = 0    ;//"It's reflected(linked) in the current frame"so that 0.
-        tmpWCnt++;
-        //Renewal "dstTbl" not to refer the associated data.
+    }else
+    {
+        //Keep the minimum of dstTbl for each current data, so that the whole dstTbl is not scanned for every link.
+        //The combination (icc, ipp) is the same as the one found by scanning the whole dstTbl (icc first, then ipp).
+        //A current data whose minimum is rescanned STB_TR_HEAP_RESCAN_CNT times keeps its candidates in a heap (in wCandPre) instead.
         for( ic = 0 ; ic < curData->cnt ;  ic++ ) 
         {
-            dstTbl [ ipp * traCntMax + ic  ]  = STB_INT_MAX ;
+            rescanN[ic] = 0;
+            heapCnt[ic] = -1;
+            if( useGrid == STB_TRUE )
+            {
+                TrSetMinDstCand( dstTbl , ic , &candPre[ candTop[ic] ] , candTop[ic+1] - candTop[ic] , traCntMax , idPreCur , &minDst[ic] , &minPre[ic] );
+            }else
+            {
+                TrSetMinDst( dstTbl , ic , preData->cnt , traCntMax , idPreCur , &minDst[ic] , &minPre[ic] );
+            }
         }
-        for( ip = 0 ; ip < preData->cnt ;  ip++ ) 
+        for( ;; )    
         {
-            dstTbl [ ip  * traCntMax + icc ]  = STB_INT_MAX ;
-        }
+            //Get the combination (icc, ipp) that minimizes the value of dstTbl.
+            tmpVal = STB_INT_MAX;        icc = -1;        ipp = -1;
+            for( ic = 0 ; ic < curData->cnt ;  ic++ ) 
+            {
+                if( idCurPre[ic] == LinkNot && tmpVal > minDst[ic] )
+                {
+                    tmpVal = minDst[ic];        icc = ic;    ipp = minPre[ic];
+                }
+            }
+            if( tmpVal == STB_INT_MAX )
+            {
+                break;
+            }
 
-        if( tmpWCnt == traCntMax  )
-        {
-            *wCnt = tmpWCnt;
-            return;
+            //Link ipp and icc
+            idCurPre[ icc    ]    = ipp    ;
+            idPreCur[ ipp    ]    = icc    ;
+            TrSetLinkData( wData , tmpWCnt , curData , icc , preData , ipp , stedinessPos , stedinessSize , motionGain );
+            if( preData->retryN[ipp] > 0 )
+            {
+                TrAddEvent( events , STB_EVENT_FOUND , preData->nTraID[ipp] );//found during the retry
+            }
+            tmpWCnt++;
+            //Renewal the minimum of the current data that referred the associated data.
+            for( ic = 0 ; ic < curData->cnt ;  ic++ ) 
+            {
+                if( idCurPre[ic] != LinkNot || minPre[ic] != ipp )
+                {
+                    continue;
+                }
+                if( rescanN[ic] < STB_TR_HEAP_RESCAN_CNT )
+                {
+                    rescanN[ic]++;
+                    if( useGrid == STB_TRUE )
+                    {
+                        TrSetMinDstCand( dstTbl , ic , &candPre[ candTop[ic] ] , candTop[ic+1] - candTop[ic] , traCntMax , idPreCur , &minDst[ic] , &minPre[ic] );
+                    }else
+                    {
+                        TrSetMinDst( dstTbl , ic , preData->cnt , traCntMax , idPreCur , &minDst[ic] , &minPre[ic] );
+                    }
+                }else
+                {
+                    heap = ( useGrid == STB_TRUE ) ? &candPre[ candTop[ic] ] : &candPre[ ic * traCntMax ];
+                    if( heapCnt[ic] < 0 )
+                    {
+                        if( useGrid == STB_TRUE )
+                        {
+                            heapCnt[ic] = TrMakeDstHeap( dstTbl , ic , heap , candTop[ic+1] - candTop[ic] , traCntMax , idPreCur );
+                        }else
+                        {
+                            for( ip = 0 ; ip < preData->cnt ;  ip++ ) 
+                            {
+                                heap[ip] = ip;
+                            }
+                            heapCnt[ic] = TrMakeDstHeap( dstTbl , ic , heap , preData->cnt , traCntMax , idPreCur );
+                        }
+                    }
+                    TrSetMinDstHeap( dstTbl , ic , heap , &heapCnt[ic] , traCntMax , idPreCur , &minDst[ic] , &minPre[ic] );
+                }
+            }
+
+            if( tmpWCnt == traCntMax  )
+            {
+                *wCnt = tmpWCnt;
+                return;
+            }
         }
     }
 
@@ -347,6 +1158,12 @@ void TrStabilizeTR
             wData->size  [tmpWCnt]    = preData->size     [ip];
             wData->conf  [tmpWCnt]    = preData->conf[ip];
             wData->retryN[tmpWCnt]    = preData->retryN[ip]  + 1 ;//"It's not reflected in the current frame"so that +1.
+            wData->velX  [tmpWCnt]    = ( motionGain > 0 ) ? preData->velX[ip] : 0 ;//keep moving at the same velocity
+            wData->velY  [tmpWCnt]    = ( motionGain > 0 ) ? preData->velY[ip] : 0 ;
+            if( preData->retryN[ip] == 0 )
+            {
+                TrAddEvent( events , STB_EVENT_LOST , preData->nTraID[ip] );//start of the retry
+            }
             tmpWCnt++;
         }
         if( tmpWCnt == traCntMax)
@@ -370,6 +1187,9 @@ void TrStabilizeTR
             wData->size  [tmpWCnt]    = curData->size     [ic];
             wData->conf  [tmpWCnt]    = curData->conf[ic];
             wData->retryN[tmpWCnt]    = 0    ;//"It's reflected in the current frame" so that 0.
+            wData->velX  [tmpWCnt]    = 0    ;
+            wData->velY  [tmpWCnt]    = 0    ;
+            TrAddEvent( events , STB_EVENT_ENTER , tmpAccCnt );//start of tracking
             tmpWCnt++;
             tmpAccCnt++;
         }
@@ -410,19 +1230,13 @@ void TrSetRes( ROI_SYS* wRoi,STB_TR_RES* resData , STB_INT32* resCnt )
 /*---------------------------------------------------------------------*/
 void TrEditCur( ROI_SYS* wRoi,ROI_SYS* curData )
 {
-    STB_INT32 i;
+    //Exchange the areas of "wRoi" and "curData" instead of copying the data.
+    //The area of the current detection data is used as "wRoi" in the next frame.
+    ROI_SYS tmpRoi;
 
-    curData->cnt = wRoi->cnt;
-    for( i = 0 ; i < wRoi->cnt ; i++ )
-    {
-        curData->nTraID[i] = wRoi->nTraID[i];
-        curData->nDetID[i] = wRoi->nDetID[i];
-        curData->posX  [i] = wRoi->posX  [i];
-        curData->posY  [i] = wRoi->posY  [i];
-        curData->size  [i] = wRoi->size  [i];
-        curData->conf  [i] = wRoi->conf  [i];
-        curData->retryN[i] = wRoi->retryN[i];
-    }
+    tmpRoi        = *curData    ;
+    *curData    = *wRoi        ;
+    *wRoi        = tmpRoi    ;
 }
 /*---------------------------------------------------------------------*/
 //    StbTrExec
@@ -435,30 +1249,30 @@ int  StbTrExec ( TRHANDLE handle )
     if( handle->execFlg->faceTr    == STB_TRUE )
     {
         //Move the time series of past data.
-        TrSlideRec( handle->fcRec );
+        TrSlideRec( &(handle->fcRecTop) );
         //"the present data" set to the past data 
-        TrCurRec( handle->fcRec ,handle->stbTrDet->fcDet, handle->stbTrDet->fcNum );
+        TrCurRec( &(handle->fcRec[ STB_TR_REC_IDX( handle->fcRecTop , 0 ) ]) ,handle->stbTrDet->fcDet, handle->stbTrDet->fcNum );
         //Calculate "stabilized current data wRoi" from "past data".
-        TrStabilizeTR( handle->wRoi ,&(handle->wRoi->cnt) ,handle->fcRec ,&(handle->fcCntAcc) ,handle );
+        TrStabilizeTR( handle->wRoi ,&(handle->wRoi->cnt) ,&(handle->fcRec[ STB_TR_REC_IDX( handle->fcRecTop , 0 ) ]) ,&(handle->fcRec[ STB_TR_REC_IDX( handle->fcRecTop , 1 ) ]) ,&(handle->fcCntAcc) ,handle->fcEvents ,handle );
         //Set "wRoi" data to output data "resFaces".
         TrSetRes( handle->wRoi, handle->resFaces->face, &(handle->resFaces->cnt) );
-        //set "wRoi" data to accumulated data (current) "fcRec [0]".
-        TrEditCur( handle->wRoi, &(handle->fcRec[0]) );
+        //set "wRoi" data to accumulated data (current) "fcRec".
+        TrEditCur( handle->wRoi, &(handle->fcRec[ STB_TR_REC_IDX( handle->fcRecTop , 0 ) ]) );
     }
 
     /* Body --------------------------------------*/
     if( handle->execFlg->bodyTr    == STB_TRUE )
     {
         //Move the time series of past data.
-        TrSlideRec( handle->bdRec );
+        TrSlideRec( &(handle->bdRecTop) );
         //"the present data" set to the past data 
-        TrCurRec( handle->bdRec ,handle->stbTrDet->bdDet ,handle->stbTrDet->bdNum );
+        TrCurRec( &(handle->bdRec[ STB_TR_REC_IDX( handle->bdRecTop , 0 ) ]) ,handle->stbTrDet->bdDet ,handle->stbTrDet->bdNum );
         //Calculate "stabilized current data wRoi" from "past data".
-        TrStabilizeTR( handle->wRoi ,&(handle->wRoi->cnt) , handle->bdRec, &(handle->bdCntAcc) , handle    );    
+        TrStabilizeTR( handle->wRoi ,&(handle->wRoi->cnt) , &(handle->bdRec[ STB_TR_REC_IDX( handle->bdRecTop , 0 ) ]) , &(handle->bdRec[ STB_TR_REC_IDX( handle->bdRecTop , 1 ) ]) , &(handle->bdCntAcc) , handle->bdEvents , handle    );    
         //Set "wRoi" data to output data "resFaces".
         TrSetRes( handle->wRoi, handle->resBodys->body, &(handle->resBodys->cnt) );
-        //set "wRoi" data to accumulated data (current) "bdRec [0]".
-        TrEditCur( handle->wRoi, &(handle->bdRec[0]) );
+        //set "wRoi" data to accumulated data (current) "bdRec".
+        TrEditCur( handle->wRoi, &(handle->bdRec[ STB_TR_REC_IDX( handle->bdRecTop , 0 ) ]) );
     }
 
 
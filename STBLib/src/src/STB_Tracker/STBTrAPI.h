@@ -21,9 +21,31 @@
     #define ABS(a) (((a) > (0)) ? (a) : (-1*a))
 #endif /* ABS */
 
+/* Without a floating point unit, the tracking uses integer operations only (see TrSqrtInt).
+   It can also be selected by defining STB_TR_INTEGER_SQRT (TR_INTEGER_SQRT=1 of platform/Linux/Makefile). */
+#if !defined( STB_TR_INTEGER_SQRT )
+    #if        defined( __SOFTFP__ )                                    /* ARM : -mfloat-abi=soft */  \
+        ||    ( defined( __arm__ ) && !defined( __ARM_FP ) )            /* ARM : no FPU */            \
+        ||    ( defined( __riscv ) && !defined( __riscv_flen ) )        /* RISC-V : no F extension */ \
+        ||    defined( __mips_soft_float )                            /* MIPS */                    \
+        ||    defined( _SOFT_FLOAT )                                    /* PowerPC */
+        #define STB_TR_INTEGER_SQRT
+    #endif
+#endif
+
+/* The distance table is calculated with SSE2/AVX2 on x86-64 (GCC/Clang), AVX2 is selected at run time.
+   Define STB_TR_NO_SIMD to use the C version only. STB_TR_INTEGER_SQRT (no floating point unit) also uses it. */
+#if defined( __GNUC__ ) && defined( __x86_64__ ) && !defined( STB_TR_NO_SIMD ) && !defined( STB_TR_INTEGER_SQRT )
+    #define STB_TR_SIMD_X86
+    #include <immintrin.h>
+#endif
+
 
 
 int  StbTrExec ( TRHANDLE handle );
+void TrAddEvent( STB_TR_EVENTS *events , STB_INT32 type , STB_INT32 nTraID );
+void TrCheckSameROIRow ( STB_INT32 *dstRow , ROI_SYS *curData , STB_INT32 preX , STB_INT32 preY , STB_INT32 preS );
+void TrCheckSameROIRowC( STB_INT32 *dstRow , ROI_SYS *curData , STB_INT32 icTop , STB_INT32 icEnd , STB_INT32 preX , STB_INT32 preY , STB_INT32 preS );
 
 
 
@@ -26,7 +26,7 @@
 /*Threshold for checking input value*/
 /*-------------------------------------------------------------------*/
 #define     STB_BODY_CNT_MIN        0    // body
-#define     STB_BODY_CNT_MAX        35
+#define     STB_BODY_CNT_MAX        256
 #define     STB_BODY_XY_MIN            0
 #define     STB_BODY_XY_MAX            8191
 #define     STB_BODY_SIZE_MIN        20
@@ -34,7 +34,7 @@
 #define     STB_BODY_CONF_MIN        0
 #define     STB_BODY_CONF_MAX        1000
 #define     STB_FACE_CNT_MIN        0    // face
-#define     STB_FACE_CNT_MAX        35
+#define     STB_FACE_CNT_MAX        256
 #define     STB_FACE_XY_MIN            0
 #define     STB_FACE_XY_MAX            8191
 #define     STB_FACE_SIZE_MIN        20
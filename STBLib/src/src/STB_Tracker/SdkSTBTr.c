@@ -24,6 +24,14 @@ STB_TR_HANDLE STB_Tr_CreateHandle( const STBExecFlg* execFlg ,const STB_INT32 nD
     return (STB_TR_HANDLE)TrCreateHandle( execFlg , nDetCntMax,  nTraCntMax );
 }
 
+STB_UINT32 STB_Tr_GetRequiredMemorySize( const STBExecFlg* execFlg ,const STB_INT32 nDetCntMax, const STB_INT32 nTraCntMax){
+    return TrGetRequiredMemorySize( execFlg , nDetCntMax,  nTraCntMax );
+}
+
+STB_TR_HANDLE STB_Tr_CreateHandleInPlace( VOID* pMem , const STB_UINT32 nMemSize , const STBExecFlg* execFlg ,const STB_INT32 nDetCntMax, const STB_INT32 nTraCntMax){
+    return (STB_TR_HANDLE)TrCreateHandleInPlace( (STB_INT8*)pMem , nMemSize , execFlg , nDetCntMax,  nTraCntMax );
+}
+
 STB_INT32 STB_Tr_DeleteHandle(STB_TR_HANDLE handle){
     return TrDeleteHandle((TRHANDLE)handle);
 }
@@ -43,6 +51,11 @@ STB_INT32 STB_Tr_GetResult(STB_TR_HANDLE handle,STB_TR_RES_FACES* fcResult,STB_T
     return TrGetResult((TRHANDLE)handle,fcResult,bdResult);
 }
 
+/*get the events*/
+STB_INT32 STB_Tr_GetEvents(STB_TR_HANDLE handle,STB_TR_EVENTS* fcEvents,STB_TR_EVENTS* bdEvents){
+    return TrGetEvents((TRHANDLE)handle,fcEvents,bdEvents);
+}
+
 /*Clear*/
 STB_INT32 STB_Tr_Clear(  STB_TR_HANDLE handle  ){
     return TrClear((TRHANDLE)handle);
@@ -65,4 +78,29 @@ STB_INT32 STB_Tr_GetStedinessParam    ( STB_TR_HANDLE handle , STB_INT32*    nSt
 {
     return TrGetStedinessParam((TRHANDLE)handle,nStedinessPos,nStedinessSize);
 }
+/* Association */
+STB_INT32 STB_Tr_SetAssociationMode    ( STB_TR_HANDLE handle , STB_INT32    nMode )
+{
+    return TrSetAssociationMode((TRHANDLE)handle,nMode);
+}
+STB_INT32 STB_Tr_GetAssociationMode    ( STB_TR_HANDLE handle , STB_INT32*    nMode )
+{
+    return TrGetAssociationMode((TRHANDLE)handle,nMode);
+}
+STB_INT32 STB_Tr_SetAssociationRange    ( STB_TR_HANDLE handle , STB_INT32    nRange )
+{
+    return TrSetAssociationRange((TRHANDLE)handle,nRange);
+}
+STB_INT32 STB_Tr_GetAssociationRange    ( STB_TR_HANDLE handle , STB_INT32*    nRange )
+{
+    return TrGetAssociationRange((TRHANDLE)handle,nRange);
+}
+STB_INT32 STB_Tr_SetMotionParam    ( STB_TR_HANDLE handle , STB_INT32    nVelocityGain )
+{
+    return TrSetMotionParam((TRHANDLE)handle,nVelocityGain);
+}
+STB_INT32 STB_Tr_GetMotionParam    ( STB_TR_HANDLE handle , STB_INT32*    nVelocityGain )
+{
+    return TrGetMotionParam((TRHANDLE)handle,nVelocityGain);
+}
 
@@ -55,53 +55,71 @@ STB_UINT32 TrCalcTrSize ( const STBExecFlg *execFlg , STB_UINT32 nTraCntMax , ST
 
     retVal = 0 ;
 
-    retVal += 100 ;///Margin  : alignment
-
-
-    retVal        +=    sizeof( STB_TR_DET        );                                // stbTrDet
+    retVal        +=    STB_MEM_AREA( sizeof( STB_TR_DET        ) );                                // stbTrDet
 
     if( execFlg->bodyTr  == STB_TRUE )
     {
-        retVal    +=    sizeof( ROI_SYS            ) * STB_TR_BACK_MAX                ;// bdRec
-        retVal    +=    sizeof( STB_INT32        ) * STB_TR_BACK_MAX * nTraCntMax    ;// bdRec[t].nDetID
-        retVal    +=    sizeof( STB_INT32        ) * STB_TR_BACK_MAX * nTraCntMax    ;// bdRec[t].nTraID
-        retVal    +=    sizeof( STB_INT32        ) * STB_TR_BACK_MAX * nTraCntMax    ;// bdRec[t].posX
-        retVal    +=    sizeof( STB_INT32        ) * STB_TR_BACK_MAX * nTraCntMax    ;// bdRec[t].posY
-        retVal    +=    sizeof( STB_INT32        ) * STB_TR_BACK_MAX * nTraCntMax    ;// bdRec[t].size
-        retVal    +=    sizeof( STB_INT32        ) * STB_TR_BACK_MAX * nTraCntMax    ;// bdRec[t].conf
-        retVal    +=    sizeof( STB_INT32        ) * STB_TR_BACK_MAX * nTraCntMax    ;// bdRec[t].retryN
-        retVal    +=    sizeof( ROI_DET            ) * nDetCntMax                    ;// stbTrDet->bdDet
-        retVal    +=    sizeof( STB_TR_RES_BODYS)                                ;// resBodys
-        retVal    +=    sizeof( STB_TR_RES        ) * nTraCntMax                    ;// resBodys->body
+        retVal    +=    STB_MEM_AREA( sizeof( ROI_SYS            ) * STB_TR_BACK_MAX )                ;// bdRec
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32        ) * nTraCntMax ) * STB_TR_BACK_MAX    ;// bdRec[t].nDetID
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32        ) * nTraCntMax ) * STB_TR_BACK_MAX    ;// bdRec[t].nTraID
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32        ) * nTraCntMax ) * STB_TR_BACK_MAX    ;// bdRec[t].posX
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32        ) * nTraCntMax ) * STB_TR_BACK_MAX    ;// bdRec[t].posY
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32        ) * nTraCntMax ) * STB_TR_BACK_MAX    ;// bdRec[t].size
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32        ) * nTraCntMax ) * STB_TR_BACK_MAX    ;// bdRec[t].conf
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32        ) * nTraCntMax ) * STB_TR_BACK_MAX    ;// bdRec[t].retryN
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32        ) * nTraCntMax ) * STB_TR_BACK_MAX    ;// bdRec[t].velX
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32        ) * nTraCntMax ) * STB_TR_BACK_MAX    ;// bdRec[t].velY
+        retVal    +=    STB_MEM_AREA( sizeof( ROI_DET            ) * nDetCntMax )                    ;// stbTrDet->bdDet
+        retVal    +=    STB_MEM_AREA( sizeof( STB_TR_RES_BODYS) )                                ;// resBodys
+        retVal    +=    STB_MEM_AREA( sizeof( STB_TR_RES        ) * nTraCntMax )                    ;// resBodys->body
+        retVal    +=    STB_MEM_AREA( sizeof( STB_TR_EVENTS    ) )                                ;// bdEvents
+        retVal    +=    STB_MEM_AREA( sizeof( STB_TR_EVENT    ) * nTraCntMax * 2 )                ;// bdEvents->event
     }
     if( execFlg->faceTr  == STB_TRUE )
     {
-        retVal    +=    sizeof( ROI_SYS            ) * STB_TR_BACK_MAX                ;// fcRec
-        retVal    +=    sizeof( STB_INT32        ) * STB_TR_BACK_MAX * nTraCntMax    ;// fcRec[t].nDetID
-        retVal    +=    sizeof( STB_INT32        ) * STB_TR_BACK_MAX * nTraCntMax    ;// fcRec[t].nTraID
-        retVal    +=    sizeof( STB_INT32        ) * STB_TR_BACK_MAX * nTraCntMax    ;// fcRec[t].posX
-        retVal    +=    sizeof( STB_INT32        ) * STB_TR_BACK_MAX * nTraCntMax    ;// fcRec[t].posY
-        retVal    +=    sizeof( STB_INT32        ) * STB_TR_BACK_MAX * nTraCntMax    ;// fcRec[t].size
-        retVal    +=    sizeof( STB_INT32        ) * STB_TR_BACK_MAX * nTraCntMax    ;// fcRec[t].conf
-        retVal    +=    sizeof( STB_INT32        ) * STB_TR_BACK_MAX * nTraCntMax    ;// fcRec[t].retryN
-        retVal    +=    sizeof( ROI_DET            ) * nDetCntMax                    ;// stbTrDet->fcDet
-        retVal    +=    sizeof( STB_TR_RES_FACES)                                 ;// resFaces
-        retVal    +=    sizeof( STB_TR_RES        ) * nTraCntMax                     ;// resFaces->face
-    }
-
-    retVal    +=    sizeof( STB_INT32    ) * nTraCntMax                ;    // wIdPreCur
-    retVal    +=    sizeof( STB_INT32    ) * nTraCntMax                ;    // wIdCurPre
-    retVal    +=    sizeof( STB_INT32    ) * nTraCntMax * nTraCntMax    ;    // wDstTbl
-    retVal    +=    sizeof( STBExecFlg    )                            ;    // execFlg
-
-    retVal    += ( sizeof( ROI_SYS    )     );//wRoi
-    retVal    += ( sizeof( STB_INT32    ) * nTraCntMax    );//wRoi->nDetID
-    retVal    += ( sizeof( STB_INT32    ) * nTraCntMax    );//wRoi->nTraID
-    retVal    += ( sizeof( STB_INT32    ) * nTraCntMax    );//wRoi->posX
-    retVal    += ( sizeof( STB_INT32    ) * nTraCntMax    );//wRoi->posY
-    retVal    += ( sizeof( STB_INT32    ) * nTraCntMax    );//wRoi->size
-    retVal    += ( sizeof( STB_INT32    ) * nTraCntMax    );//wRoi->conf
-    retVal    += ( sizeof( STB_INT32    ) * nTraCntMax    );//wRoi->retryN
+        retVal    +=    STB_MEM_AREA( sizeof( ROI_SYS            ) * STB_TR_BACK_MAX )                ;// fcRec
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32        ) * nTraCntMax ) * STB_TR_BACK_MAX    ;// fcRec[t].nDetID
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32        ) * nTraCntMax ) * STB_TR_BACK_MAX    ;// fcRec[t].nTraID
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32        ) * nTraCntMax ) * STB_TR_BACK_MAX    ;// fcRec[t].posX
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32        ) * nTraCntMax ) * STB_TR_BACK_MAX    ;// fcRec[t].posY
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32        ) * nTraCntMax ) * STB_TR_BACK_MAX    ;// fcRec[t].size
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32        ) * nTraCntMax ) * STB_TR_BACK_MAX    ;// fcRec[t].conf
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32        ) * nTraCntMax ) * STB_TR_BACK_MAX    ;// fcRec[t].retryN
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32        ) * nTraCntMax ) * STB_TR_BACK_MAX    ;// fcRec[t].velX
+        retVal    +=    STB_MEM_AREA( sizeof( STB_INT32        ) * nTraCntMax ) * STB_TR_BACK_MAX    ;// fcRec[t].velY
+        retVal    +=    STB_MEM_AREA( sizeof( ROI_DET            ) * nDetCntMax )                    ;// stbTrDet->fcDet
+        retVal    +=    STB_MEM_AREA( sizeof( STB_TR_RES_FACES) )                                 ;// resFaces
+        retVal    +=    STB_MEM_AREA( sizeof( STB_TR_RES        ) * nTraCntMax )                     ;// resFaces->face
+        retVal    +=    STB_MEM_AREA( sizeof( STB_TR_EVENTS    ) )                                ;// fcEvents
+        retVal    +=    STB_MEM_AREA( sizeof( STB_TR_EVENT    ) * nTraCntMax * 2 )                ;// fcEvents->event
+    }
+
+    retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax )                ;    // wIdPreCur
+    retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax )                ;    // wIdCurPre
+    retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax * nTraCntMax )    ;    // wDstTbl
+    retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * ( nTraCntMax + 1 ) * 6 )    ;    // wAsgWork
+    retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax )                ;    // wMinDst
+    retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax )                ;    // wMinPre
+    retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax )                ;    // wRescanN
+    retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax )                ;    // wHeapCnt
+    retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * ( nTraCntMax + 1 ) )        ;    // wCandTop
+    retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax * nTraCntMax )    ;    // wCandPre
+    retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * ( nTraCntMax * 2 + 1 ) )    ;    // wGridHead
+    retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax )                ;    // wGridNext
+    retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax )                ;    // wGridX
+    retVal    +=    STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax )                ;    // wGridY
+    retVal    +=    STB_MEM_AREA( sizeof( STBExecFlg    ) )                            ;    // execFlg
+
+    retVal    += STB_MEM_AREA( sizeof( ROI_SYS    ) );//wRoi
+    retVal    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax );//wRoi->nDetID
+    retVal    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax );//wRoi->nTraID
+    retVal    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax );//wRoi->posX
+    retVal    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax );//wRoi->posY
+    retVal    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax );//wRoi->size
+    retVal    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax );//wRoi->conf
+    retVal    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax );//wRoi->retryN
+    retVal    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax );//wRoi->velX
+    retVal    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax );//wRoi->velY
 
     return retVal;
 }
@@ -117,122 +135,220 @@ void ShareTrSize ( TRHANDLE    handle , const STBExecFlg* execFlg )
 
 
 
-    handle->stbTrDet                    =  ( STB_TR_DET*) stbPtr;        stbPtr    += ( sizeof( STB_TR_DET    )         );
+    handle->stbTrDet                    =  ( STB_TR_DET*) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_TR_DET    )         );
 
     if( execFlg->bodyTr  == STB_TRUE )
     {
-        handle->bdRec                    =  ( ROI_SYS*    ) stbPtr;        stbPtr    += ( sizeof( ROI_SYS    ) * STB_TR_BACK_MAX);
+        handle->bdRec                    =  ( ROI_SYS*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( ROI_SYS    ) * STB_TR_BACK_MAX);
         for( t = 0 ; t < STB_TR_BACK_MAX ; t++ )
         {
-            handle->bdRec[t].nDetID        =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
-            handle->bdRec[t].nTraID        =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
-            handle->bdRec[t].posX        =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
-            handle->bdRec[t].posY        =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
-            handle->bdRec[t].size        =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
-            handle->bdRec[t].conf        =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
-            handle->bdRec[t].retryN        =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
+            handle->bdRec[t].nDetID        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+            handle->bdRec[t].nTraID        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+            handle->bdRec[t].posX        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+            handle->bdRec[t].posY        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+            handle->bdRec[t].size        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+            handle->bdRec[t].conf        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+            handle->bdRec[t].retryN        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+            handle->bdRec[t].velX        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+            handle->bdRec[t].velY        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
         }
-        handle->stbTrDet->bdDet            =  ( ROI_DET*    ) stbPtr;        stbPtr    += ( sizeof( ROI_DET    ) * nDetCntMax    );
-        handle->resBodys                =  ( STB_TR_RES_BODYS*    ) stbPtr;        stbPtr    += ( sizeof( STB_TR_RES_BODYS    )                );
-        handle->resBodys->body            =  ( STB_TR_RES*) stbPtr;        stbPtr    += ( sizeof( STB_TR_RES    ) * nTraCntMax    );
+        handle->stbTrDet->bdDet            =  ( ROI_DET*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( ROI_DET    ) * nDetCntMax    );
+        handle->resBodys                =  ( STB_TR_RES_BODYS*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_TR_RES_BODYS    )                );
+        handle->resBodys->body            =  ( STB_TR_RES*) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_TR_RES    ) * nTraCntMax    );
+        handle->bdEvents                =  ( STB_TR_EVENTS*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_TR_EVENTS    )                );
+        handle->bdEvents->event            =  ( STB_TR_EVENT*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_TR_EVENT    ) * nTraCntMax * 2    );
+        handle->bdEvents->cnt            = 0;
     }
 
 
     if( execFlg->faceTr  == STB_TRUE )
     {
-        handle->fcRec                =  ( ROI_SYS*    ) stbPtr;        stbPtr    += ( sizeof( ROI_SYS    ) * STB_TR_BACK_MAX    );
+        handle->fcRec                =  ( ROI_SYS*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( ROI_SYS    ) * STB_TR_BACK_MAX    );
         for( t = 0 ; t < STB_TR_BACK_MAX ; t++ )
         {
-            handle->fcRec[t].nDetID        =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
-            handle->fcRec[t].nTraID        =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
-            handle->fcRec[t].posX        =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
-            handle->fcRec[t].posY        =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
-            handle->fcRec[t].size        =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
-            handle->fcRec[t].conf        =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
-            handle->fcRec[t].retryN        =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
+            handle->fcRec[t].nDetID        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+            handle->fcRec[t].nTraID        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+            handle->fcRec[t].posX        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+            handle->fcRec[t].posY        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+            handle->fcRec[t].size        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+            handle->fcRec[t].conf        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+            handle->fcRec[t].retryN        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+            handle->fcRec[t].velX        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+            handle->fcRec[t].velY        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
         }
-        handle->stbTrDet->fcDet            =  ( ROI_DET*    ) stbPtr;        stbPtr    += ( sizeof( ROI_DET    ) * nDetCntMax    );
+        handle->stbTrDet->fcDet            =  ( ROI_DET*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( ROI_DET    ) * nDetCntMax    );
+
+        handle->resFaces                =  ( STB_TR_RES_FACES*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_TR_RES_FACES    )                );
+        handle->resFaces->face            =  ( STB_TR_RES*) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_TR_RES    ) * nTraCntMax    );
+        handle->fcEvents                =  ( STB_TR_EVENTS*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_TR_EVENTS    )                );
+        handle->fcEvents->event            =  ( STB_TR_EVENT*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_TR_EVENT    ) * nTraCntMax * 2    );
+        handle->fcEvents->cnt            = 0;
+    }
+
+
+    handle->wIdPreCur    =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+    handle->wIdCurPre    =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+    handle->wDstTbl        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax * nTraCntMax    );
+    handle->wAsgWork    =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * ( nTraCntMax + 1 ) * 6    );
+    handle->wMinDst        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+    handle->wMinPre        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+    handle->wRescanN    =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+    handle->wHeapCnt    =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+    handle->wCandTop    =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * ( nTraCntMax + 1 )    );
+    handle->wCandPre    =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax * nTraCntMax    );
+    handle->wGridHead    =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * ( nTraCntMax * 2 + 1 )    );
+    handle->wGridNext    =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+    handle->wGridX        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+    handle->wGridY        =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+    handle->execFlg        =  ( STBExecFlg*) stbPtr;        stbPtr    +=   STB_MEM_AREA( sizeof( STBExecFlg    ) );
+
+    handle->wRoi        =  ( ROI_SYS*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( ROI_SYS    )     );
+    handle->wRoi->nDetID=  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+    handle->wRoi->nTraID=  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+    handle->wRoi->posX    =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+    handle->wRoi->posY    =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+    handle->wRoi->size    =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+    handle->wRoi->conf    =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+    handle->wRoi->retryN=  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+    handle->wRoi->velX    =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+    handle->wRoi->velY    =  ( STB_INT32*    ) stbPtr;        stbPtr    += STB_MEM_AREA( sizeof( STB_INT32    ) * nTraCntMax    );
+}
+/*------------------------------------------------------------------------------------------------------------------*/
+/*    TrClearRec                                                                                                        */
+/*------------------------------------------------------------------------------------------------------------------*/
+void TrClearRec ( TRHANDLE handle )
+{
+    //The past data is referred only within "cnt", so only the counts are reset.
+    //The tracks of the last frame end here : their tracking IDs are released with EXIT events.
+    STB_INT32    i    ;
+    ROI_SYS        *lastRec;
 
-        handle->resFaces                =  ( STB_TR_RES_FACES*    ) stbPtr;        stbPtr    += ( sizeof( STB_TR_RES_FACES    )                );
-        handle->resFaces->face            =  ( STB_TR_RES*) stbPtr;        stbPtr    += ( sizeof( STB_TR_RES    ) * nTraCntMax    );
+    if( handle->execFlg->faceTr == STB_TRUE )
+    {
+        lastRec = &(handle->fcRec[ STB_TR_REC_IDX( handle->fcRecTop , 0 ) ]);
+        for( i = 0 ; i < lastRec->cnt ; i++ )
+        {
+            TrAddEvent( handle->fcEvents , STB_EVENT_EXIT , lastRec->nTraID[i] );
+        }
+        for( i = 0 ; i < STB_TR_BACK_MAX  ; i++)
+        {
+            handle->fcRec[i].cnt= 0;
+        }
+        handle->fcCntAcc = 0;
+        handle->fcRecTop = 0;
     }
-
-
-    handle->wIdPreCur    =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
-    handle->wIdCurPre    =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
-    handle->wDstTbl        =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax * nTraCntMax    );
-    handle->execFlg        =  ( STBExecFlg*) stbPtr;        stbPtr    +=   sizeof( STBExecFlg    );
-
-    handle->wRoi        =  ( ROI_SYS*    ) stbPtr;        stbPtr    += ( sizeof( ROI_SYS    )     );
-    handle->wRoi->nDetID=  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
-    handle->wRoi->nTraID=  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
-    handle->wRoi->posX    =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
-    handle->wRoi->posY    =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
-    handle->wRoi->size    =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
-    handle->wRoi->conf    =  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
-    handle->wRoi->retryN=  ( STB_INT32*    ) stbPtr;        stbPtr    += ( sizeof( STB_INT32    ) * nTraCntMax    );
+    if( handle->execFlg->bodyTr == STB_TRUE )
+    {
+        lastRec = &(handle->bdRec[ STB_TR_REC_IDX( handle->bdRecTop , 0 ) ]);
+        for( i = 0 ; i < lastRec->cnt ; i++ )
+        {
+            TrAddEvent( handle->bdEvents , STB_EVENT_EXIT , lastRec->nTraID[i] );
+        }
+        for( i = 0 ; i < STB_TR_BACK_MAX  ; i++)
+        {
+            handle->bdRec[i].cnt= 0;
+        }
+        handle->bdCntAcc = 0;
+        handle->bdRecTop = 0;
+    }
+    handle->recEpoch = handle->clearEpoch;
 }
 /*---------------------------------------------------------------------
 ---------------------------------------------------------------------*/
-/*Create handle*/
-TRHANDLE TrCreateHandle( const STBExecFlg* execFlg ,const STB_INT32 nDetCntMax, const STB_INT32 nTraCntMax  )
+/*Get the memory size necessary for the handle (0 : invalid parameter)*/
+STB_UINT32 TrGetRequiredMemorySize( const STBExecFlg* execFlg ,const STB_INT32 nDetCntMax, const STB_INT32 nTraCntMax  )
 {
-
-    TRHANDLE    handle    ;
-    STB_INT32    i    ,j    ;
-    STB_INT32    tmpVal    ;
+    TRHANDLE    handle    = NULL;
     STB_INT32    nRet    ;
 
     nRet = TrIsValidPointer(execFlg);
     if(nRet != STB_NORMAL)
     {
-        return NULL;
+        return 0;
     }
 
     if( nDetCntMax < 1 || STB_TR_DET_CNT_MAX < nDetCntMax )
     {
-        return NULL;
+        return 0;
     }
     if( nTraCntMax < 1 || STB_TR_TRA_CNT_MAX < nTraCntMax )
+    {
+        return 0;
+    }
+    if( nTraCntMax < nDetCntMax )/*the current frame is recorded in the tracking area*/
+    {
+        return 0;
+    }
+
+    /*the handle is placed at the cache line boundary, and the areas follow it*/
+    return STB_MEM_ALIGN_TOP - 1 + STB_MEM_AREA( sizeof( *handle ) ) + TrCalcTrSize ( execFlg ,nTraCntMax    , nDetCntMax);
+}
+/*---------------------------------------------------------------------
+---------------------------------------------------------------------*/
+/*Create handle in the memory given by the caller*/
+TRHANDLE TrCreateHandleInPlace( STB_INT8 *pMem , const STB_UINT32 nMemSize , const STBExecFlg* execFlg ,const STB_INT32 nDetCntMax, const STB_INT32 nTraCntMax  )
+{
+
+    TRHANDLE    handle    ;
+    STB_INT32    i    ,j    ;
+    STB_UINT32    tmpVal    ;
+    STB_INT32    nRet    ;
+
+    nRet = TrIsValidPointer(pMem);
+    if(nRet != STB_NORMAL)
     {
         return NULL;
     }
 
-    /*do handle's Malloc here*/
-    handle = ( TRHANDLE )malloc( sizeof(*handle)    );
-    if(handle == NULL)
+    tmpVal = TrGetRequiredMemorySize( execFlg , nDetCntMax , nTraCntMax );
+    if( tmpVal == 0 || nMemSize < tmpVal )
     {
         return NULL;
     }
 
+    handle = ( TRHANDLE )STB_MEM_TOP( pMem );
+
     handle->detCntMax            = nDetCntMax        ;
     handle->traCntMax            = nTraCntMax        ;
     handle->retryCnt            = STB_TR_INI_RETRY        ;
     handle->stedPos                = STB_TR_INI_STEADINESS_SIZE    ;//stabilization parameter(position)
     handle->stedSize            = STB_TR_INI_STEADINESS_POS    ;//stabilization parameter(size)
+    handle->assocMode            = STB_TR_INI_ASSOC_MODE    ;//association mode
+    handle->assocRange            = STB_TR_INI_ASSOC_RANGE    ;//association range
+    handle->motionGain            = STB_TR_INI_MOTION_GAIN    ;//velocity gain of the motion model
     handle->fcCntAcc            = 0                    ;
     handle->bdCntAcc            = 0                    ;
+    handle->fcRecTop            = 0                    ;
+    handle->bdRecTop            = 0                    ;
+    handle->clearEpoch            = 0                    ;
+    handle->recEpoch            = 0                    ;
     handle->trPtr                = NULL;
     handle->stbTrDet            = NULL;
     handle->fcRec                = NULL;
     handle->bdRec                = NULL;
     handle->resFaces            = NULL;
     handle->resBodys            = NULL;
+    handle->fcEvents            = NULL;
+    handle->bdEvents            = NULL;
     handle->wIdPreCur            = NULL;
     handle->wIdCurPre            = NULL;
     handle->wDstTbl                = NULL;
+    handle->wAsgWork            = NULL;
+    handle->wMinDst                = NULL;
+    handle->wMinPre                = NULL;
+    handle->wRescanN            = NULL;
+    handle->wHeapCnt            = NULL;
+    handle->wCandTop            = NULL;
+    handle->wCandPre            = NULL;
+    handle->wGridHead            = NULL;
+    handle->wGridNext            = NULL;
+    handle->wGridX                = NULL;
+    handle->wGridY                = NULL;
     handle->execFlg                = NULL;
+    handle->trMem                = NULL;
 
-    tmpVal            = TrCalcTrSize ( execFlg ,nTraCntMax    , nDetCntMax);    /*calculate necessary amount in the TR handle*/
-    handle->trPtr    = NULL;
-    handle->trPtr    = ( STB_INT8 * )malloc( tmpVal    )    ;                /*keep necessary amount in the TR handle*/
-    if( handle->trPtr == NULL )
-    {
-        free ( handle->trPtr    );
-        free ( handle            );
-        return NULL;
-    }
-    ShareTrSize ( handle , execFlg    );                                    /*Malloc-area is allocated to things that need Malloc in TR handle*/
+    handle->trPtr    = ( STB_INT8 * )handle + STB_MEM_AREA( sizeof( *handle ) );    /*the areas of the TR handle follow the handle*/
+    ShareTrSize ( handle , execFlg    );                                    /*the areas are allocated to things that need them in TR handle*/
 
     /*set initial value*/
     if( execFlg->faceTr == STB_TRUE )
@@ -248,6 +364,8 @@ TRHANDLE TrCreateHandle( const STBExecFlg* execFlg ,const STB_INT32 nDetCntMax,
                 handle->fcRec[i].posY    [j]    = 0;
                 handle->fcRec[i].size    [j]    = -1;
                 handle->fcRec[i].retryN    [j]    = -1;
+                handle->fcRec[i].velX    [j]    = 0;
+                handle->fcRec[i].velY    [j]    = 0;
                 handle->fcRec[i].conf    [j]    = -1;
             }
         }
@@ -265,6 +383,8 @@ TRHANDLE TrCreateHandle( const STBExecFlg* execFlg ,const STB_INT32 nDetCntMax,
                 handle->bdRec[i].posY    [j]    = 0;
                 handle->bdRec[i].size    [j]    = -1;
                 handle->bdRec[i].retryN    [j]    = -1;
+                handle->bdRec[i].velX    [j]    = 0;
+                handle->bdRec[i].velY    [j]    = 0;
                 handle->bdRec[i].conf    [j]    = -1;
             }
         }
@@ -285,6 +405,38 @@ TRHANDLE TrCreateHandle( const STBExecFlg* execFlg ,const STB_INT32 nDetCntMax,
     handle->execFlg->bli        = execFlg->bli        ;
 
 
+    return handle;
+}
+/*---------------------------------------------------------------------
+---------------------------------------------------------------------*/
+/*Create handle*/
+TRHANDLE TrCreateHandle( const STBExecFlg* execFlg ,const STB_INT32 nDetCntMax, const STB_INT32 nTraCntMax  )
+{
+    TRHANDLE    handle    ;
+    STB_UINT32    tmpVal    ;
+    STB_INT8    *pMem    ;
+
+    tmpVal = TrGetRequiredMemorySize( execFlg , nDetCntMax , nTraCntMax );    /*calculate necessary amount in the TR handle*/
+    if( tmpVal == 0 )
+    {
+        return NULL;
+    }
+
+    /*do Malloc of the handle and its areas at once here*/
+    pMem = ( STB_INT8 * )malloc( tmpVal );
+    if( pMem == NULL )
+    {
+        return NULL;
+    }
+
+    handle = TrCreateHandleInPlace( pMem , tmpVal , execFlg , nDetCntMax , nTraCntMax );
+    if( handle == NULL )
+    {
+        free ( pMem );
+        return NULL;
+    }
+    handle->trMem = pMem;
+
     return handle;
 }
 /*---------------------------------------------------------------------
@@ -301,8 +453,10 @@ STB_INT32 TrDeleteHandle(TRHANDLE handle)
         return STB_ERR_NOHANDLE;
     }
 
-    free ( handle->trPtr    );
-    free ( handle            );
+    if( handle->trMem != NULL )/*NULL : created in the memory given by the caller*/
+    {
+        free ( handle->trMem );
+    }
 
     return STB_NORMAL;
 }
@@ -333,6 +487,11 @@ STB_INT32 TrSetDetect(TRHANDLE handle,const STB_TR_DET *stbTrDet){
     {
         return STB_ERR_INVALIDPARAM;
     }
+    if(    ( handle->execFlg->faceTr == STB_TRUE && stbTrDet->fcNum > handle->detCntMax )
+        ||    ( handle->execFlg->bodyTr == STB_TRUE && stbTrDet->bdNum > handle->detCntMax ) )
+    {
+        return STB_ERR_PROCESSCONDITION;
+    }
 
     /*Set the received result to the handle (stbTrDet)*/
     /* Face */
@@ -383,6 +542,22 @@ STB_INT32 TrExecute(TRHANDLE handle){
         return STB_ERR_NOHANDLE;
     }
 
+    /*Events of this frame (the clear processing below adds the EXIT events first)*/
+    if( handle->execFlg->faceTr == STB_TRUE )
+    {
+        handle->fcEvents->cnt = 0;
+    }
+    if( handle->execFlg->bodyTr == STB_TRUE )
+    {
+        handle->bdEvents->cnt = 0;
+    }
+
+    /*The past data before the clear processing is not referred*/
+    if( handle->recEpoch != handle->clearEpoch )
+    {
+        TrClearRec ( handle );
+    }
+
     /*Main processing here*/
     nRet = StbTrExec ( handle );
 
@@ -472,12 +647,11 @@ STB_INT32 TrGetResult(TRHANDLE handle,STB_TR_RES_FACES* fcResult,STB_TR_RES_BODY
 }
 /*---------------------------------------------------------------------
 ---------------------------------------------------------------------*/
-/*Clear*/
-STB_INT32 TrClear(TRHANDLE handle){
+/*Get-Function of events*/
+STB_INT32 TrGetEvents(TRHANDLE handle,STB_TR_EVENTS* fcEvents,STB_TR_EVENTS* bdEvents){
 
     STB_INT32 nRet;
-    STB_INT32 i , j;
-
+    STB_INT32 i;
 
     /*NULL check*/
     nRet = TrIsValidPointer(handle);
@@ -485,49 +659,67 @@ STB_INT32 TrClear(TRHANDLE handle){
         return STB_ERR_NOHANDLE;
     }
 
+    if( handle->execFlg->faceTr == STB_TRUE )
+    {
+        nRet = TrIsValidPointer(fcEvents);
+        if(nRet != STB_NORMAL){
+            return nRet;
+        }
+    }
+    if( handle->execFlg->bodyTr == STB_TRUE )
+    {
+        nRet = TrIsValidPointer(bdEvents);
+        if(nRet != STB_NORMAL){
+            return nRet;
+        }
+    }
+
+    /*Get events from handle*/
 
+    /* Face */
     if( handle->execFlg->faceTr == STB_TRUE )
     {
-        for( i = 0 ; i < STB_TR_BACK_MAX  ; i++)
+        fcEvents->cnt = handle->fcEvents->cnt ;
+        for( i = 0 ; i < handle->fcEvents->cnt ; i++ )
         {
-            handle->fcRec[i].cnt= 0;
-            for( j = 0 ; j < handle->traCntMax ; j++)
-            {
-                handle->fcRec[i].nDetID        [j]    = -1;
-                handle->fcRec[i].nTraID        [j]    = -1;
-                handle->fcRec[i].posX        [j]    = 0      ;
-                handle->fcRec[i].posY        [j]    = 0      ;
-                handle->fcRec[i].size        [j]    = -1;
-                handle->fcRec[i].retryN        [j]    = -1;
-                handle->fcRec[i].conf        [j]    = -1;
-            }
+            fcEvents->event[i].type        = handle->fcEvents->event[i].type    ;
+            fcEvents->event[i].nTraID    = handle->fcEvents->event[i].nTraID    ;
         }
-        handle->fcCntAcc = 0;
     }
 
+    /* Body */
     if( handle->execFlg->bodyTr == STB_TRUE )
     {
-        for( i = 0 ; i < STB_TR_BACK_MAX  ; i++)
+        bdEvents->cnt = handle->bdEvents->cnt ;
+        for( i = 0 ; i < handle->bdEvents->cnt ; i++ )
         {
-            handle->bdRec[i].cnt= 0;
-            for( j = 0 ; j < handle->traCntMax ; j++)
-            {
-                handle->bdRec[i].nDetID        [j]    = -1;
-                handle->bdRec[i].nTraID        [j]    = -1;
-                handle->bdRec[i].posX        [j]    = 0      ;
-                handle->bdRec[i].posY        [j]    = 0      ;
-                handle->bdRec[i].size        [j]    = -1;
-                handle->bdRec[i].retryN        [j]    = -1;
-                handle->bdRec[i].conf        [j]    = -1;
-            }
+            bdEvents->event[i].type        = handle->bdEvents->event[i].type    ;
+            bdEvents->event[i].nTraID    = handle->bdEvents->event[i].nTraID    ;
         }
-        handle->bdCntAcc = 0;
     }
 
     return STB_NORMAL;
 }
 /*---------------------------------------------------------------------
 ---------------------------------------------------------------------*/
+/*Clear*/
+STB_INT32 TrClear(TRHANDLE handle){
+
+    STB_INT32 nRet;
+
+    /*NULL check*/
+    nRet = TrIsValidPointer(handle);
+    if(nRet != STB_NORMAL){
+        return STB_ERR_NOHANDLE;
+    }
+
+    //The past data is not rewritten here. It is regarded as empty at the next execution (TrClearRec).
+    handle->clearEpoch++;
+
+    return STB_NORMAL;
+}
+/*---------------------------------------------------------------------
+---------------------------------------------------------------------*/
 /* */
 STB_INT32 TrSetRetryCount(TRHANDLE handle, STB_INT32 nRetryCount) 
 {
@@ -600,4 +792,109 @@ STB_INT32    TrGetStedinessParam    ( TRHANDLE handle , STB_INT32*    nStediness
     return STB_NORMAL;
 }
 /*---------------------------------------------------------------------
+---------------------------------------------------------------------*/
+STB_INT32    TrSetAssociationMode( TRHANDLE handle , STB_INT32 nMode )
+{
+    STB_INT32 nRet;
+    nRet = TrIsValidPointer(handle);
+    if(nRet != STB_NORMAL){
+        return STB_ERR_NOHANDLE;
+    }
+
+    nRet = TrIsValidValue( nMode , STB_TR_MIN_ASSOC_MODE , STB_TR_MAX_ASSOC_MODE );
+    if(nRet != STB_NORMAL){
+        return STB_ERR_INVALIDPARAM;
+    }
+
+    handle->assocMode = nMode;
+    return STB_NORMAL;
+}
+/*---------------------------------------------------------------------
+---------------------------------------------------------------------*/
+STB_INT32    TrGetAssociationMode( TRHANDLE handle , STB_INT32* nMode )
+{
+    STB_INT32 nRet;
+    nRet = TrIsValidPointer(handle);
+    if(nRet != STB_NORMAL){
+        return STB_ERR_NOHANDLE;
+    }
+    nRet = TrIsValidPointer(nMode);
+    if(nRet != STB_NORMAL){
+        return STB_ERR_INVALIDPARAM;
+    }
+
+    *nMode = handle->assocMode ;
+    return STB_NORMAL;
+}
+/*---------------------------------------------------------------------
+---------------------------------------------------------------------*/
+STB_INT32    TrSetAssociationRange( TRHANDLE handle , STB_INT32 nRange )
+{
+    STB_INT32 nRet;
+    nRet = TrIsValidPointer(handle);
+    if(nRet != STB_NORMAL){
+        return STB_ERR_NOHANDLE;
+    }
+
+    nRet = TrIsValidValue( nRange , STB_TR_MIN_ASSOC_RANGE , STB_TR_MAX_ASSOC_RANGE );
+    if(nRet != STB_NORMAL){
+        return STB_ERR_INVALIDPARAM;
+    }
+
+    handle->assocRange = nRange;
+    return STB_NORMAL;
+}
+/*---------------------------------------------------------------------
+---------------------------------------------------------------------*/
+STB_INT32    TrGetAssociationRange( TRHANDLE handle , STB_INT32* nRange )
+{
+    STB_INT32 nRet;
+    nRet = TrIsValidPointer(handle);
+    if(nRet != STB_NORMAL){
+        return STB_ERR_NOHANDLE;
+    }
+    nRet = TrIsValidPointer(nRange);
+    if(nRet != STB_NORMAL){
+        return STB_ERR_INVALIDPARAM;
+    }
+
+    *nRange = handle->assocRange ;
+    return STB_NORMAL;
+}
+/*---------------------------------------------------------------------
+---------------------------------------------------------------------*/
+STB_INT32    TrSetMotionParam( TRHANDLE handle , STB_INT32 nVelocityGain )
+{
+    STB_INT32 nRet;
+    nRet = TrIsValidPointer(handle);
+    if(nRet != STB_NORMAL){
+        return STB_ERR_NOHANDLE;
+    }
+
+    nRet = TrIsValidValue( nVelocityGain , STB_TR_MIN_MOTION_GAIN , STB_TR_MAX_MOTION_GAIN );
+    if(nRet != STB_NORMAL){
+        return STB_ERR_INVALIDPARAM;
+    }
+
+    handle->motionGain = nVelocityGain;
+    return STB_NORMAL;
+}
+/*---------------------------------------------------------------------
+---------------------------------------------------------------------*/
+STB_INT32    TrGetMotionParam( TRHANDLE handle , STB_INT32* nVelocityGain )
+{
+    STB_INT32 nRet;
+    nRet = TrIsValidPointer(handle);
+    if(nRet != STB_NORMAL){
+        return STB_ERR_NOHANDLE;
+    }
+    nRet = TrIsValidPointer(nVelocityGain);
+    if(nRet != STB_NORMAL){
+        return STB_ERR_INVALIDPARAM;
+    }
+
+    *nVelocityGain = handle->motionGain ;
+    return STB_NORMAL;
+}
+/*---------------------------------------------------------------------
 ---------------------------------------------------------------------*/
\ No newline at end of file
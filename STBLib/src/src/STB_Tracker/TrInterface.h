@@ -34,9 +34,11 @@ extern "C" {
     
 /* refer to past "STB_BACK_MAX-1" frames of results */
 #define STB_TR_BACK_MAX 2 
+/* fcRec/bdRec are used as a ring buffer. The data of "t" frames before is rec[ STB_TR_REC_IDX( top , t ) ]. */
+#define STB_TR_REC_IDX( top , t ) ( ( (top) + (t) ) % STB_TR_BACK_MAX )
 
-#define STB_TR_DET_CNT_MAX 35 
-#define STB_TR_TRA_CNT_MAX 35
+#define STB_TR_DET_CNT_MAX 256
+#define STB_TR_TRA_CNT_MAX 256
 
 //If the face isn't find out during tracking, set until how many frames can look for it.
 //In the case of tracking failed with a specified number of frames consecutively, end of tracking as the face lost.
@@ -60,6 +62,39 @@ extern "C" {
 #define STB_TR_MIN_STEADINESS_SIZE        0
 #define STB_TR_MAX_STEADINESS_SIZE        100
 
+//Specifies how the current frame is linked to the previous frame.
+//STB_TR_ASSOC_GREEDY links the most similar pair first, STB_TR_ASSOC_OPTIMAL minimizes the total distance.
+#define STB_TR_INI_ASSOC_MODE        STB_TR_ASSOC_GREEDY
+#define STB_TR_MIN_ASSOC_MODE        STB_TR_ASSOC_GREEDY
+#define STB_TR_MAX_ASSOC_MODE        STB_TR_ASSOC_OPTIMAL
+
+//Specifies settings %
+//Only the pairs whose position change, as a percentage of the size in the previous frame, is within this value are linked.
+//The previous data is looked up in a uniform grid, so the cost is near-linear in the number of people.
+//0(<- initialize value) links the pairs regardless of the position change (all pairs are evaluated).
+#define STB_TR_INI_ASSOC_RANGE        0
+#define STB_TR_MIN_ASSOC_RANGE        0
+#define STB_TR_MAX_ASSOC_RANGE        1000
+
+//Specifies settings %
+//The velocity of each track is corrected by this percentage of the difference between the detected position and the predicted position.
+//The previous position is moved by the velocity before the association, and the track that isn't found out keeps moving during the retry.
+//0(<- initialize value) doesn't use the motion model (the previous position is used as it is).
+#define STB_TR_INI_MOTION_GAIN        0
+#define STB_TR_MIN_MOTION_GAIN        0
+#define STB_TR_MAX_MOTION_GAIN        100
+//The predicted position is kept within the range of the detected position.
+#define STB_TR_XY_MIN        STB_FACE_XY_MIN
+#define STB_TR_XY_MAX        STB_FACE_XY_MAX
+
+//Upper limit of the distance used by the optimal association.
+//The potentials reach ( STB_CNT_MAX_LIMIT + 1 ) times this value and must stay within STB_INT32.
+#define STB_TR_ASSOC_DST_MAX        0x007F807F
+
+//The greedy association rescans the distances of a current data this many times,
+//after that its candidates are kept in a heap so that the worst case stays O(n^2 log n).
+#define STB_TR_HEAP_RESCAN_CNT        2
+
 
 //////////////////////////////////////////////////////////////////////////////////    
 //////////////////////////////////////////////////////////////////////////////////
@@ -77,27 +112,50 @@ typedef struct{
     STB_INT32   *size        ; /* Size                    */
     STB_INT32   *conf        ; /* Degree of confidence    */
     STB_INT32   *retryN        ; /*Continuous retry count*/
+    STB_INT32   *velX        ; /* Velocity x (1/100 pixel per frame) */
+    STB_INT32   *velY        ; /* Velocity y (1/100 pixel per frame) */
 }ROI_SYS;
 
 
 /*---------------------------------------------------------------------------*/
 typedef struct tagPEHANDLE {
+    STB_INT8            *trMem            ;//block allocated by TrCreateHandle (NULL : memory given by the caller)
     STB_INT8            *trPtr            ;
     STB_INT32            detCntMax        ;//Maximum of detected people
     STB_INT32            traCntMax        ;//Maximum number of tracking people
     STB_INT32            retryCnt        ;//Retry count
     STB_INT32            stedPos            ;//stabilization parameter(position)
     STB_INT32            stedSize        ;//stabilization parameter(size)
+    STB_INT32            assocMode        ;//association mode
+    STB_INT32            assocRange        ;//association range (0 : unlimited)
+    STB_INT32            motionGain        ;//velocity gain of the motion model (0 : not used)
     STB_INT32            fcCntAcc        ;//Number of faces (cumulative)
     STB_INT32            bdCntAcc        ;//a number of human bodies(cumulative)
     STB_TR_DET            *stbTrDet        ;//Present data before the stabilization(input).
     ROI_SYS                *fcRec            ;//past data
     ROI_SYS                *bdRec            ;//past data
+    STB_INT32            fcRecTop        ;//index of the current data in fcRec
+    STB_INT32            bdRecTop        ;//index of the current data in bdRec
+    STB_UINT32            clearEpoch        ;//incremented by the clear processing
+    STB_UINT32            recEpoch        ;//clearEpoch that fcRec and bdRec belong to
     STB_TR_RES_FACES    *resFaces        ;//present data after the stabilization(output)
     STB_TR_RES_BODYS    *resBodys        ;//present data after the stabilization(output)
+    STB_TR_EVENTS        *fcEvents        ;//events of the present frame(output) : up to traCntMax * 2
+    STB_TR_EVENTS        *bdEvents        ;//events of the present frame(output) : up to traCntMax * 2
     STB_INT32            *wIdPreCur        ;
     STB_INT32            *wIdCurPre        ;
     STB_INT32            *wDstTbl        ;
+    STB_INT32            *wAsgWork        ;//work area of the optimal association
+    STB_INT32            *wMinDst        ;//minimum value of dstTbl for each current data
+    STB_INT32            *wMinPre        ;//previous data that gives wMinDst
+    STB_INT32            *wRescanN        ;//a number of the rescans of wMinDst for each current data
+    STB_INT32            *wHeapCnt        ;//a number of the candidates in the heap for each current data (-1 : not made)
+    STB_INT32            *wCandTop        ;//start of the candidates of each current data in wCandPre
+    STB_INT32            *wCandPre        ;//candidates (previous data within the association range)
+    STB_INT32            *wGridHead        ;//grid of the previous data : first data of each hashed cell
+    STB_INT32            *wGridNext        ;//grid of the previous data : next data in the same hashed cell
+    STB_INT32            *wGridX            ;//grid of the previous data : cell x
+    STB_INT32            *wGridY            ;//grid of the previous data : cell y
     STBExecFlg            *execFlg        ;
     ROI_SYS                *wRoi            ;
 } *TRHANDLE;
@@ -108,16 +166,25 @@ typedef struct tagPEHANDLE {
 //////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////
 
+STB_UINT32    TrGetRequiredMemorySize( const STBExecFlg* execFlg ,const STB_INT32 nDetCntMax, const STB_INT32 nTraCntMax );
+TRHANDLE    TrCreateHandleInPlace( STB_INT8 *pMem , const STB_UINT32 nMemSize , const STBExecFlg* execFlg ,const STB_INT32 nDetCntMax, const STB_INT32 nTraCntMax );
 TRHANDLE    TrCreateHandle        ( const STBExecFlg* execFlg ,const STB_INT32 nDetCntMax, const STB_INT32 nTraCntMax );
 STB_INT32    TrDeleteHandle        ( TRHANDLE handle);
 STB_INT32    TrSetDetect            ( TRHANDLE handle , const STB_TR_DET *stbTrDet);
 STB_INT32    TrExecute            ( TRHANDLE handle);
 STB_INT32    TrClear                ( TRHANDLE handle);
 STB_INT32    TrGetResult            ( TRHANDLE handle , STB_TR_RES_FACES* fcResult,STB_TR_RES_BODYS* bdResult);
+STB_INT32    TrGetEvents            ( TRHANDLE handle , STB_TR_EVENTS* fcEvents,STB_TR_EVENTS* bdEvents);
 STB_INT32    TrSetRetryCount        ( TRHANDLE handle , STB_INT32  nRetryCount    );
 STB_INT32    TrGetRetryCount        ( TRHANDLE handle , STB_INT32* nRetryCount    );
 STB_INT32    TrSetStedinessParam    ( TRHANDLE handle , STB_INT32  nStedinessPos , STB_INT32  nStedinessSize );
 STB_INT32    TrGetStedinessParam    ( TRHANDLE handle , STB_INT32* nStedinessPos , STB_INT32* nStedinessSize );
+STB_INT32    TrSetAssociationMode( TRHANDLE handle , STB_INT32  nMode );
+STB_INT32    TrGetAssociationMode( TRHANDLE handle , STB_INT32* nMode );
+STB_INT32    TrSetAssociationRange( TRHANDLE handle , STB_INT32  nRange );
+STB_INT32    TrGetAssociationRange( TRHANDLE handle , STB_INT32* nRange );
+STB_INT32    TrSetMotionParam    ( TRHANDLE handle , STB_INT32  nVelocityGain );
+STB_INT32    TrGetMotionParam    ( TRHANDLE handle , STB_INT32* nVelocityGain );
 
 
 
@@ -41,6 +41,30 @@
 #define     STB_TRUE  (1)
 #define     STB_FALSE (0)
 
+/* Tracking association mode */
+#define     STB_TR_ASSOC_GREEDY        (0)       /* Link the most similar pair first (default) */
+#define     STB_TR_ASSOC_OPTIMAL       (1)       /* Minimize the total distance of all links */
+
+/* Detection/tracking capacity (STB_CreateHandleEx) */
+#define     STB_CNT_MAX_DEFAULT        (35)      /* Capacity used by STB_CreateHandle */
+#define     STB_CNT_MAX_LIMIT          (256)     /* Upper limit of the capacity */
+
+/* Stabilization history depth of PE/FR (STB_CreateHandleEx2) */
+#define     STB_HISTORY_DEPTH_DEFAULT  (20)      /* Depth used by STB_CreateHandle/STB_CreateHandleEx */
+#define     STB_HISTORY_DEPTH_MIN      (2)       /* Lower limit of the depth */
+#define     STB_HISTORY_DEPTH_LIMIT    (128)     /* Upper limit of the depth */
+
+/* Caller-described input layout (STB_SetFrameResultLayout) */
+#define     STB_LAYOUT_NONE            (-1)      /* The element has no such value */
+#define     STB_LAYOUT_VALUE( elem , offset , def ) ( ( ( offset ) == STB_LAYOUT_NONE ) ? ( def ) : *( const STB_INT32* )( ( elem ) + ( offset ) ) )
+
+/* Memory arena of a handle (STB_CreateHandleInPlace) */
+#define     STB_MEM_ALIGN_TOP          (64)      /* Alignment of the handle : cache line */
+#define     STB_MEM_ALIGN_AREA         (8)       /* Alignment of each area carved from the arena */
+#define     STB_MEM_ROUND( size , unit )    ( ( ( size ) + ( unit ) - 1 ) / ( unit ) * ( unit ) )
+#define     STB_MEM_AREA( size )            STB_MEM_ROUND( ( size ) , STB_MEM_ALIGN_AREA )
+#define     STB_MEM_TOP( ptr )              ( ( STB_INT8* )( ptr ) + ( ( STB_MEM_ALIGN_TOP - ( ( size_t )( ptr ) % STB_MEM_ALIGN_TOP ) ) % STB_MEM_ALIGN_TOP ) )
+
 
 
 #if !defined(STB_API)
@@ -19,11 +19,15 @@
 #include "STBTypedefInput.h"
 #include "STBHandle.h"
 
-VOID SetFaceObject        (const STB_FRAME_RESULT_FACES* stbINPUTfaces,FaceObj *faces , const STBExecFlg *execFlg , const STB_INT32 nTraCntMax    );
-VOID SetTrackingIDToFace(STB_INT32 TrackingNum,STB_INT32 DetectNum, TraObj *track,FaceObj *faces, const STBExecFlg *execFlg );
-VOID SetFaceToPeInfo    (STB_INT32 TrackingNum,FaceObj *faces,STB_PE_DET *peInfo);
+VOID SetFaceObject        (STB_INT32 nCount,const STB_FRAME_RESULT_FACE* stbINPUTfaces,FaceObj *faces , const STBExecFlg *execFlg , const STB_INT32 nTraCntMax    );
+STB_INT32 SetFaceObjectLayout(STB_INT32 nCount,const STB_INT8 *stbINPUTfaces,const STB_FRAME_LAYOUT_FACE *layout,FaceObj *faces , const STBExecFlg *execFlg , const STB_INT32 nTraCntMax    );
+VOID SetTrackingIDToFace(STB_INT32 TrackingNum,STB_INT32 DetectNum, TraObj *track,FaceObj *faces, const STBExecFlg *execFlg , STB_INT32 *detTra , STB_INT32 *traFace );
+VOID SetSettledToFace    (STB_INT32 TrackingNum,const FaceObj *faces,const SettledObj *settled,STB_INT32 settledCnt,const STB_INT32 *settledHash,STB_INT32 hashMask,STB_INT32 *faceSettled);
+VOID SetFaceToSettled    (STB_INT32 TrackingNum,const FaceObj *faces,const STBExecFlg *execFlg,SettledObj *settled,STB_INT32 *pnSettledCnt,STB_INT32 *settledHash,STB_INT32 hashMask);
+VOID SetFaceToPeInfo    (STB_INT32 TrackingNum,FaceObj *faces,const STB_INT32 *faceSettled,STB_PE_DET *peInfo);
 VOID SetFaceToFrInfo    (STB_INT32 TrackingNum,FaceObj *faces,STB_FR_DET *frInfo);
-VOID SetPeInfoToFace    (STB_INT32 TrackingNum,STB_PE_RES *peInfo,FaceObj *faces , const STBExecFlg *execFlg );
+VOID SetPeInfoToFace    (STB_INT32 TrackingNum,STB_PE_RES *peInfo,const STB_INT32 *faceSettled,const SettledObj *settled,FaceObj *faces , const STBExecFlg *execFlg );
 VOID SetFrInfoToFace    (STB_INT32 TrackingNum,STB_FR_RES *frInfo,FaceObj *faces);
+VOID SetFaceToEvent        (STB_INT32 TrackingNum,FaceObj *faces,const STBExecFlg *execFlg,STB_EVENT *events,STB_INT32 *pnEventCnt);
 
 #endif
\ No newline at end of file
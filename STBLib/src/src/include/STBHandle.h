@@ -58,6 +58,15 @@ typedef struct {
 
 } FaceObj;
 
+/*Age/gender of a tracking person that were FIXED in the previous frame*/
+typedef struct {
+    STB_INT32        nTraID        ;
+    STB_INT32        genConf        ; 
+    STB_INT32        genVal        ;
+    STB_INT32        ageConf        ; 
+    STB_INT32        ageVal        ;
+} SettledObj;
+
 typedef struct {
     STB_INT32        nDetID        ; 
     STB_INT32        nTraID        ;
@@ -83,15 +92,31 @@ typedef struct {
     STB_PE_HANDLE    hPeHandle    ;
     STB_FR_HANDLE    hFrHandle    ;
     FaceObj            *infoFace    ;
+    STB_INT32        *wDetTra    ;/*index of trFace for each face detection (-1 : not tracked)*/
+    STB_INT32        *wTraFace    ;/*index of infoFace for each trFace (-1 : none)*/
+    STB_INT32        nPeSettled    ;/*STB_TRUE : a tracking person whose age/gender are FIXED is not passed to PE (no other property is estimated)*/
+    STB_INT32        nSettledCnt    ;/*a number of settled*/
+    SettledObj        *settled    ;/*FIXED age/gender of the previous frame*/
+    STB_INT32        *settledHash;/*tracking ID -> index of settled (-1 : empty)*/
+    STB_INT32        settledHashMask;
+    STB_INT32        *wFaceSettled;/*index of settled for each infoFace (-1 : passed to PE)*/
+    /*------------------------------*/
+    STB_INT32        nEventCnt    ;/*a number of events of the present frame*/
+    STB_EVENT        *event        ;/*events of the present frame*/
     /*------------------------------*/
+    STB_INT8        *stbMem        ;/*block allocated by CreateHandleEx2 (NULL : memory given by the caller)*/
     STB_INT8        *stbPtr        ;
     STB_INT32        nDetCntMax    ;
     STB_INT32        nTraCntMax    ;
+    STB_INT32        nPeBackMax    ;/*a number of past frames kept for PE stabilization*/
+    STB_INT32        nFrBackMax    ;/*a number of past frames kept for FR stabilization*/
 
 
     STB_TR_DET            *wSrcTr        ;/*TR : input data*/
     STB_TR_RES_FACES    *wDstTrFace    ;/*TR : output data*/
     STB_TR_RES_BODYS    *wDstTrBody    ;/*TR : output data*/
+    STB_TR_EVENTS        *wDstTrFcEvt;/*TR : output events*/
+    STB_TR_EVENTS        *wDstTrBdEvt;/*TR : output events*/
     STB_PE_DET            *wSrcPe        ;/*PR : Input data*/
     STB_PE_RES            *wDstPe        ;/*PE : Output data*/
     STB_FR_DET            *wSrcFr        ;/*FR : Input data*/
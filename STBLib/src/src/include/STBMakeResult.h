@@ -19,7 +19,7 @@
 
 #include "STBHandle.h"
 
-VOID SetFaceToResult(STB_INT32 TrackingNum,TraObj* dtfaces,FaceObj* faces, STB_FACE* result , const STBExecFlg* execFlg );
+VOID SetFaceToResult(STB_INT32 TrackingNum,TraObj* dtfaces,FaceObj* faces, STB_FACE* result , const STBExecFlg* execFlg , const STB_INT32* traFace );
 VOID SetBodyToResult(STB_INT32 TrackingNum,TraObj* dtbodys, STB_BODY* result);
 
 #endif /*__STBMAKERESULT_H__*/
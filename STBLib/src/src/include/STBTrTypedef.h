@@ -67,6 +67,20 @@ typedef struct {
     STB_INT32      cnt        ; /*a number of human body during tracking*/
     STB_TR_RES*    body    ; /*the human body information during tracking*/
 } STB_TR_RES_BODYS;
+/*----------------------------------------------------------------------------*/
+/* Tracking event (Tracking output infomation)                                */
+/*----------------------------------------------------------------------------*/
+typedef struct {
+    STB_INT32   type    ; /*STB_EVENT_ENTER/STB_EVENT_LOST/STB_EVENT_FOUND/STB_EVENT_EXIT*/
+    STB_INT32   nTraID    ; /*Tracking ID*/
+} STB_TR_EVENT;
+/*----------------------------------------------------------------------------*/
+/* Tracking events of the current frame (Tracking output infomation)          */
+/*----------------------------------------------------------------------------*/
+typedef struct {
+    STB_INT32        cnt        ; /*a number of events*/
+    STB_TR_EVENT*    event    ; /*the events*/
+} STB_TR_EVENTS;
 
 
 
@@ -19,13 +19,14 @@
 #include "STBTypedefInput.h"
 #include "STBHandle.h"
 
-VOID SetTrackingObjectBody    ( const STB_FRAME_RESULT_BODYS* stbINPUTbodys,TraObj *bodys);
-VOID SetTrackingObjectFace    ( const STB_FRAME_RESULT_FACES *stbINPUTfaces,TraObj *faces);
+VOID SetTrackingObjectBody    ( STB_INT32 nCount,const STB_FRAME_RESULT_DETECTION* stbINPUTbodys,STB_TR_DET *trSrcInfo);
+VOID SetTrackingObjectFace    ( STB_INT32 nCount,const STB_FRAME_RESULT_FACE *stbINPUTfaces,STB_TR_DET *trSrcInfo);
+STB_INT32 SetTrackingObjectBodyLayout ( STB_INT32 nCount,const STB_INT8 *stbINPUTbodys,const STB_FRAME_LAYOUT_DETECTION *layout,STB_TR_DET *trSrcInfo);
+STB_INT32 SetTrackingObjectFaceLayout ( STB_INT32 nCount,const STB_INT8 *stbINPUTfaces,const STB_FRAME_LAYOUT_FACE *layout,STB_TR_DET *trSrcInfo);
 
 VOID SetTrackingInfoToFace    ( STB_TR_RES_FACES *fdResult,STB_INT32 *pnTrackingNum,TraObj *faces);
 VOID SetTrackingInfoToBody    ( STB_TR_RES_BODYS *bdResult,STB_INT32 *pnTrackingNum,TraObj *bodys);
 
-VOID SetSrcTrFace            ( STB_INT32 nDetCntFace , TraObj *trFace, STB_TR_DET *trSrcInfo);
-VOID SetSrcTrBody            ( STB_INT32 nDetCntBody , TraObj *trBody, STB_TR_DET *trSrcInfo);
+VOID SetTrEventToEvent        ( STB_TR_EVENTS *trEvents,STB_EVENT_TARGET target,STB_EVENT *events,STB_INT32 *pnEventCnt);
 
 #endif
\ No newline at end of file
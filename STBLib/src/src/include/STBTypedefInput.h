@@ -128,4 +128,27 @@ typedef struct {
     STB_FRAME_RESULT_FACES      faces;
 } STB_FRAME_RESULT;
 
+/*Layout of detection results in caller memory : byte offsets of each STB_INT32 (STB_LAYOUT_NONE : absent)*/
+/*nStride and the offsets are STB_INT32 aligned and each value lies inside its element*/
+typedef struct {
+    STB_INT32                   nStride;
+    STB_POINT                   center;
+    STB_INT32                   nSize;
+    STB_INT32                   nConfidence;
+} STB_FRAME_LAYOUT_DETECTION;
+
+typedef struct {
+    STB_INT32                    nStride;
+    STB_POINT                    center;
+    STB_INT32                    nSize;
+    STB_INT32                    nConfidence;
+    STB_FRAME_RESULT_DIRECTION   direction;
+    STB_FRAME_RESULT_AGE         age;
+    STB_FRAME_RESULT_GENDER      gender;
+    STB_FRAME_RESULT_GAZE        gaze;
+    STB_FRAME_RESULT_BLINK       blink;
+    STB_FRAME_RESULT_EXPRESSION  expression;
+    STB_FRAME_RESULT_RECOGNITION recognition;
+} STB_FRAME_LAYOUT_FACE;
+
 #endif /*__HVCW_RESULT_H__*/
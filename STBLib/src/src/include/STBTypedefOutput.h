@@ -28,6 +28,8 @@ typedef     signed short        STB_INT16   ;    /*16-bit signed integer*/
 typedef     unsigned short      STB_UINT16  ;    /*16-bit unsigned integer*/
 typedef     int                 STB_INT32   ;    /*32 bit signed integer*/
 typedef     unsigned int        STB_UINT32  ;    /*32 bit unsigned integer*/
+typedef     long long           STB_INT64   ;    /*64 bit signed integer*/
+typedef     unsigned long long  STB_UINT64  ;    /*64 bit unsigned integer*/
 typedef     float               STB_FLOAT32 ;    /*32-bit floating point number*/
 typedef     double              STB_FLOAT64 ;    /*64-bit floating point number*/
 
@@ -114,6 +116,31 @@ typedef struct {
     STB_INT32   conf;
 } STB_BODY;
 
+/*Type of event*/
+typedef enum {
+    STB_EVENT_ENTER                 = 0, /*start of tracking : a new tracking ID was assigned*/
+    STB_EVENT_LOST                  = 1, /*lost : the tracked object was not detected, retry started*/
+    STB_EVENT_FOUND                 = 2, /*found : the tracked object was detected again during the retry*/
+    STB_EVENT_EXIT                  = 3, /*end of tracking : the retry ran out or the results were cleared, the tracking ID was released*/
+    STB_EVENT_AGE_COMPLETE          = 4, /*age stabilization done*/
+    STB_EVENT_GENDER_COMPLETE       = 5, /*gender stabilization done*/
+    STB_EVENT_RECOGNITION_COMPLETE  = 6, /*recognition stabilization done*/
+} STB_EVENT_TYPE;
+
+/*Target of event*/
+typedef enum {
+    STB_EVENT_TARGET_FACE   = 0,
+    STB_EVENT_TARGET_BODY   = 1,
+} STB_EVENT_TARGET;
+
+/*Event structure*/
+typedef struct {
+    STB_EVENT_TYPE      type;
+    STB_EVENT_TARGET    target;
+    STB_INT32           nTrackingID;
+    STB_INT32           value;/*stabilized value (STB_EVENT_xxx_COMPLETE only, otherwise -1)*/
+} STB_EVENT;
+
 
 
 #endif /* STBTYPEDEF_H__ */
@@ -23,7 +23,9 @@
     typedef  VOID*  STB_PE_HANDLE;
 #endif
 
-STB_PE_HANDLE    STB_Pe_CreateHandle        ( const STBExecFlg* execFlg ,const STB_INT32 nTraCntMax    );/*Create/Delete handle*/
+STB_PE_HANDLE    STB_Pe_CreateHandle        ( const STBExecFlg* execFlg ,const STB_INT32 nTraCntMax , const STB_INT32 nBackMax );/*Create/Delete handle*/
+STB_UINT32        STB_Pe_GetRequiredMemorySize( const STBExecFlg* execFlg ,const STB_INT32 nTraCntMax , const STB_INT32 nBackMax );/*Memory size for STB_Pe_CreateHandleInPlace*/
+STB_PE_HANDLE    STB_Pe_CreateHandleInPlace    ( VOID* pMem , const STB_UINT32 nMemSize , const STBExecFlg* execFlg ,const STB_INT32 nTraCntMax , const STB_INT32 nBackMax );/*Create handle in the memory given by the caller*/
 STB_INT32        STB_Pe_DeleteHandle        ( STB_PE_HANDLE handle                                    );/*Create/Delete handle*/
 STB_INT32        STB_Pe_SetDetect        ( STB_PE_HANDLE handle, const STB_PE_DET *stbPeDet        );/*Frame information settings*/
 STB_INT32        STB_Pe_Execute            ( STB_PE_HANDLE handle                                    );/*Main process execution*/
@@ -25,11 +25,14 @@
 #endif
 
 STB_TR_HANDLE    STB_Tr_CreateHandle            ( const STBExecFlg* execFlg ,const STB_INT32 nDetCntMax, const STB_INT32 nTraCntMax);/*Create/Delete handle*/
+STB_UINT32        STB_Tr_GetRequiredMemorySize( const STBExecFlg* execFlg ,const STB_INT32 nDetCntMax, const STB_INT32 nTraCntMax);/*Memory size for STB_Tr_CreateHandleInPlace*/
+STB_TR_HANDLE    STB_Tr_CreateHandleInPlace    ( VOID* pMem , const STB_UINT32 nMemSize , const STBExecFlg* execFlg ,const STB_INT32 nDetCntMax, const STB_INT32 nTraCntMax);/*Create handle in the memory given by the caller*/
 
 STB_INT32        STB_Tr_DeleteHandle            ( STB_TR_HANDLE handle                                    );/*Create/Delete handle*/
 STB_INT32        STB_Tr_SetDetect            ( STB_TR_HANDLE handle,const STB_TR_DET *stbTrDet        );/*Frame information settings*/
 STB_INT32        STB_Tr_Execute                ( STB_TR_HANDLE handle                                    );/*Main process execution*/
 STB_INT32        STB_Tr_GetResult            ( STB_TR_HANDLE handle,STB_TR_RES_FACES* fcResult,STB_TR_RES_BODYS* bdResult);/*get the result*/
+STB_INT32        STB_Tr_GetEvents            ( STB_TR_HANDLE handle,STB_TR_EVENTS* fcEvents,STB_TR_EVENTS* bdEvents);/*get the events*/
 STB_INT32        STB_Tr_Clear                ( STB_TR_HANDLE handle);
 
 /*parameter*/
@@ -37,6 +40,12 @@ STB_INT32        STB_Tr_SetRetryCount        ( STB_TR_HANDLE handle , STB_INT32
 STB_INT32        STB_Tr_GetRetryCount        ( STB_TR_HANDLE handle , STB_INT32* nRetryCount );
 STB_INT32        STB_Tr_SetStedinessParam    ( STB_TR_HANDLE handle , STB_INT32    nStedinessPos , STB_INT32  nStedinessSize );/* Stediness */
 STB_INT32        STB_Tr_GetStedinessParam    ( STB_TR_HANDLE handle , STB_INT32*    nStedinessPos , STB_INT32* nStedinessSize );
+STB_INT32        STB_Tr_SetAssociationMode    ( STB_TR_HANDLE handle , STB_INT32    nMode );/* Association */
+STB_INT32        STB_Tr_GetAssociationMode    ( STB_TR_HANDLE handle , STB_INT32*    nMode );
+STB_INT32        STB_Tr_SetAssociationRange    ( STB_TR_HANDLE handle , STB_INT32    nRange );
+STB_INT32        STB_Tr_GetAssociationRange    ( STB_TR_HANDLE handle , STB_INT32*    nRange );
+STB_INT32        STB_Tr_SetMotionParam        ( STB_TR_HANDLE handle , STB_INT32    nVelocityGain );
+STB_INT32        STB_Tr_GetMotionParam        ( STB_TR_HANDLE handle , STB_INT32*    nVelocityGain );
 
 
 #endif
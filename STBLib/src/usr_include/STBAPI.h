@@ -33,11 +33,24 @@ STB_INT32    STB_GetVersion(STB_INT8* pnMajorVersion, STB_INT8* pnMinorVersion);
 
 /* Create/Delete handle */
 HSTB         STB_CreateHandle(STB_UINT32 unUseFuncFlag);
+/* Create handle with the detection/tracking capacity (1 to STB_CNT_MAX_LIMIT, nDetectCountMax <= nTrackCountMax) */
+HSTB         STB_CreateHandleEx(STB_UINT32 unUseFuncFlag, STB_INT32 nDetectCountMax, STB_INT32 nTrackCountMax);
+/* Create handle with the capacity and the number of past frames kept for PE/FR stabilization (STB_HISTORY_DEPTH_MIN to STB_HISTORY_DEPTH_LIMIT) */
+HSTB         STB_CreateHandleEx2(STB_UINT32 unUseFuncFlag, STB_INT32 nDetectCountMax, STB_INT32 nTrackCountMax, STB_INT32 nPeHistoryDepth, STB_INT32 nFrHistoryDepth);
+/* Size of the buffer for STB_CreateHandleInPlace with the same parameters as STB_CreateHandleEx2 (0 : invalid parameter) */
+STB_UINT32   STB_GetRequiredMemorySize(STB_UINT32 unUseFuncFlag, STB_INT32 nDetectCountMax, STB_INT32 nTrackCountMax, STB_INT32 nPeHistoryDepth, STB_INT32 nFrHistoryDepth);
+/* Create handle in the buffer given by the caller without allocating memory (the buffer is kept until STB_DeleteHandle) */
+HSTB         STB_CreateHandleInPlace(VOID *pBuffer, STB_UINT32 unBufferSize, STB_UINT32 unUseFuncFlag, STB_INT32 nDetectCountMax, STB_INT32 nTrackCountMax, STB_INT32 nPeHistoryDepth, STB_INT32 nFrHistoryDepth);
 VOID         STB_DeleteHandle(HSTB hSTB);
 
 /* Set the one frame result of HVC into this library */
 STB_INT32    STB_SetFrameResult(HSTB hSTB, const STB_FRAME_RESULT *stFrameResult);
+/* Set the one frame result given as arrays of up to nDetectCountMax elements */
+STB_INT32    STB_SetFrameResultEx(HSTB hSTB, STB_INT32 nBodyCount, const STB_FRAME_RESULT_DETECTION stBody[], STB_INT32 nFaceCount, const STB_FRAME_RESULT_FACE stFace[]);
+/* Set the one frame result read in place from the caller's arrays described by the layouts (pBody/pFace point to the first element) */
+STB_INT32    STB_SetFrameResultLayout(HSTB hSTB, STB_INT32 nBodyCount, const VOID *pBody, const STB_FRAME_LAYOUT_DETECTION *pBodyLayout, STB_INT32 nFaceCount, const VOID *pFace, const STB_FRAME_LAYOUT_FACE *pFaceLayout);
 /* Clear frame results */
+/* All tracking IDs end: the next STB_Execute reports STB_EVENT_EXIT for them, and new tracks reuse the IDs from 0 */
 STB_INT32    STB_ClearFrameResults(HSTB hSTB);
 
 /* Main process execution */
@@ -46,12 +59,23 @@ STB_INT32    STB_Execute(HSTB hSTB);
 /* Get the result */
 STB_INT32    STB_GetFaces(HSTB hSTB, STB_UINT32 *punFaceCount, STB_FACE stFace[]);
 STB_INT32    STB_GetBodies(HSTB hSTB, STB_UINT32 *punBodyCount, STB_BODY stBody[]);
+/* Get the result into arrays of unFaceMax/unBodyMax elements */
+STB_INT32    STB_GetFacesEx(HSTB hSTB, STB_UINT32 unFaceMax, STB_UINT32 *punFaceCount, STB_FACE stFace[]);
+STB_INT32    STB_GetBodiesEx(HSTB hSTB, STB_UINT32 unBodyMax, STB_UINT32 *punBodyCount, STB_BODY stBody[]);
+/* Get the track lifecycle/stabilization events of the last STB_Execute (up to unEventMax events, at most 7 x nTrackCountMax) */
+STB_INT32    STB_GetEvents(HSTB hSTB, STB_UINT32 unEventMax, STB_UINT32 *punEventCount, STB_EVENT stEvent[]);
 
 /* Setting/Getting functions for tracking */
 STB_INT32    STB_SetTrRetryCount(HSTB hSTB, STB_INT32 nMaxRetryCount);
 STB_INT32    STB_GetTrRetryCount(HSTB hSTB, STB_INT32 *pnMaxRetryCount);
 STB_INT32    STB_SetTrSteadinessParam(HSTB hSTB, STB_INT32 nPosSteadinessParam, STB_INT32 nSizeSteadinessParam);
 STB_INT32    STB_GetTrSteadinessParam(HSTB hSTB, STB_INT32 *pnPosSteadinessParam, STB_INT32 *pnSizeSteadinessParam);
+STB_INT32    STB_SetTrAssociationMode(HSTB hSTB, STB_INT32 nMode);
+STB_INT32    STB_GetTrAssociationMode(HSTB hSTB, STB_INT32 *pnMode);
+STB_INT32    STB_SetTrAssociationRange(HSTB hSTB, STB_INT32 nRange);
+STB_INT32    STB_GetTrAssociationRange(HSTB hSTB, STB_INT32 *pnRange);
+STB_INT32    STB_SetTrMotionParam(HSTB hSTB, STB_INT32 nVelocityGain);
+STB_INT32    STB_GetTrMotionParam(HSTB hSTB, STB_INT32 *pnVelocityGain);
 /* Setting/Getting functions for property */
 STB_INT32    STB_SetPeThresholdUse(HSTB hSTB, STB_INT32 nThreshold);
 STB_INT32    STB_GetPeThresholdUse(HSTB hSTB, STB_INT32 *pnThreshold);
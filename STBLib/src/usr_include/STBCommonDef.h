@@ -41,6 +41,22 @@
 #define     STB_TRUE  (1)
 #define     STB_FALSE (0)
 
+/* Tracking association mode */
+#define     STB_TR_ASSOC_GREEDY        (0)       /* Link the most similar pair first (default) */
+#define     STB_TR_ASSOC_OPTIMAL       (1)       /* Minimize the total distance of all links */
+
+/* Detection/tracking capacity (STB_CreateHandleEx) */
+#define     STB_CNT_MAX_DEFAULT        (35)      /* Capacity used by STB_CreateHandle */
+#define     STB_CNT_MAX_LIMIT          (256)     /* Upper limit of the capacity */
+
+/* Stabilization history depth of PE/FR (STB_CreateHandleEx2) */
+#define     STB_HISTORY_DEPTH_DEFAULT  (20)      /* Depth used by STB_CreateHandle/STB_CreateHandleEx */
+#define     STB_HISTORY_DEPTH_MIN      (2)       /* Lower limit of the depth */
+#define     STB_HISTORY_DEPTH_LIMIT    (128)     /* Upper limit of the depth */
+
+/* Caller-described input layout (STB_SetFrameResultLayout) */
+#define     STB_LAYOUT_NONE            (-1)      /* The element has no such value */
+
 
 
 #if !defined(STB_API)
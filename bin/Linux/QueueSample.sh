@@ -0,0 +1,5 @@
+#!/bin/bash
+
+sudo chmod 666 /dev/ttyACM0
+
+./QueueSample 0 921600
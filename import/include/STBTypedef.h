@@ -134,6 +134,33 @@ typedef struct {
     STB_FRAME_RESULT_FACES      faces;
 } STB_FRAME_RESULT;
 
+/* Layout of detection results held in the caller's own memory (STB_SetFrameResultLayout) */
+/* nStride is the byte distance between elements, every other member the byte offset     */
+/* of that STB_INT32 inside one element, or STB_LAYOUT_NONE when the element has no such  */
+/* value. Detection members (center, nSize, nConfidence) cannot be STB_LAYOUT_NONE.      */
+/* The arrays, nStride and the offsets are multiples of 4 bytes (STB_INT32 aligned), and  */
+/* every value lies inside its element (offset + 4 <= nStride).                          */
+typedef struct {
+    STB_INT32                   nStride;
+    STB_POINT                   center;
+    STB_INT32                   nSize;
+    STB_INT32                   nConfidence;
+} STB_FRAME_LAYOUT_DETECTION;
+
+typedef struct {
+    STB_INT32                    nStride;
+    STB_POINT                    center;
+    STB_INT32                    nSize;
+    STB_INT32                    nConfidence;
+    STB_FRAME_RESULT_DIRECTION   direction;
+    STB_FRAME_RESULT_AGE         age;
+    STB_FRAME_RESULT_GENDER      gender;
+    STB_FRAME_RESULT_GAZE        gaze;
+    STB_FRAME_RESULT_BLINK       blink;
+    STB_FRAME_RESULT_EXPRESSION  expression;
+    STB_FRAME_RESULT_RECOGNITION recognition;
+} STB_FRAME_LAYOUT_FACE;
+
 
 /****************************************/
 /*  OUTPUT data strucrure from STBLib.  */
@@ -222,6 +249,31 @@ typedef struct {
     STB_INT32   conf;
 } STB_BODY;
 
+/* Type of track lifecycle / stabilization event */
+typedef enum {
+    STB_EVENT_ENTER                 = 0, /* Start of tracking : a new tracking ID was assigned */
+    STB_EVENT_LOST                  = 1, /* Lost : the tracked object was not detected, retry started */
+    STB_EVENT_FOUND                 = 2, /* Found : the tracked object was detected again during the retry */
+    STB_EVENT_EXIT                  = 3, /* End of tracking : the retry ran out or the results were cleared, the tracking ID was released */
+    STB_EVENT_AGE_COMPLETE          = 4, /* Age stabilization done */
+    STB_EVENT_GENDER_COMPLETE       = 5, /* Gender stabilization done */
+    STB_EVENT_RECOGNITION_COMPLETE  = 6, /* Recognition stabilization done */
+} STB_EVENT_TYPE;
+
+/* Target of event */
+typedef enum {
+    STB_EVENT_TARGET_FACE   = 0,    /* Face tracking ID */
+    STB_EVENT_TARGET_BODY   = 1,    /* Human body tracking ID */
+} STB_EVENT_TARGET;
+
+/* Event structure */
+typedef struct {
+    STB_EVENT_TYPE      type;
+    STB_EVENT_TARGET    target;
+    STB_INT32           nTrackingID;
+    STB_INT32           value;      /* Stabilized value (STB_EVENT_xxx_COMPLETE only, otherwise -1) */
+} STB_EVENT;
+
 
 #endif /* __STB_TYPEDEF_H__ */
 
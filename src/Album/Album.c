@@ -15,6 +15,51 @@
 /*---------------------------------------------------------------------------*/
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "HVCApi.h"
+#include "AlbumIndex.h"
+
+/* Album file container */
+#define ALBUM_FILE_SIGNATURE        "HVCALBUM"      /* Container signature */
+#define ALBUM_FILE_SIGNATURE_SIZE   8               /* Container signature size */
+#define ALBUM_FILE_FORMAT_VERSION   2               /* Container format version */
+#define ALBUM_FILE_HEADER_SIZE      56              /* Container header size */
+#define ALBUM_FILE_FORMAT_V1        1               /* Format version without album index */
+#define ALBUM_FILE_HEADER_SIZE_V1   52              /* Container header size of version 1 */
+#define ALBUM_FILE_INDEX_SIZE       (ALBUM_INDEX_USER_MAX*2)    /* Album index size */
+#define ALBUM_FILE_FLAG_COMPRESSED  0x01            /* Album data is LZ compressed */
+#define ALBUM_FILE_FLAG_INDEX       0x02            /* Album index follows the album data */
+
+/* Container header offsets */
+#define ALBUM_HEAD_SIGNATURE        0
+#define ALBUM_HEAD_FORMAT           8
+#define ALBUM_HEAD_FLAGS            9
+#define ALBUM_HEAD_DEVICE_VERSION   12              /* string[12], major, minor, release, revision[4] */
+#define ALBUM_HEAD_USER_COUNT       32
+#define ALBUM_HEAD_ORIGINAL_SIZE    36
+#define ALBUM_HEAD_STORED_SIZE      40
+#define ALBUM_HEAD_DATA_CRC         44
+#define ALBUM_HEAD_INDEX_CRC        48
+#define ALBUM_HEAD_HEADER_CRC       52
+#define ALBUM_HEAD_HEADER_CRC_V1    48              /* Header CRC of version 1 (no index CRC) */
+
+/* LZ compression */
+#define ALBUM_LZ_WINDOW_SIZE        4096            /* Maximum match offset */
+#define ALBUM_LZ_MATCH_MIN          3               /* Minimum match length */
+#define ALBUM_LZ_MATCH_MAX          18              /* Maximum match length */
+#define ALBUM_LZ_HASH_SIZE          4096            /* Match finder hash table size */
+#define ALBUM_LZ_CHAIN_MAX          16              /* Match finder search depth */
+
+/* Error code */
+#define ALBUM_NORMAL                0               /* Normal end */
+#define ALBUM_ERROR_PARAMETER       -1              /* Parameter error */
+#define ALBUM_ERROR_FILE            -2              /* File access error */
+#define ALBUM_ERROR_FORMAT          -3              /* Invalid container format */
+#define ALBUM_ERROR_CRC             -4              /* CRC mismatch */
+#define ALBUM_ERROR_VERSION         -5              /* Device version mismatch */
+#define ALBUM_ERROR_SIZE            -6              /* Album data does not fit the buffer */
+#define ALBUM_ERROR_MEMORY          -7              /* Memory allocation error */
 
 void SaveAlbumData(const char *inFileName, int inDataSize, unsigned char *inAlbumData)
 {
@@ -47,3 +92,470 @@ void LoadAlbumData(const char *inFileName, int *outDataSize, unsigned char *outA
 
     fclose(pFile);
 }
+
+/*----------------------------------------------------------------------------*/
+/* Calculate CRC-32 (IEEE 802.3)                                              */
+/* param    : const unsigned char   *inData     data                          */
+/*          : int                   inDataSize  data size                     */
+/* return   : unsigned int                      CRC value                     */
+/*----------------------------------------------------------------------------*/
+static unsigned int CalcAlbumCrc(const unsigned char *inData, int inDataSize)
+{
+    static unsigned int crcTable[256];
+    static int isTableReady = 0;
+    unsigned int crc;
+    int i, j;
+
+    if ( !isTableReady ) {
+        for ( i = 0; i < 256; i++ ) {
+            crc = (unsigned int)i;
+            for ( j = 0; j < 8; j++ ) {
+                crc = (crc & 1) ? (0xEDB88320U ^ (crc >> 1)) : (crc >> 1);
+            }
+            crcTable[i] = crc;
+        }
+        isTableReady = 1;
+    }
+
+    crc = 0xFFFFFFFFU;
+    for ( i = 0; i < inDataSize; i++ ) {
+        crc = crcTable[(crc ^ inData[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFU;
+}
+
+static void SetAlbumUInt32(unsigned char *outData, unsigned int inValue)
+{
+    outData[0] = (unsigned char)(inValue & 0x000000ff);
+    outData[1] = (unsigned char)((inValue >> 8) & 0x000000ff);
+    outData[2] = (unsigned char)((inValue >> 16) & 0x000000ff);
+    outData[3] = (unsigned char)((inValue >> 24) & 0x000000ff);
+}
+
+static unsigned int GetAlbumUInt32(const unsigned char *inData)
+{
+    return (unsigned int)inData[0] + ((unsigned int)inData[1]<<8) + ((unsigned int)inData[2]<<16) + ((unsigned int)inData[3]<<24);
+}
+
+/*----------------------------------------------------------------------------*/
+/* LZ compression                                                             */
+/* Stream is a sequence of groups: one flag byte followed by up to 8 items.   */
+/* A set flag bit is a 2-byte match (12-bit offset-1, 4-bit length-3),        */
+/* a clear bit is a literal byte.                                             */
+/* param    : const unsigned char   *inData     source data                   */
+/*          : int                   inDataSize  source data size              */
+/*          : unsigned char         *outData    compressed data               */
+/*          : int                   inOutSize   compressed data buffer size   */
+/* return   : int                               compressed data size          */
+/*          :                                   -1...does not fit outData     */
+/*----------------------------------------------------------------------------*/
+static int CompressAlbum(const unsigned char *inData, int inDataSize, unsigned char *outData, int inOutSize)
+{
+    int *pHead = NULL;
+    int *pPrev = NULL;
+    int pos = 0;
+    int outPos = 0;
+    int flagPos = 0;
+    int flagBit = 8;
+    int hash, cand, chain;
+    int len, bestLen, bestOffset;
+    int i;
+
+    pHead = (int*)malloc(sizeof(int) * ALBUM_LZ_HASH_SIZE);
+    pPrev = (int*)malloc(sizeof(int) * ALBUM_LZ_WINDOW_SIZE);
+    if ( (pHead == NULL) || (pPrev == NULL) ) {
+        free(pHead);
+        free(pPrev);
+        return -1;
+    }
+    for ( i = 0; i < ALBUM_LZ_HASH_SIZE; i++ ) {
+        pHead[i] = -1;
+    }
+
+    while ( pos < inDataSize ) {
+        if ( flagBit == 8 ) {
+            if ( outPos >= inOutSize ) break;
+            flagPos = outPos++;
+            outData[flagPos] = 0;
+            flagBit = 0;
+        }
+
+        bestLen = 0;
+        bestOffset = 0;
+        hash = -1;
+        if ( pos + ALBUM_LZ_MATCH_MIN <= inDataSize ) {
+            hash = ((inData[pos] << 8) ^ (inData[pos+1] << 4) ^ inData[pos+2]) & (ALBUM_LZ_HASH_SIZE - 1);
+            cand = pHead[hash];
+            for ( chain = 0; (chain < ALBUM_LZ_CHAIN_MAX) && (cand >= 0) && (pos - cand <= ALBUM_LZ_WINDOW_SIZE); chain++ ) {
+                for ( len = 0; (len < ALBUM_LZ_MATCH_MAX) && (pos + len < inDataSize); len++ ) {
+                    if ( inData[cand + len] != inData[pos + len] ) break;
+                }
+                if ( len > bestLen ) {
+                    bestLen = len;
+                    bestOffset = pos - cand;
+                    if ( len == ALBUM_LZ_MATCH_MAX ) break;
+                }
+                cand = pPrev[cand & (ALBUM_LZ_WINDOW_SIZE - 1)];
+            }
+        }
+
+        if ( bestLen >= ALBUM_LZ_MATCH_MIN ) {
+            if ( outPos + 2 > inOutSize ) break;
+            outData[flagPos] |= (unsigned char)(1 << flagBit);
+            outData[outPos++] = (unsigned char)((bestOffset - 1) & 0xFF);
+            outData[outPos++] = (unsigned char)((((bestOffset - 1) >> 4) & 0xF0) | (bestLen - ALBUM_LZ_MATCH_MIN));
+        }
+        else {
+            if ( outPos + 1 > inOutSize ) break;
+            outData[outPos++] = inData[pos];
+            bestLen = 1;
+        }
+        flagBit++;
+
+        /* Register every consumed position in the match finder */
+        for ( i = 0; i < bestLen; i++, pos++ ) {
+            if ( pos + ALBUM_LZ_MATCH_MIN <= inDataSize ) {
+                hash = ((inData[pos] << 8) ^ (inData[pos+1] << 4) ^ inData[pos+2]) & (ALBUM_LZ_HASH_SIZE - 1);
+                pPrev[pos & (ALBUM_LZ_WINDOW_SIZE - 1)] = pHead[hash];
+                pHead[hash] = pos;
+            }
+        }
+    }
+
+    free(pHead);
+    free(pPrev);
+
+    if ( pos < inDataSize ) {
+        return -1;
+    }
+    return outPos;
+}
+
+/*----------------------------------------------------------------------------*/
+/* LZ decompression                                                           */
+/* param    : const unsigned char   *inData     compressed data               */
+/*          : int                   inDataSize  compressed data size          */
+/*          : unsigned char         *outData    decompressed data             */
+/*          : int                   inOutSize   expected decompressed size    */
+/* return   : int                               execution result error code   */
+/*          :                                   0...normal                    */
+/*          :                                   -3...corrupted stream         */
+/*----------------------------------------------------------------------------*/
+static int DecompressAlbum(const unsigned char *inData, int inDataSize, unsigned char *outData, int inOutSize)
+{
+    int pos = 0;
+    int outPos = 0;
+    int flags = 0;
+    int flagBit = 8;
+    int offset, len;
+
+    while ( outPos < inOutSize ) {
+        if ( flagBit == 8 ) {
+            if ( pos >= inDataSize ) return ALBUM_ERROR_FORMAT;
+            flags = inData[pos++];
+            flagBit = 0;
+        }
+        if ( flags & (1 << flagBit) ) {
+            if ( pos + 2 > inDataSize ) return ALBUM_ERROR_FORMAT;
+            offset = (inData[pos] | ((inData[pos+1] & 0xF0) << 4)) + 1;
+            len = (inData[pos+1] & 0x0F) + ALBUM_LZ_MATCH_MIN;
+            pos += 2;
+            if ( (offset > outPos) || (outPos + len > inOutSize) ) return ALBUM_ERROR_FORMAT;
+            for ( ; len > 0; len--, outPos++ ) {
+                outData[outPos] = outData[outPos - offset];
+            }
+        }
+        else {
+            if ( pos >= inDataSize ) return ALBUM_ERROR_FORMAT;
+            outData[outPos++] = inData[pos++];
+        }
+        flagBit++;
+    }
+    if ( pos != inDataSize ) return ALBUM_ERROR_FORMAT;
+    return ALBUM_NORMAL;
+}
+
+/*----------------------------------------------------------------------------*/
+/* Save album data in the host container format                               */
+/* param    : const char    *inFileName     file name                         */
+/*          : HVC_VERSION   *inVersion      version of the device the album   */
+/*          :                               was saved from                    */
+/*          : int           inUserCount     number of registered users        */
+/*          :                               (-1...unknown)                    */
+/*          : ALBUM_INDEX   *inIndex        album index stored with the album */
+/*          :                               (NULL or not valid...no index)    */
+/*          : int           inCompress      0...store, 1...LZ compress        */
+/*          : int           inDataSize      album data size                   */
+/*          : unsigned char *inAlbumData    album data (HVC_SaveAlbum output) */
+/* return   : int                           execution result error code       */
+/*          :                               0...normal                        */
+/*          :                               -1...parameter error              */
+/*          :                               -2...file access error            */
+/*          :                               -7...memory allocation error      */
+/*----------------------------------------------------------------------------*/
+int SaveAlbumFile(const char *inFileName, HVC_VERSION *inVersion, int inUserCount, ALBUM_INDEX *inIndex, int inCompress, int inDataSize, unsigned char *inAlbumData)
+{
+    FILE *pFile = NULL;
+    unsigned char header[ALBUM_FILE_HEADER_SIZE];
+    unsigned char index[ALBUM_FILE_INDEX_SIZE];
+    int isIndex;
+    int i;
+    unsigned char *pStoreData = NULL;
+    unsigned char *pCompData = NULL;
+    int storeSize;
+    int ret = ALBUM_NORMAL;
+
+    if ( (NULL == inFileName) || (NULL == inVersion) || (NULL == inAlbumData) || (inDataSize <= 0) || (inUserCount < -1) ) {
+        return ALBUM_ERROR_PARAMETER;
+    }
+
+    memset(header, 0, sizeof(header));
+    memcpy(&header[ALBUM_HEAD_SIGNATURE], ALBUM_FILE_SIGNATURE, ALBUM_FILE_SIGNATURE_SIZE);
+    header[ALBUM_HEAD_FORMAT] = ALBUM_FILE_FORMAT_VERSION;
+
+    /* Keep the data uncompressed when compression does not pay off */
+    pStoreData = inAlbumData;
+    storeSize = inDataSize;
+    if ( inCompress ) {
+        pCompData = (unsigned char*)malloc(inDataSize);
+        if ( pCompData == NULL ) {
+            return ALBUM_ERROR_MEMORY;
+        }
+        storeSize = CompressAlbum(inAlbumData, inDataSize, pCompData, inDataSize - 1);
+        if ( storeSize > 0 ) {
+            header[ALBUM_HEAD_FLAGS] |= ALBUM_FILE_FLAG_COMPRESSED;
+            pStoreData = pCompData;
+        }
+        else {
+            storeSize = inDataSize;
+        }
+    }
+
+    isIndex = (NULL != inIndex) && inIndex->isValid;
+    if ( isIndex ) {
+        header[ALBUM_HEAD_FLAGS] |= ALBUM_FILE_FLAG_INDEX;
+        for ( i = 0; i < ALBUM_INDEX_USER_MAX; i++ ) {
+            index[i*2 + 0] = (unsigned char)(inIndex->dataNo[i] & 0x00ff);
+            index[i*2 + 1] = (unsigned char)((inIndex->dataNo[i] >> 8) & 0x00ff);
+        }
+        SetAlbumUInt32(&header[ALBUM_HEAD_INDEX_CRC], CalcAlbumCrc(index, ALBUM_FILE_INDEX_SIZE));
+    }
+
+    memcpy(&header[ALBUM_HEAD_DEVICE_VERSION], inVersion->string, 12);
+    header[ALBUM_HEAD_DEVICE_VERSION + 12] = inVersion->major;
+    header[ALBUM_HEAD_DEVICE_VERSION + 13] = inVersion->minor;
+    header[ALBUM_HEAD_DEVICE_VERSION + 14] = inVersion->relese;
+    memcpy(&header[ALBUM_HEAD_DEVICE_VERSION + 15], inVersion->revision, 4);
+
+    SetAlbumUInt32(&header[ALBUM_HEAD_USER_COUNT], (unsigned int)inUserCount);
+    SetAlbumUInt32(&header[ALBUM_HEAD_ORIGINAL_SIZE], (unsigned int)inDataSize);
+    SetAlbumUInt32(&header[ALBUM_HEAD_STORED_SIZE], (unsigned int)storeSize);
+    SetAlbumUInt32(&header[ALBUM_HEAD_DATA_CRC], CalcAlbumCrc(inAlbumData, inDataSize));
+    SetAlbumUInt32(&header[ALBUM_HEAD_HEADER_CRC], CalcAlbumCrc(header, ALBUM_HEAD_HEADER_CRC));
+
+    do {
+        pFile = fopen(inFileName, "wb");
+        if ( NULL == pFile ) {
+            ret = ALBUM_ERROR_FILE;
+            break;
+        }
+        if ( (fwrite(header, ALBUM_FILE_HEADER_SIZE, 1, pFile) != 1) || (fwrite(pStoreData, storeSize, 1, pFile) != 1) ) {
+            ret = ALBUM_ERROR_FILE;
+        }
+        else if ( isIndex && (fwrite(index, ALBUM_FILE_INDEX_SIZE, 1, pFile) != 1) ) {
+            ret = ALBUM_ERROR_FILE;
+        }
+        if ( fclose(pFile) != 0 ) {
+            ret = ALBUM_ERROR_FILE;
+        }
+    } while(0);
+
+    if ( pCompData != NULL ) {
+        free(pCompData);
+    }
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/* Load album data saved by SaveAlbumFile                                     */
+/* Files without the container header are raw device dumps written by        */
+/* SaveAlbumData; they are passed through unchecked.                          */
+/* Version 1 containers (no album index) are still read.                      */
+/* A missing file is not an error: *outDataSize is set to 0.                  */
+/* param    : const char    *inFileName     file name                         */
+/*          : HVC_VERSION   *inVersion      version of the connected device   */
+/*          :                               (NULL...skip version check)       */
+/*          : int           *outUserCount   number of registered users        */
+/*          :                               (-1...unknown, raw dump)          */
+/*          : ALBUM_INDEX   *outIndex       album index stored with the album */
+/*          :                               (NULL...not needed)               */
+/*          :                               isValid is 0 if the file has none */
+/*          : int           *outDataSize    album data size                   */
+/*          : unsigned char *outAlbumData   album data (HVC_LoadAlbum input)  */
+/*          : int           inBufferSize    size of outAlbumData              */
+/* return   : int                           execution result error code       */
+/*          :                               0...normal                        */
+/*          :                               -1...parameter error              */
+/*          :                               -2...file access error            */
+/*          :                               -3...invalid container format     */
+/*          :                               -4...CRC mismatch                 */
+/*          :                               -5...device version mismatch      */
+/*          :                               -6...album does not fit buffer    */
+/*          :                               -7...memory allocation error      */
+/*----------------------------------------------------------------------------*/
+int LoadAlbumFile(const char *inFileName, HVC_VERSION *inVersion, int *outUserCount, ALBUM_INDEX *outIndex, int *outDataSize, unsigned char *outAlbumData, int inBufferSize)
+{
+    FILE *pFile = NULL;
+    unsigned char header[ALBUM_FILE_HEADER_SIZE];
+    unsigned char index[ALBUM_FILE_INDEX_SIZE];
+    long headerSize;
+    long indexSize;
+    int i;
+    unsigned char *pStoreData = NULL;
+    long fileSize;
+    int originalSize;
+    int storeSize;
+    int ret = ALBUM_NORMAL;
+
+    if ( (NULL == inFileName) || (NULL == outUserCount) || (NULL == outDataSize) || (NULL == outAlbumData) ) {
+        return ALBUM_ERROR_PARAMETER;
+    }
+    *outUserCount = -1;
+    *outDataSize = 0;
+    if ( NULL != outIndex ) {
+        memset(outIndex->dataNo, 0, sizeof(outIndex->dataNo));
+        outIndex->isValid = 0;
+    }
+
+    pFile = fopen(inFileName, "rb");
+    if ( NULL == pFile ) {
+        return ALBUM_NORMAL;
+    }
+
+    do {
+        if ( fseek(pFile, 0, SEEK_END) != 0 ) {
+            ret = ALBUM_ERROR_FILE;
+            break;
+        }
+        fileSize = ftell(pFile);
+        fseek(pFile, 0, SEEK_SET);
+        if ( fileSize <= 0 ) {
+            ret = ALBUM_ERROR_FORMAT;
+            break;
+        }
+
+        if ( (fileSize < ALBUM_FILE_HEADER_SIZE_V1)
+          || (fread(header, ALBUM_FILE_HEADER_SIZE_V1, 1, pFile) != 1)
+          || (memcmp(&header[ALBUM_HEAD_SIGNATURE], ALBUM_FILE_SIGNATURE, ALBUM_FILE_SIGNATURE_SIZE) != 0) ) {
+            /* Raw device dump */
+            if ( fileSize > inBufferSize ) {
+                ret = ALBUM_ERROR_SIZE;
+                break;
+            }
+            fseek(pFile, 0, SEEK_SET);
+            if ( fread(outAlbumData, fileSize, 1, pFile) != 1 ) {
+                ret = ALBUM_ERROR_FILE;
+                break;
+            }
+            *outDataSize = (int)fileSize;
+            break;
+        }
+
+        /* Validate the header before touching the payload */
+        if ( header[ALBUM_HEAD_FORMAT] == ALBUM_FILE_FORMAT_V1 ) {
+            headerSize = ALBUM_FILE_HEADER_SIZE_V1;
+            if ( GetAlbumUInt32(&header[ALBUM_HEAD_HEADER_CRC_V1]) != CalcAlbumCrc(header, ALBUM_HEAD_HEADER_CRC_V1) ) {
+                ret = ALBUM_ERROR_CRC;
+                break;
+            }
+            header[ALBUM_HEAD_FLAGS] &= ALBUM_FILE_FLAG_COMPRESSED;     /* Version 1 has no album index */
+        }
+        else if ( header[ALBUM_HEAD_FORMAT] == ALBUM_FILE_FORMAT_VERSION ) {
+            headerSize = ALBUM_FILE_HEADER_SIZE;
+            if ( (fileSize < ALBUM_FILE_HEADER_SIZE)
+              || (fread(&header[ALBUM_FILE_HEADER_SIZE_V1], ALBUM_FILE_HEADER_SIZE - ALBUM_FILE_HEADER_SIZE_V1, 1, pFile) != 1) ) {
+                ret = ALBUM_ERROR_FORMAT;
+                break;
+            }
+            if ( GetAlbumUInt32(&header[ALBUM_HEAD_HEADER_CRC]) != CalcAlbumCrc(header, ALBUM_HEAD_HEADER_CRC) ) {
+                ret = ALBUM_ERROR_CRC;
+                break;
+            }
+        }
+        else {
+            ret = ALBUM_ERROR_FORMAT;
+            break;
+        }
+        if ( (NULL != inVersion)
+          && ( (memcmp(&header[ALBUM_HEAD_DEVICE_VERSION], inVersion->string, 12) != 0)
+            || (header[ALBUM_HEAD_DEVICE_VERSION + 12] != inVersion->major)
+            || (header[ALBUM_HEAD_DEVICE_VERSION + 13] != inVersion->minor) ) ) {
+            ret = ALBUM_ERROR_VERSION;
+            break;
+        }
+        originalSize = (int)GetAlbumUInt32(&header[ALBUM_HEAD_ORIGINAL_SIZE]);
+        storeSize = (int)GetAlbumUInt32(&header[ALBUM_HEAD_STORED_SIZE]);
+        indexSize = (header[ALBUM_HEAD_FLAGS] & ALBUM_FILE_FLAG_INDEX) ? ALBUM_FILE_INDEX_SIZE : 0;
+        if ( (originalSize <= 0) || (storeSize <= 0) || ((long)storeSize != fileSize - headerSize - indexSize) ) {
+            ret = ALBUM_ERROR_FORMAT;
+            break;
+        }
+        if ( originalSize > inBufferSize ) {
+            ret = ALBUM_ERROR_SIZE;
+            break;
+        }
+
+        if ( header[ALBUM_HEAD_FLAGS] & ALBUM_FILE_FLAG_COMPRESSED ) {
+            pStoreData = (unsigned char*)malloc(storeSize);
+            if ( pStoreData == NULL ) {
+                ret = ALBUM_ERROR_MEMORY;
+                break;
+            }
+            if ( fread(pStoreData, storeSize, 1, pFile) != 1 ) {
+                ret = ALBUM_ERROR_FILE;
+                break;
+            }
+            ret = DecompressAlbum(pStoreData, storeSize, outAlbumData, originalSize);
+            if ( ret != ALBUM_NORMAL ) break;
+        }
+        else {
+            if ( storeSize != originalSize ) {
+                ret = ALBUM_ERROR_FORMAT;
+                break;
+            }
+            if ( fread(outAlbumData, storeSize, 1, pFile) != 1 ) {
+                ret = ALBUM_ERROR_FILE;
+                break;
+            }
+        }
+
+        if ( GetAlbumUInt32(&header[ALBUM_HEAD_DATA_CRC]) != CalcAlbumCrc(outAlbumData, originalSize) ) {
+            ret = ALBUM_ERROR_CRC;
+            break;
+        }
+        if ( indexSize != 0 ) {
+            if ( fread(index, ALBUM_FILE_INDEX_SIZE, 1, pFile) != 1 ) {
+                ret = ALBUM_ERROR_FILE;
+                break;
+            }
+            if ( GetAlbumUInt32(&header[ALBUM_HEAD_INDEX_CRC]) != CalcAlbumCrc(index, ALBUM_FILE_INDEX_SIZE) ) {
+                ret = ALBUM_ERROR_CRC;
+                break;
+            }
+            if ( NULL != outIndex ) {
+                for ( i = 0; i < ALBUM_INDEX_USER_MAX; i++ ) {
+                    outIndex->dataNo[i] = (unsigned short)(index[i*2 + 0] + (index[i*2 + 1] << 8));
+                }
+                outIndex->isValid = 1;
+            }
+        }
+        *outUserCount = (int)GetAlbumUInt32(&header[ALBUM_HEAD_USER_COUNT]);
+        *outDataSize = originalSize;
+    } while(0);
+
+    fclose(pFile);
+    if ( pStoreData != NULL ) {
+        free(pStoreData);
+    }
+    return ret;
+}
@@ -0,0 +1,298 @@
+/*---------------------------------------------------------------------------*/
+/* Copyright(C)  2018  OMRON Corporation                                     */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*---------------------------------------------------------------------------*/
+
+#include <string.h>
+#include "AlbumIndex.h"
+
+/*----------------------------------------------------------------------------*/
+/* InitAlbumIndex                                                             */
+/* Clears the index and marks it as not built.                                */
+/* param    : ALBUM_INDEX   *pIndex         album index                       */
+/* return   : void                                                            */
+/*----------------------------------------------------------------------------*/
+void InitAlbumIndex(ALBUM_INDEX *pIndex)
+{
+    if ( NULL == pIndex ) return;
+
+    memset(pIndex->dataNo, 0, sizeof(pIndex->dataNo));
+    pIndex->isValid = 0;
+}
+
+/*----------------------------------------------------------------------------*/
+/* ScanAlbumIndex                                                             */
+/* Builds the index with one HVC_GetUserData per user ID. Only needed once:  */
+/* afterwards the *WithIndex functions keep it up to date, and it can be      */
+/* stored together with the album (SaveAlbumFile/LoadAlbumFile).              */
+/* param    : ALBUM_INDEX   *pIndex         album index                       */
+/*          : INT32         inTimeOutTime   timeout time (ms)                 */
+/*          : UINT8         *outStatus      response code                     */
+/* return   : INT32                         execution result error code       */
+/*          :                               0...normal                        */
+/*          :                               -1...parameter error              */
+/*          :                               other...signal error              */
+/*----------------------------------------------------------------------------*/
+INT32 ScanAlbumIndex(ALBUM_INDEX *pIndex, INT32 inTimeOutTime, UINT8 *outStatus)
+{
+    INT32 ret = 0;
+    INT32 userID;
+    INT32 dataNo;
+
+    if((NULL == pIndex) || (NULL == outStatus)){
+        return HVC_ERROR_PARAMETER;
+    }
+
+    InitAlbumIndex(pIndex);
+    for ( userID = 0; userID < ALBUM_INDEX_USER_MAX; userID++ ) {
+        dataNo = 0;
+        ret = HVC_GetUserData(inTimeOutTime, userID, &dataNo, outStatus);
+        if ( (ret != 0) || (*outStatus != 0) ) {
+            return ret;
+        }
+        pIndex->dataNo[userID] = (unsigned short)dataNo;
+    }
+    pIndex->isValid = 1;
+    return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+/* RegistrationWithIndex                                                      */
+/* HVC_Registration that also records the new data ID in the index.          */
+/* A signal error leaves the device state unknown and invalidates the index.  */
+/* param    : ALBUM_INDEX   *pIndex         album index                       */
+/*          : INT32         inTimeOutTime   timeout time (ms)                 */
+/*          : INT32         inUserID        User ID (0-499)                   */
+/*          : INT32         inDataID        Data ID (0-9)                     */
+/*          : HVC_IMAGE     *outImage       image info (NULL...discard)       */
+/*          : UINT8         *outStatus      response code                     */
+/* return   : INT32                         execution result error code       */
+/*          :                               0...normal                        */
+/*          :                               -1...parameter error              */
+/*          :                               other...signal error              */
+/*----------------------------------------------------------------------------*/
+INT32 RegistrationWithIndex(ALBUM_INDEX *pIndex, INT32 inTimeOutTime, INT32 inUserID, INT32 inDataID, HVC_IMAGE *outImage, UINT8 *outStatus)
+{
+    INT32 ret = 0;
+
+    if((NULL == pIndex) || (NULL == outStatus)
+    || (inUserID < 0) || (inUserID >= ALBUM_INDEX_USER_MAX) || (inDataID < 0) || (inDataID >= ALBUM_INDEX_DATA_MAX)){
+        return HVC_ERROR_PARAMETER;
+    }
+
+    ret = HVC_Registration(inTimeOutTime, inUserID, inDataID, outImage, outStatus);
+    if ( ret != 0 ) {
+        pIndex->isValid = 0;
+    }
+    else if ( *outStatus == 0 ) {
+        pIndex->dataNo[inUserID] |= (unsigned short)(1 << inDataID);
+    }
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/* DeleteDataWithIndex                                                        */
+/* param    : ALBUM_INDEX   *pIndex         album index                       */
+/*          : INT32         inTimeOutTime   timeout time (ms)                 */
+/*          : INT32         inUserID        User ID (0-499)                   */
+/*          : INT32         inDataID        Data ID (0-9)                     */
+/*          : UINT8         *outStatus      response code                     */
+/* return   : INT32                         execution result error code       */
+/*          :                               0...normal                        */
+/*          :                               -1...parameter error              */
+/*          :                               other...signal error              */
+/*----------------------------------------------------------------------------*/
+INT32 DeleteDataWithIndex(ALBUM_INDEX *pIndex, INT32 inTimeOutTime, INT32 inUserID, INT32 inDataID, UINT8 *outStatus)
+{
+    INT32 ret = 0;
+
+    if((NULL == pIndex) || (NULL == outStatus)
+    || (inUserID < 0) || (inUserID >= ALBUM_INDEX_USER_MAX) || (inDataID < 0) || (inDataID >= ALBUM_INDEX_DATA_MAX)){
+        return HVC_ERROR_PARAMETER;
+    }
+
+    ret = HVC_DeleteData(inTimeOutTime, inUserID, inDataID, outStatus);
+    if ( ret != 0 ) {
+        pIndex->isValid = 0;
+    }
+    else if ( *outStatus == 0 ) {
+        pIndex->dataNo[inUserID] &= (unsigned short)~(1 << inDataID);
+    }
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/* DeleteUserWithIndex                                                        */
+/* param    : ALBUM_INDEX   *pIndex         album index                       */
+/*          : INT32         inTimeOutTime   timeout time (ms)                 */
+/*          : INT32         inUserID        User ID (0-499)                   */
+/*          : UINT8         *outStatus      response code                     */
+/* return   : INT32                         execution result error code       */
+/*          :                               0...normal                        */
+/*          :                               -1...parameter error              */
+/*          :                               other...signal error              */
+/*----------------------------------------------------------------------------*/
+INT32 DeleteUserWithIndex(ALBUM_INDEX *pIndex, INT32 inTimeOutTime, INT32 inUserID, UINT8 *outStatus)
+{
+    INT32 ret = 0;
+
+    if((NULL == pIndex) || (NULL == outStatus) || (inUserID < 0) || (inUserID >= ALBUM_INDEX_USER_MAX)){
+        return HVC_ERROR_PARAMETER;
+    }
+
+    ret = HVC_DeleteUser(inTimeOutTime, inUserID, outStatus);
+    if ( ret != 0 ) {
+        pIndex->isValid = 0;
+    }
+    else if ( *outStatus == 0 ) {
+        pIndex->dataNo[inUserID] = 0;
+    }
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/* DeleteAllWithIndex                                                         */
+/* An empty album is fully known, so this also validates the index.          */
+/* param    : ALBUM_INDEX   *pIndex         album index                       */
+/*          : INT32         inTimeOutTime   timeout time (ms)                 */
+/*          : UINT8         *outStatus      response code                     */
+/* return   : INT32                         execution result error code       */
+/*          :                               0...normal                        */
+/*          :                               -1...parameter error              */
+/*          :                               other...signal error              */
+/*----------------------------------------------------------------------------*/
+INT32 DeleteAllWithIndex(ALBUM_INDEX *pIndex, INT32 inTimeOutTime, UINT8 *outStatus)
+{
+    INT32 ret = 0;
+
+    if((NULL == pIndex) || (NULL == outStatus)){
+        return HVC_ERROR_PARAMETER;
+    }
+
+    ret = HVC_DeleteAll(inTimeOutTime, outStatus);
+    if ( ret != 0 ) {
+        pIndex->isValid = 0;
+    }
+    else if ( *outStatus == 0 ) {
+        memset(pIndex->dataNo, 0, sizeof(pIndex->dataNo));
+        pIndex->isValid = 1;
+    }
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/* GetIndexedUserData                                                         */
+/* HVC_GetUserData answered from the index, without UART access.             */
+/* param    : ALBUM_INDEX   *pIndex         album index                       */
+/*          : INT32         inUserID        User ID (0-499)                   */
+/*          : INT32         *outDataNo      registration info                 */
+/* return   : INT32                         execution result error code       */
+/*          :                               0...normal                        */
+/*          :                               -1...parameter error              */
+/*          :                               -30...index not valid             */
+/*----------------------------------------------------------------------------*/
+INT32 GetIndexedUserData(ALBUM_INDEX *pIndex, INT32 inUserID, INT32 *outDataNo)
+{
+    if((NULL == pIndex) || (NULL == outDataNo) || (inUserID < 0) || (inUserID >= ALBUM_INDEX_USER_MAX)){
+        return HVC_ERROR_PARAMETER;
+    }
+    if ( !pIndex->isValid ) {
+        return ALBUM_INDEX_ERROR_INVALID;
+    }
+
+    *outDataNo = pIndex->dataNo[inUserID];
+    return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+/* FindFreeDataID                                                             */
+/* param    : ALBUM_INDEX   *pIndex         album index                       */
+/*          : INT32         inUserID        User ID (0-499)                   */
+/* return   : INT32                         lowest unused data ID             */
+/*          :                               -1...no free slot or parameter    */
+/*          :                                    error                        */
+/*          :                               -30...index not valid             */
+/*----------------------------------------------------------------------------*/
+INT32 FindFreeDataID(ALBUM_INDEX *pIndex, INT32 inUserID)
+{
+    INT32 dataID;
+
+    if((NULL == pIndex) || (inUserID < 0) || (inUserID >= ALBUM_INDEX_USER_MAX)){
+        return -1;
+    }
+    if ( !pIndex->isValid ) {
+        return ALBUM_INDEX_ERROR_INVALID;
+    }
+
+    for ( dataID = 0; dataID < ALBUM_INDEX_DATA_MAX; dataID++ ) {
+        if ( (pIndex->dataNo[inUserID] & (1 << dataID)) == 0 ) {
+            return dataID;
+        }
+    }
+    return -1;
+}
+
+/*----------------------------------------------------------------------------*/
+/* FindFreeUserID                                                             */
+/* param    : ALBUM_INDEX   *pIndex         album index                       */
+/* return   : INT32                         lowest user ID without data       */
+/*          :                               -1...album full or parameter      */
+/*          :                                    error                        */
+/*          :                               -30...index not valid             */
+/*----------------------------------------------------------------------------*/
+INT32 FindFreeUserID(ALBUM_INDEX *pIndex)
+{
+    INT32 userID;
+
+    if ( NULL == pIndex ) {
+        return -1;
+    }
+    if ( !pIndex->isValid ) {
+        return ALBUM_INDEX_ERROR_INVALID;
+    }
+
+    for ( userID = 0; userID < ALBUM_INDEX_USER_MAX; userID++ ) {
+        if ( pIndex->dataNo[userID] == 0 ) {
+            return userID;
+        }
+    }
+    return -1;
+}
+
+/*----------------------------------------------------------------------------*/
+/* GetIndexedUserCount                                                        */
+/* param    : ALBUM_INDEX   *pIndex         album index                       */
+/* return   : INT32                         number of users with data         */
+/*          :                               -1...parameter error              */
+/*          :                               -30...index not valid             */
+/*----------------------------------------------------------------------------*/
+INT32 GetIndexedUserCount(ALBUM_INDEX *pIndex)
+{
+    INT32 userID;
+    INT32 count = 0;
+
+    if ( NULL == pIndex ) {
+        return -1;
+    }
+    if ( !pIndex->isValid ) {
+        return ALBUM_INDEX_ERROR_INVALID;
+    }
+
+    for ( userID = 0; userID < ALBUM_INDEX_USER_MAX; userID++ ) {
+        if ( pIndex->dataNo[userID] != 0 ) {
+            count++;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,108 @@
+/*---------------------------------------------------------------------------*/
+/* Copyright(C)  2018  OMRON Corporation                                     */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*---------------------------------------------------------------------------*/
+
+/* 
+    Host-side album index
+*/
+
+#ifndef AlbumIndex_H__
+#define AlbumIndex_H__
+
+#include "HVCApi.h"
+
+#define ALBUM_INDEX_USER_MAX        500             /* User ID 0-499 */
+#define ALBUM_INDEX_DATA_MAX        10              /* Data ID 0-9 */
+
+#define ALBUM_INDEX_ERROR_INVALID   -30             /* Index not built or out of sync with the device */
+
+/*----------------------------------------------------------------------------*/
+/* Album index                                                                */
+/* Registered data IDs of every user, in the HVC_GetUserData bit layout       */
+/* (bit n set...data ID n registered).                                        */
+/*----------------------------------------------------------------------------*/
+typedef struct{
+    INT32           isValid;                        /* 1...dataNo mirrors the device album */
+    unsigned short  dataNo[ALBUM_INDEX_USER_MAX];   /* Registered data IDs of each user */
+}ALBUM_INDEX;
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/* InitAlbumIndex                                                             */
+/* param    : ALBUM_INDEX   *pIndex         album index                       */
+void  InitAlbumIndex(ALBUM_INDEX *pIndex);
+
+/* ScanAlbumIndex                                                             */
+/* param    : ALBUM_INDEX   *pIndex         album index                       */
+/*          : INT32         inTimeOutTime   timeout time (ms)                 */
+/*          : UINT8         *outStatus      response code                     */
+INT32 ScanAlbumIndex(ALBUM_INDEX *pIndex, INT32 inTimeOutTime, UINT8 *outStatus);
+
+/* RegistrationWithIndex                                                      */
+/* param    : ALBUM_INDEX   *pIndex         album index                       */
+/*          : INT32         inTimeOutTime   timeout time (ms)                 */
+/*          : INT32         inUserID        User ID (0-499)                   */
+/*          : INT32         inDataID        Data ID (0-9)                     */
+/*          : HVC_IMAGE     *outImage       image info (NULL...discard)       */
+/*          : UINT8         *outStatus      response code                     */
+INT32 RegistrationWithIndex(ALBUM_INDEX *pIndex, INT32 inTimeOutTime, INT32 inUserID, INT32 inDataID, HVC_IMAGE *outImage, UINT8 *outStatus);
+
+/* DeleteDataWithIndex                                                        */
+/* param    : ALBUM_INDEX   *pIndex         album index                       */
+/*          : INT32         inTimeOutTime   timeout time (ms)                 */
+/*          : INT32         inUserID        User ID (0-499)                   */
+/*          : INT32         inDataID        Data ID (0-9)                     */
+/*          : UINT8         *outStatus      response code                     */
+INT32 DeleteDataWithIndex(ALBUM_INDEX *pIndex, INT32 inTimeOutTime, INT32 inUserID, INT32 inDataID, UINT8 *outStatus);
+
+/* DeleteUserWithIndex                                                        */
+/* param    : ALBUM_INDEX   *pIndex         album index                       */
+/*          : INT32         inTimeOutTime   timeout time (ms)                 */
+/*          : INT32         inUserID        User ID (0-499)                   */
+/*          : UINT8         *outStatus      response code                     */
+INT32 DeleteUserWithIndex(ALBUM_INDEX *pIndex, INT32 inTimeOutTime, INT32 inUserID, UINT8 *outStatus);
+
+/* DeleteAllWithIndex                                                         */
+/* param    : ALBUM_INDEX   *pIndex         album index                       */
+/*          : INT32         inTimeOutTime   timeout time (ms)                 */
+/*          : UINT8         *outStatus      response code                     */
+INT32 DeleteAllWithIndex(ALBUM_INDEX *pIndex, INT32 inTimeOutTime, UINT8 *outStatus);
+
+/* GetIndexedUserData                                                         */
+/* param    : ALBUM_INDEX   *pIndex         album index                       */
+/*          : INT32         inUserID        User ID (0-499)                   */
+/*          : INT32         *outDataNo      registration info                 */
+INT32 GetIndexedUserData(ALBUM_INDEX *pIndex, INT32 inUserID, INT32 *outDataNo);
+
+/* FindFreeDataID                                                             */
+/* param    : ALBUM_INDEX   *pIndex         album index                       */
+/*          : INT32         inUserID        User ID (0-499)                   */
+INT32 FindFreeDataID(ALBUM_INDEX *pIndex, INT32 inUserID);
+
+/* FindFreeUserID                                                             */
+/* param    : ALBUM_INDEX   *pIndex         album index                       */
+INT32 FindFreeUserID(ALBUM_INDEX *pIndex);
+
+/* GetIndexedUserCount                                                        */
+/* param    : ALBUM_INDEX   *pIndex         album index                       */
+INT32 GetIndexedUserCount(ALBUM_INDEX *pIndex);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif  /* AlbumIndex_H__ */
@@ -30,6 +30,7 @@
 #include "HVCApi.h"
 #include "HVCDef.h"
 #include "HVCExtraUartFunc.h"
+#include "AlbumIndex.h"
 #include "STBWrap.h"
 
 #define LOGBUFFERSIZE   8192
@@ -72,14 +73,14 @@
 
 #ifdef WIN32
 void SaveBitmapFile(int nWidth, int nHeight, UINT8 *unImageBuffer, const char *szFileName);
-void LoadAlbumData(const char *inFileName, int *outDataSize, unsigned char *outAlbumData);
 #else
 void SaveBitmapFile(int nWidth, int nHeight, unsigned char *unImageBuffer, const char *szFileName);
 #define sprintf_s(buf, num, ...) sprintf(buf, __VA_ARGS__)
-void LoadAlbumData(const char *inFileName, int *outDataSize, unsigned char *outAlbumData);
 int kbhit(void);
 #endif
 
+int LoadAlbumFile(const char *inFileName, HVC_VERSION *inVersion, int *outUserCount, ALBUM_INDEX *outIndex, int *outDataSize, unsigned char *outAlbumData, int inBufferSize);
+
 /*----------------------------------------------------------------------------*/
 /* UART send signal                                                           */
 /* param    : int   inDataSize  send signal data                              */
@@ -107,6 +108,30 @@ int UART_ReceiveData(int inTimeOutTime, int inDataSize, UINT8 *outResult)
     return ret;
 }
 
+/*----------------------------------------------------------------------------*/
+/* UART cancel receive                                                        */
+/* param    : void                                                            */
+/* return   : void                                                            */
+/*----------------------------------------------------------------------------*/
+void UART_CancelReceive(void)
+{
+    /* UART cancel receive */
+    com_cancel();
+}
+
+/*----------------------------------------------------------------------------*/
+/* UART drain receive                                                         */
+/* param    : int   inQuietTime     quiet time (ms)                           */
+/*          : int   inTimeOutTime   timeout time (ms)                         */
+/* return   : int                   discarded data number                     */
+/*----------------------------------------------------------------------------*/
+int UART_DrainData(int inQuietTime, int inTimeOutTime)
+{
+    /* UART drain receive */
+    int ret = com_drain(inQuietTime, inTimeOutTime);
+    return ret;
+}
+
 /* Print Log Message */
 static void PrintLog(char *pStr)
 {
@@ -149,6 +174,7 @@ int main(int argc, char *argv[])
     
     UINT8 *pAlbumData = NULL;
     INT32 albumDataSize = 0;
+    INT32 albumUserCount = 0;
     
     int i;
     int ch = 0;
@@ -388,7 +414,11 @@ int main(int argc, char *argv[])
         /*********************************/
         /* Load Album                    */
         /*********************************/
-        LoadAlbumData("HVCAlbum.alb", &albumDataSize, pAlbumData);
+        ret = LoadAlbumFile("HVCAlbum.alb", &version, &albumUserCount, NULL, &albumDataSize, pAlbumData, HVC_ALBUM_SIZE_MAX + 8);
+        if ( ret != 0 ) {
+            sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nLoadAlbumFile(HVCAlbum.alb) Error : %d\n", ret);
+            break;
+        }
         if ( albumDataSize != 0 ) {
             ret = HVC_LoadAlbum(UART_LOAD_ALBUM_TIMEOUT, pAlbumData, albumDataSize, &status);
             if ( ret != 0 ) {
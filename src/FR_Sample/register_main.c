@@ -14,11 +14,13 @@
 /* limitations under the License.                                            */
 /*---------------------------------------------------------------------------*/
 #ifdef WIN32
+#include <windows.h>
 #include <conio.h>
 #else
 #include <termios.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <pthread.h>
 #endif
 #include <ctype.h>
 #include <stdio.h>
@@ -29,6 +31,7 @@
 #include "HVCApi.h"
 #include "HVCDef.h"
 #include "HVCExtraUartFunc.h"
+#include "AlbumIndex.h"
 
 #define LOGBUFFERSIZE   8192
 
@@ -57,6 +60,16 @@
 
 #define REGISTER_USERID_NUMBER               0            /* Registered user ID number */
 
+#define ALBUM_FILE_NAME          "HVCAlbum.alb"           /* Album file name */
+#define ALBUM_FILE_COMPRESS                  1            /* Compress album file (0:store 1:compress) */
+
+#define BATCH_MANIFEST_LINE_MAX            256            /* Maximum length of a manifest line */
+#define BATCH_IMAGE_QUEUE_SIZE              16            /* Registration images waiting to be written */
+#define BATCH_IMAGE_SIZE               (64*64)            /* Registration image size */
+
+#define IMAGE_OFF                            0            /* Do not save registration images */
+#define IMAGE_ON                             1            /* Save registration images */
+
 
 #ifndef WIN32
 void SaveBitmapFile(int nWidth, int nHeight, unsigned char *unImageBuffer, const char *szFileName);
@@ -67,8 +80,60 @@ void SaveBitmapFile(int nWidth, int nHeight, UINT8 *unImageBuffer, const char *s
 
 #endif
 
-void SaveAlbumData(const char *inFileName, int inDataSize, unsigned char *inAlbumData);
-void LoadAlbumData(const char *inFileName, int *outDataSize, unsigned char *outAlbumData);
+#ifdef WIN32
+typedef CRITICAL_SECTION    BATCH_LOCK;
+typedef CONDITION_VARIABLE  BATCH_COND;
+typedef HANDLE              BATCH_THREAD;
+#define BatchLockInit(pLock)            InitializeCriticalSection(pLock)
+#define BatchLockTerm(pLock)            DeleteCriticalSection(pLock)
+#define BatchLock(pLock)                EnterCriticalSection(pLock)
+#define BatchUnlock(pLock)              LeaveCriticalSection(pLock)
+#define BatchCondInit(pCond)            InitializeConditionVariable(pCond)
+#define BatchCondTerm(pCond)
+#define BatchCondWait(pCond, pLock)     SleepConditionVariableCS(pCond, pLock, INFINITE)
+#define BatchCondSignal(pCond)          WakeConditionVariable(pCond)
+#else
+typedef pthread_mutex_t     BATCH_LOCK;
+typedef pthread_cond_t      BATCH_COND;
+typedef pthread_t           BATCH_THREAD;
+#define BatchLockInit(pLock)            pthread_mutex_init(pLock, NULL)
+#define BatchLockTerm(pLock)            pthread_mutex_destroy(pLock)
+#define BatchLock(pLock)                pthread_mutex_lock(pLock)
+#define BatchUnlock(pLock)              pthread_mutex_unlock(pLock)
+#define BatchCondInit(pCond)            pthread_cond_init(pCond, NULL)
+#define BatchCondTerm(pCond)            pthread_cond_destroy(pCond)
+#define BatchCondWait(pCond, pLock)     pthread_cond_wait(pCond, pLock)
+#define BatchCondSignal(pCond)          pthread_cond_signal(pCond)
+#endif
+
+/* Manifest entry */
+typedef struct {
+    INT32 userID;
+    INT32 dataID;
+} BATCH_SLOT;
+
+/* Registration image waiting to be written */
+typedef struct {
+    INT32 width;
+    INT32 height;
+    UINT8 image[BATCH_IMAGE_SIZE];
+    char  fileName[64];
+} BATCH_IMAGE;
+
+/* Registration image writer */
+typedef struct {
+    BATCH_IMAGE  entry[BATCH_IMAGE_QUEUE_SIZE];
+    int          head;
+    int          count;
+    int          isEnd;
+    BATCH_LOCK   lock;
+    BATCH_COND   notEmpty;
+    BATCH_COND   notFull;
+    BATCH_THREAD thread;
+} BATCH_IMAGE_WRITER;
+
+int SaveAlbumFile(const char *inFileName, HVC_VERSION *inVersion, int inUserCount, ALBUM_INDEX *inIndex, int inCompress, int inDataSize, unsigned char *inAlbumData);
+int LoadAlbumFile(const char *inFileName, HVC_VERSION *inVersion, int *outUserCount, ALBUM_INDEX *outIndex, int *outDataSize, unsigned char *outAlbumData, int inBufferSize);
 
 /*----------------------------------------------------------------------------*/
 /* UART send signal                                                           */
@@ -97,17 +162,307 @@ int UART_ReceiveData(int inTimeOutTime, int inDataSize, UINT8 *outResult)
     return ret;
 }
 
+/*----------------------------------------------------------------------------*/
+/* UART cancel receive                                                        */
+/* param    : void                                                            */
+/* return   : void                                                            */
+/*----------------------------------------------------------------------------*/
+void UART_CancelReceive(void)
+{
+    /* UART cancel receive */
+    com_cancel();
+}
+
+/*----------------------------------------------------------------------------*/
+/* UART drain receive                                                         */
+/* param    : int   inQuietTime     quiet time (ms)                           */
+/*          : int   inTimeOutTime   timeout time (ms)                         */
+/* return   : int                   discarded data number                     */
+/*----------------------------------------------------------------------------*/
+int UART_DrainData(int inQuietTime, int inTimeOutTime)
+{
+    /* UART drain receive */
+    int ret = com_drain(inQuietTime, inTimeOutTime);
+    return ret;
+}
+
 /* Print Log Message */
 static void PrintLog(char *pStr)
 {
     puts(pStr);
 }
 
+/*----------------------------------------------------------------------------*/
+/* Registration image writer thread                                           */
+/* Writes queued registration images until the queue is closed and empty.    */
+/*----------------------------------------------------------------------------*/
+#ifdef WIN32
+static DWORD WINAPI BatchImageWriterThread(LPVOID pParam)
+#else
+static void *BatchImageWriterThread(void *pParam)
+#endif
+{
+    BATCH_IMAGE_WRITER *pWriter = (BATCH_IMAGE_WRITER *)pParam;
+    BATCH_IMAGE *pEntry;
+
+    for ( ;; ) {
+        BatchLock(&pWriter->lock);
+        while ( (pWriter->count == 0) && !pWriter->isEnd ) {
+            BatchCondWait(&pWriter->notEmpty, &pWriter->lock);
+        }
+        if ( pWriter->count == 0 ) {
+            BatchUnlock(&pWriter->lock);
+            break;
+        }
+        pEntry = &pWriter->entry[pWriter->head];
+        BatchUnlock(&pWriter->lock);
+
+        /* The slot stays owned by this thread until it is released below */
+        SaveBitmapFile(pEntry->width, pEntry->height, pEntry->image, pEntry->fileName);
+
+        BatchLock(&pWriter->lock);
+        pWriter->head = (pWriter->head + 1) % BATCH_IMAGE_QUEUE_SIZE;
+        pWriter->count--;
+        BatchCondSignal(&pWriter->notFull);
+        BatchUnlock(&pWriter->lock);
+    }
+    return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+/* Start registration image writer                                            */
+/* param    : BATCH_IMAGE_WRITER *pWriter   image writer                      */
+/* return   : int                           0...normal, -1...error            */
+/*----------------------------------------------------------------------------*/
+static int StartBatchImageWriter(BATCH_IMAGE_WRITER *pWriter)
+{
+    pWriter->head = 0;
+    pWriter->count = 0;
+    pWriter->isEnd = 0;
+    BatchLockInit(&pWriter->lock);
+    BatchCondInit(&pWriter->notEmpty);
+    BatchCondInit(&pWriter->notFull);
+#ifdef WIN32
+    pWriter->thread = CreateThread(NULL, 0, BatchImageWriterThread, pWriter, 0, NULL);
+    if ( pWriter->thread == NULL ) {
+#else
+    if ( pthread_create(&pWriter->thread, NULL, BatchImageWriterThread, pWriter) != 0 ) {
+#endif
+        BatchCondTerm(&pWriter->notFull);
+        BatchCondTerm(&pWriter->notEmpty);
+        BatchLockTerm(&pWriter->lock);
+        return -1;
+    }
+    return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+/* Queue a registration image                                                 */
+/* Blocks only while BATCH_IMAGE_QUEUE_SIZE images are still being written.   */
+/*----------------------------------------------------------------------------*/
+static void PushBatchImage(BATCH_IMAGE_WRITER *pWriter, HVC_IMAGE *pImage, INT32 userID, INT32 dataID)
+{
+    BATCH_IMAGE *pEntry;
+
+    BatchLock(&pWriter->lock);
+    while ( pWriter->count == BATCH_IMAGE_QUEUE_SIZE ) {
+        BatchCondWait(&pWriter->notFull, &pWriter->lock);
+    }
+    pEntry = &pWriter->entry[(pWriter->head + pWriter->count) % BATCH_IMAGE_QUEUE_SIZE];
+    BatchUnlock(&pWriter->lock);
+
+    /* The free slot is not visible to the writer until count is raised */
+    pEntry->width = pImage->width;
+    pEntry->height = pImage->height;
+    if ( pEntry->width * pEntry->height > BATCH_IMAGE_SIZE ) {
+        pEntry->width = 64;
+        pEntry->height = 64;
+    }
+    memcpy(pEntry->image, pImage->image, pEntry->width * pEntry->height);
+    sprintf_s(pEntry->fileName, sizeof(pEntry->fileName), "RegisterImage_%03d_%d.bmp", userID, dataID);
+
+    BatchLock(&pWriter->lock);
+    pWriter->count++;
+    BatchCondSignal(&pWriter->notEmpty);
+    BatchUnlock(&pWriter->lock);
+}
+
+/*----------------------------------------------------------------------------*/
+/* Stop registration image writer after all queued images are written         */
+/*----------------------------------------------------------------------------*/
+static void StopBatchImageWriter(BATCH_IMAGE_WRITER *pWriter)
+{
+    BatchLock(&pWriter->lock);
+    pWriter->isEnd = 1;
+    BatchCondSignal(&pWriter->notEmpty);
+    BatchUnlock(&pWriter->lock);
+#ifdef WIN32
+    WaitForSingleObject(pWriter->thread, INFINITE);
+    CloseHandle(pWriter->thread);
+#else
+    pthread_join(pWriter->thread, NULL);
+#endif
+    BatchCondTerm(&pWriter->notFull);
+    BatchCondTerm(&pWriter->notEmpty);
+    BatchLockTerm(&pWriter->lock);
+}
+
+/*----------------------------------------------------------------------------*/
+/* Load batch registration manifest                                           */
+/* One "userID dataID" pair per line, '#' starts a comment.                   */
+/* param    : const char    *inFileName     manifest file name                */
+/*          : BATCH_SLOT    **outSlot       manifest entries (malloc)         */
+/*          : INT32         *outSlotNum     number of manifest entries        */
+/*          : char          *pStr           log buffer                        */
+/* return   : int                           0...normal, -1...error            */
+/*----------------------------------------------------------------------------*/
+static int LoadBatchManifest(const char *inFileName, BATCH_SLOT **outSlot, INT32 *outSlotNum, char *pStr)
+{
+    FILE *pFile = NULL;
+    char line[BATCH_MANIFEST_LINE_MAX];
+    char *pComment;
+    BATCH_SLOT *pSlot = NULL;
+    INT32 slotNum = 0;
+    INT32 slotMax = 64;
+    INT32 lineNo = 0;
+    int userID, dataID;
+    int ret = 0;
+
+    *outSlot = NULL;
+    *outSlotNum = 0;
+
+    pFile = fopen(inFileName, "r");
+    if ( NULL == pFile ) {
+        sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nFailed to open manifest : %s\n", inFileName);
+        return -1;
+    }
+
+    pSlot = (BATCH_SLOT *)malloc(sizeof(BATCH_SLOT) * slotMax);
+    while ( (pSlot != NULL) && (fgets(line, sizeof(line), pFile) != NULL) ) {
+        lineNo++;
+        line[strcspn(line, "\r\n")] = '\0';
+        pComment = strchr(line, '#');
+        if ( pComment != NULL ) {
+            *pComment = '\0';
+        }
+        if ( strspn(line, " \t") == strlen(line) ) continue;
+
+        if ( (sscanf(line, "%d %d", &userID, &dataID) != 2)
+          || (userID < 0) || (userID > 499) || (dataID < 0) || (dataID > 9) ) {
+            sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nInvalid manifest entry (line %d) : %s\n", (int)lineNo, line);
+            ret = -1;
+            break;
+        }
+        if ( slotNum == slotMax ) {
+            BATCH_SLOT *pNewSlot = (BATCH_SLOT *)realloc(pSlot, sizeof(BATCH_SLOT) * slotMax * 2);
+            if ( pNewSlot == NULL ) {
+                free(pSlot);
+                pSlot = NULL;
+                break;
+            }
+            pSlot = pNewSlot;
+            slotMax *= 2;
+        }
+        pSlot[slotNum].userID = userID;
+        pSlot[slotNum].dataID = dataID;
+        slotNum++;
+    }
+    fclose(pFile);
+
+    if ( pSlot == NULL ) {
+        sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nMemory Allocation Error : manifest\n");
+        return -1;
+    }
+    if ( ret != 0 ) {
+        free(pSlot);
+        return ret;
+    }
+    *outSlot = pSlot;
+    *outSlotNum = slotNum;
+    return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+/* Batch registration                                                         */
+/* Registers every manifest entry back-to-back without per-entry              */
+/* HVC_GetUserData round trips. Registration images are written by a          */
+/* background thread, or discarded when inSaveImage is IMAGE_OFF.             */
+/* A rejected registration (non-zero response code) is reported and skipped; */
+/* a communication error ends the batch.                                      */
+/* param    : const char    *inManifest     manifest file name                */
+/*          : int           inSaveImage     IMAGE_ON / IMAGE_OFF              */
+/*          : HVC_IMAGE     *pImage         image buffer                      */
+/*          : ALBUM_INDEX   *pIndex         album index                       */
+/*          : char          *pStr           log buffer                        */
+/* return   : INT32                         execution result error code       */
+/*          :                               0...normal                        */
+/*          :                               other...error                     */
+/*----------------------------------------------------------------------------*/
+static INT32 ExecuteBatchRegistration(const char *inManifest, int inSaveImage, HVC_IMAGE *pImage, ALBUM_INDEX *pIndex, char *pStr)
+{
+    BATCH_SLOT *pSlot = NULL;
+    INT32 slotNum = 0;
+    BATCH_IMAGE_WRITER *pWriter = NULL;
+    UINT8 status;
+    INT32 ret = 0;
+    INT32 okNum = 0;
+    INT32 ngNum = 0;
+    INT32 i;
+    char msg[128];
+
+    if ( LoadBatchManifest(inManifest, &pSlot, &slotNum, pStr) != 0 ) {
+        return -1;
+    }
+
+    do {
+        if ( inSaveImage == IMAGE_ON ) {
+            pWriter = (BATCH_IMAGE_WRITER *)malloc(sizeof(BATCH_IMAGE_WRITER));
+            if ( (pWriter == NULL) || (StartBatchImageWriter(pWriter) != 0) ) {
+                sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nFailed to start image writer.\n");
+                free(pWriter);
+                pWriter = NULL;
+                ret = -1;
+                break;
+            }
+        }
+
+        for ( i = 0; i < slotNum; i++ ) {
+            ret = RegistrationWithIndex(pIndex, UART_REGIST_EXECUTE_TIMEOUT, pSlot[i].userID, pSlot[i].dataID,
+                                        (pWriter != NULL) ? pImage : NULL, &status);
+            if ( ret != 0 ) {
+                sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nHVCApi(HVC_Registration) Error : %d (User %d Data %d)\n", ret, pSlot[i].userID, pSlot[i].dataID);
+                break;
+            }
+            if ( status != 0 ) {
+                sprintf_s(msg, sizeof(msg), "[%d/%d] User %3d Data %d : Registration Error 0x%02X", (int)(i+1), (int)slotNum, pSlot[i].userID, pSlot[i].dataID, status);
+                PrintLog(msg);
+                ngNum++;
+                continue;
+            }
+            if ( pWriter != NULL ) {
+                PushBatchImage(pWriter, pImage, pSlot[i].userID, pSlot[i].dataID);
+            }
+            sprintf_s(msg, sizeof(msg), "[%d/%d] User %3d Data %d : Registration complete", (int)(i+1), (int)slotNum, pSlot[i].userID, pSlot[i].dataID);
+            PrintLog(msg);
+            okNum++;
+        }
+        sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nBatch registration : %d complete, %d failed, %d skipped", (int)okNum, (int)ngNum, (int)(slotNum - okNum - ngNum));
+    } while(0);
+
+    if ( pWriter != NULL ) {
+        StopBatchImageWriter(pWriter);
+        free(pWriter);
+    }
+    free(pSlot);
+    return ret;
+}
+
 
 /* HVC Execute Processing  */
 int main(int argc, char *argv[])
 {
     INT32 ret = 0;  /* Return code */
+    INT32 batchRet = 0;     /* Batch registration result (exit code) */
 
     INT32 inRate;
     int listBaudRate[] = {
@@ -127,16 +482,21 @@ int main(int argc, char *argv[])
     INT32 timeOutTime;
     INT32 userID;
     INT32 dataID;
-    INT32 dataNo;
+    INT32 dataNo = 0;
 
     UINT8 *pAlbumData = NULL;
     INT32 albumDataSize = 0;
+    INT32 albumUserCount = 0;
+    ALBUM_INDEX albumIndex;
 
     int i;
     int ch = 0;
     int revision;
     char *pStr;                     /* String Buffer for logging output */
 
+    char *pManifest = NULL;         /* Batch registration manifest */
+    int saveImage = IMAGE_OFF;      /* Save registration images in batch mode */
+
     S_STAT serialStat;              /* Serial port set value */
 
     serialStat.com_num = 0;
@@ -174,6 +534,15 @@ int main(int argc, char *argv[])
         }
     }
 
+    if ( argc >= 4 ) {
+        pManifest = argv[3];
+    }
+    if ( argc >= 5 ) {
+        if ( strcmp(argv[4], "IMAGE_ON") == 0 ) {
+            saveImage = IMAGE_ON;
+        }
+    }
+
     /*****************************/
     /* Logging Buffer allocation */
     /*****************************/
@@ -250,7 +619,11 @@ int main(int argc, char *argv[])
         /*********************************/
         /* Load Album                    */
         /*********************************/
-        LoadAlbumData("HVCAlbum.alb", &albumDataSize, pAlbumData);
+        ret = LoadAlbumFile(ALBUM_FILE_NAME, &version, &albumUserCount, &albumIndex, &albumDataSize, pAlbumData, HVC_ALBUM_SIZE_MAX + 8);
+        if ( ret != 0 ) {
+            sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nLoadAlbumFile(%s) Error : %d\n", ALBUM_FILE_NAME, ret);
+            break;
+        }
         if ( albumDataSize != 0 ) {
             ret = HVC_LoadAlbum(UART_LOAD_ALBUM_TIMEOUT, pAlbumData, albumDataSize, &status);
             if ( ret != 0 ) {
@@ -262,27 +635,13 @@ int main(int argc, char *argv[])
                 break;
             }
         }
-        
-        do {
-            sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nPress the Enter Key to register a face and theSpace Key to end: ");
 
-            /******************/
-            /* Log Output     */
-            /******************/
-#ifdef WIN32
-            system("cls");
-#else
-            system("clear");
-#endif
-            PrintLog(pStr);
-
-            memset(pStr, 0, LOGBUFFERSIZE);
-
-            userID = REGISTER_USERID_NUMBER;
-            /*********************************/
-            /* Get Registration Info         */
-            /*********************************/
-            ret = HVC_GetUserData(UART_SETTING_TIMEOUT, userID, &dataNo, &status);
+        /*********************************/
+        /* Build Album Index             */
+        /*********************************/
+        if ( !albumIndex.isValid ) {
+            /* No index stored with the album: one-time scan of all users */
+            ret = ScanAlbumIndex(&albumIndex, UART_SETTING_TIMEOUT, &status);
             if ( ret != 0 ) {
                 sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nHVCApi(HVC_GetUserData) Error : %d\n", ret);
                 break;
@@ -291,48 +650,89 @@ int main(int argc, char *argv[])
                 sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nHVC_GetUserData Error : 0x%02X\n", status);
                 break;
             }
-            sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nHVC_GetUserData : 0x%04x", dataNo);
-
-            dataID = 0;
-            for ( i=0x01; i<0x400; i<<=1 ) {
-                if ( (dataNo & i) == 0 ) break;
-                dataID++;
-            }
-            if ( dataID >= 10 ) {
-                sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nMaximum registration number reached.");
-                break;
+        }
+        
+        if ( pManifest != NULL ) {
+            /*********************************/
+            /* Execute Batch Registration    */
+            /*********************************/
+            PrintLog(pStr);
+            memset(pStr, 0, LOGBUFFERSIZE);
+            batchRet = ExecuteBatchRegistration(pManifest, saveImage, pImage, &albumIndex, pStr);
+            if ( batchRet != 0 ) {
+                /* Keep the registrations made before the error: save and write them below */
+                sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nBatch registration stopped (%d) : saving the registrations made so far\n", batchRet);
+                ret = HVC_Resync(UART_SETTING_TIMEOUT, &status);
+                if ( ret != 0 ) {
+                    sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nHVCApi(HVC_Resync) Error : %d\n", ret);
+                    break;
+                }
             }
+        }
+        else {
+            do {
+                sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nPress the Enter Key to register a face and theSpace Key to end: ");
 
+                /******************/
+                /* Log Output     */
+                /******************/
 #ifdef WIN32
-            ch = 0;
-            if ( _kbhit() ) {
-                ch = _getch();
-                ch = toupper( ch );
-            }
-            
-            if ( ch == '\r' ) {
+                system("cls");
 #else
-            ch = kbhit();
-            
-            if ( ch == '\n' ) {
+                system("clear");
 #endif
+                PrintLog(pStr);
+
+                memset(pStr, 0, LOGBUFFERSIZE);
+
+                userID = REGISTER_USERID_NUMBER;
                 /*********************************/
-                /* Execute Registration          */
+                /* Get Registration Info         */
                 /*********************************/
-                timeOutTime = UART_REGIST_EXECUTE_TIMEOUT;
-                ret = HVC_Registration(timeOutTime, userID, dataID, pImage, &status);
+                ret = GetIndexedUserData(&albumIndex, userID, &dataNo);
                 if ( ret != 0 ) {
-                    sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nHVCApi(HVC_Registration) Error : %d\n", ret);
+                    sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nGetIndexedUserData Error : %d\n", ret);
                     break;
                 }
-                if ( status != 0 ) {
-                    sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nHVC_Registration Error : 0x%02X\n", status);
+                sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nHVC_GetUserData : 0x%04x", dataNo);
+
+                dataID = FindFreeDataID(&albumIndex, userID);
+                if ( dataID < 0 ) {
+                    sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nMaximum registration number reached.");
                     break;
                 }
-                SaveBitmapFile(pImage->width, pImage->height, pImage->image, "RegisterImage.bmp");
-                sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nRegistration complete.");
-            }
-        } while( ch != ' ' );
+
+#ifdef WIN32
+                ch = 0;
+                if ( _kbhit() ) {
+                    ch = _getch();
+                    ch = toupper( ch );
+                }
+            
+                if ( ch == '\r' ) {
+#else
+                ch = kbhit();
+            
+                if ( ch == '\n' ) {
+#endif
+                    /*********************************/
+                    /* Execute Registration          */
+                    /*********************************/
+                    timeOutTime = UART_REGIST_EXECUTE_TIMEOUT;
+                    ret = RegistrationWithIndex(&albumIndex, timeOutTime, userID, dataID, pImage, &status);
+                    if ( ret != 0 ) {
+                        sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nHVCApi(HVC_Registration) Error : %d\n", ret);
+                        break;
+                    }
+                    if ( status != 0 ) {
+                        sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nHVC_Registration Error : 0x%02X\n", status);
+                        break;
+                    }
+                    SaveBitmapFile(pImage->width, pImage->height, pImage->image, "RegisterImage.bmp");
+                    sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nRegistration complete.");
+                }
+            } while( ch != ' ' );
+        }
 
         /*********************************/
         /* Save Album                    */
@@ -346,7 +746,37 @@ int main(int argc, char *argv[])
             sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nHVC_SaveAlbum Response Error : 0x%02X\n", status);
             break;
         }
-        SaveAlbumData("HVCAlbum.alb", albumDataSize, pAlbumData);
+        if ( !albumIndex.isValid ) {
+            /* A signal error left the index out of sync: rescan the album just saved */
+            ret = ScanAlbumIndex(&albumIndex, UART_SETTING_TIMEOUT, &status);
+            if ( (ret != 0) || (status != 0) ) {
+                sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nAlbum index could not be rebuilt (%d/0x%02X) : saved without it\n", ret, status);
+            }
+        }
+        albumUserCount = GetIndexedUserCount(&albumIndex);
+        if ( albumUserCount < 0 ) {
+            albumUserCount = -1;                /* Unknown: the album is still saved, without the index */
+        }
+        ret = SaveAlbumFile(ALBUM_FILE_NAME, &version, albumUserCount, &albumIndex, ALBUM_FILE_COMPRESS, albumDataSize, pAlbumData);
+        if ( ret != 0 ) {
+            sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nSaveAlbumFile(%s) Error : %d\n", ALBUM_FILE_NAME, ret);
+            break;
+        }
+
+        if ( pManifest != NULL ) {
+            /*********************************/
+            /* Write Album to flash ROM      */
+            /*********************************/
+            ret = HVC_WriteAlbum(UART_SAVE_ALBUM_TIMEOUT, &status);
+            if ( ret != 0 ) {
+                sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nHVCApi(HVC_WriteAlbum) Error : %d\n", ret);
+                break;
+            }
+            if ( status != 0 ) {
+                sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\nHVC_WriteAlbum Response Error : 0x%02X\n", status);
+                break;
+            }
+        }
     } while(0);
     /******************/
     /* Log Output     */
@@ -374,7 +804,7 @@ int main(int argc, char *argv[])
     if ( pStr != NULL ) {
         free(pStr);
     }
-    return (0);
+    return ( batchRet != 0 ) ? 1 : 0;
 }
 
 #ifndef WIN32
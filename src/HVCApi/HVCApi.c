@@ -46,6 +46,11 @@
 #define HVC_COM_LOAD_ALBUM              (UINT8)0x21
 #define HVC_COM_WRITE_ALBUM             (UINT8)0x22
 
+/*----------------------------------------------------------------------------*/
+/* Resync */
+#define HVC_RESYNC_QUIET_TIME           50      /* No data for this time (ms) ends the drain */
+#define HVC_RESYNC_RETRY_MAX            3       /* Drain and GetVersion attempts */
+
 /*----------------------------------------------------------------------------*/
 /* Header for send signal data */
 typedef enum {
@@ -67,6 +72,10 @@ typedef enum {
     RECEIVE_HEAD_NUM
 }RECEIVE_HEADER;
 
+/*----------------------------------------------------------------------------*/
+/* Set by HVC_Cancel, cleared by HVC_Resync */
+static volatile INT32 hvcCanceled = 0;
+
 /*----------------------------------------------------------------------------*/
 /* Send command signal                                                        */
 /* param    : UINT8         inCommandNo     command number                    */
@@ -75,6 +84,7 @@ typedef enum {
 /* return   : INT32                         execution result error code       */
 /*          :                               0...normal                        */
 /*          :                               -10...timeout error               */
+/*          :                               -23...canceled                    */
 /*----------------------------------------------------------------------------*/
 static INT32 HVC_SendCommand(UINT8 inCommandNo, INT32 inDataSize, UINT8 *inData)
 {
@@ -82,6 +92,11 @@ static INT32 HVC_SendCommand(UINT8 inCommandNo, INT32 inDataSize, UINT8 *inData)
     INT32 ret = 0;
     UINT8 sendData[32];
 
+    if ( hvcCanceled ) {
+        /* Canceled before the command could be sent */
+        return HVC_ERROR_CANCELED;
+    }
+
     /* Create header */
     sendData[SEND_HEAD_SYNCBYTE]        = (UINT8)0xFE;
     sendData[SEND_HEAD_COMMANDNO]       = (UINT8)inCommandNo;
@@ -108,6 +123,7 @@ static INT32 HVC_SendCommand(UINT8 inCommandNo, INT32 inDataSize, UINT8 *inData)
 /* return   : INT32                         execution result error code       */
 /*          :                               0...normal                        */
 /*          :                               -10...timeout error               */
+/*          :                               -23...canceled                    */
 /*----------------------------------------------------------------------------*/
 static INT32 HVC_SendCommandOfLoadAlbum(UINT8 inCommandNo, INT32 inDataSize, UINT8 *inData)
 {   
@@ -115,6 +131,11 @@ static INT32 HVC_SendCommandOfLoadAlbum(UINT8 inCommandNo, INT32 inDataSize, UIN
     INT32 ret = 0;
     UINT8 *pSendData = NULL;
     
+    if ( hvcCanceled ) {
+        /* Canceled before the command could be sent */
+        return HVC_ERROR_CANCELED;
+    }
+
     pSendData = (UINT8*)malloc(SEND_HEAD_NUM + 4 + inDataSize);
 
     /* Create header */
@@ -154,6 +175,7 @@ static INT32 HVC_SendCommandOfLoadAlbum(UINT8 inCommandNo, INT32 inDataSize, UIN
 /*          :                               0...normal                        */
 /*          :                               -20...timeout error               */
 /*          :                               -21...invalid header error        */
+/*          :                               -23...canceled                    */
 /*----------------------------------------------------------------------------*/
 static INT32 HVC_ReceiveHeader(INT32 inTimeOutTime, INT32 *outDataSize, UINT8 *outStatus)
 {
@@ -163,7 +185,7 @@ static INT32 HVC_ReceiveHeader(INT32 inTimeOutTime, INT32 *outDataSize, UINT8 *o
     /* Get header part */
     ret = UART_ReceiveData(inTimeOutTime, RECEIVE_HEAD_NUM, headerData);
     if(ret != RECEIVE_HEAD_NUM){
-        return HVC_ERROR_HEADER_TIMEOUT;
+        return hvcCanceled ? HVC_ERROR_CANCELED : HVC_ERROR_HEADER_TIMEOUT;
     }
     else if((UINT8)0xFE != headerData[RECEIVE_HEAD_SYNCBYTE]){
         /* Different value indicates an invalid result */
@@ -188,7 +210,8 @@ static INT32 HVC_ReceiveHeader(INT32 inTimeOutTime, INT32 *outDataSize, UINT8 *o
 /*          : UINT8         *outResult      receive signal data               */
 /* return   : INT32                         execution result error code       */
 /*          :                               0...normal                        */
-/*          :                               -20...timeout error               */
+/*          :                               -22...timeout error               */
+/*          :                               -23...canceled                    */
 /*----------------------------------------------------------------------------*/
 static INT32 HVC_ReceiveData(INT32 inTimeOutTime, INT32 inDataSize, UINT8 *outResult)
 {
@@ -199,7 +222,7 @@ static INT32 HVC_ReceiveData(INT32 inTimeOutTime, INT32 inDataSize, UINT8 *outRe
     /* Receive data */
     ret = UART_ReceiveData(inTimeOutTime, inDataSize, outResult);
     if(ret != inDataSize){
-        return HVC_ERROR_DATA_TIMEOUT;
+        return hvcCanceled ? HVC_ERROR_CANCELED : HVC_ERROR_DATA_TIMEOUT;
     }
     return 0;
 }
@@ -963,6 +986,7 @@ INT32 HVC_SetBaudRate(INT32 inTimeOutTime, INT32 inRate, UINT8 *outStatus)
 /*          : INT32         inUserID        User ID (0-499)                   */
 /*          : INT32         inDataID        Data ID (0-9)                     */
 /*          : HVC_IMAGE     *outImage       image info                        */
+/*          :                               (NULL...discard the image)        */
 /*          : UINT8         *outStatus      response code                     */
 /* return   : INT32                         execution result error code       */
 /*          :                               0...normal                        */
@@ -975,8 +999,9 @@ INT32 HVC_Registration(INT32 inTimeOutTime, INT32 inUserID, INT32 inDataID, HVC_
     INT32 size = 0;
     UINT8 sendData[32];
     UINT8 recvData[32];
+    INT32 i;
 
-    if((NULL == outImage) || (NULL == outStatus)){
+    if(NULL == outStatus){
         return HVC_ERROR_PARAMETER;
     }
 
@@ -994,16 +1019,27 @@ INT32 HVC_Registration(INT32 inTimeOutTime, INT32 inUserID, INT32 inDataID, HVC_
     /* Receive data */
     if ( size >= (INT32)sizeof(UINT8)*4 ) {
         ret = HVC_ReceiveData(inTimeOutTime, sizeof(UINT8)*4, recvData);
-        outImage->width = recvData[0] + (recvData[1]<<8);
-        outImage->height = recvData[2] + (recvData[3]<<8);
+        if ( NULL != outImage ) {
+            outImage->width = recvData[0] + (recvData[1]<<8);
+            outImage->height = recvData[2] + (recvData[3]<<8);
+        }
         if ( ret != 0 ) return ret;
         size -= sizeof(UINT8)*4;
     }
 
     /* Image data */
     if ( size >= (INT32)sizeof(UINT8)*64*64 ) {
-        ret = HVC_ReceiveData(inTimeOutTime, sizeof(UINT8)*64*64, outImage->image);
-        if ( ret != 0 ) return ret;
+        if ( NULL != outImage ) {
+            ret = HVC_ReceiveData(inTimeOutTime, sizeof(UINT8)*64*64, outImage->image);
+            if ( ret != 0 ) return ret;
+        }
+        else {
+            /* The device always sends the image; drain it without keeping it */
+            for ( i = 0; i < (INT32)sizeof(UINT8)*64*64; i += (INT32)sizeof(recvData) ) {
+                ret = HVC_ReceiveData(inTimeOutTime, sizeof(recvData), recvData);
+                if ( ret != 0 ) return ret;
+            }
+        }
         size -= sizeof(UINT8)*64*64;
     }
     return 0;
@@ -1255,3 +1291,67 @@ INT32 HVC_WriteAlbum(INT32 inTimeOutTime, UINT8 *outStatus)
     return ret;
 }
 
+/*----------------------------------------------------------------------------*/
+/* HVC_Cancel                                                                 */
+/* Aborts the response wait of the command in progress, so that shutdown or  */
+/* reconfiguration does not have to wait for its timeout. The command returns */
+/* HVC_ERROR_CANCELED. The cancel stays in effect, also when no command is   */
+/* in progress: every command returns HVC_ERROR_CANCELED without being sent  */
+/* until HVC_Resync, which also discards the late response of the device.    */
+/* param    : void                                                            */
+/* return   : void                                                            */
+/*----------------------------------------------------------------------------*/
+void HVC_Cancel(void)
+{
+    hvcCanceled = 1;
+    UART_CancelReceive();
+}
+
+/*----------------------------------------------------------------------------*/
+/* HVC_Resync                                                                 */
+/* Clears a cancel, discards the rest of an aborted response and checks with */
+/* GetVersion that the next response belongs to the next command.             */
+/* param    : INT32         inTimeOutTime   timeout time (ms)                 */
+/*          : UINT8         *outStatus      response code                     */
+/* return   : INT32                         execution result error code       */
+/*          :                               0...normal                        */
+/*          :                               -1...parameter error              */
+/*          :                               other...signal error              */
+/*----------------------------------------------------------------------------*/
+INT32 HVC_Resync(INT32 inTimeOutTime, UINT8 *outStatus)
+{
+    INT32 i;
+    INT32 ret = 0;
+    INT32 size = 0;
+    HVC_VERSION version;
+
+    if(NULL == outStatus){
+        return HVC_ERROR_PARAMETER;
+    }
+
+    /* A cancel from now on aborts the resync itself */
+    hvcCanceled = 0;
+    for(i = 0; i < HVC_RESYNC_RETRY_MAX; i++){
+        /* Discard the late response of the aborted command (clears the UART cancel) */
+        UART_DrainData(HVC_RESYNC_QUIET_TIME, inTimeOutTime);
+
+        /* Send GetVersion command signal */
+        ret = HVC_SendCommand(HVC_COM_GET_VERSION, 0, NULL);
+        if ( ret != 0 ) return ret;
+
+        /* Receive header */
+        ret = HVC_ReceiveHeader(inTimeOutTime, &size, outStatus);
+        if ( ret == HVC_ERROR_CANCELED ) return ret;
+        if ( ret != 0 ) continue;
+        if ( size != (INT32)sizeof(HVC_VERSION) ) {
+            /* Response of the aborted command */
+            ret = HVC_ERROR_HEADER_INVALID;
+            continue;
+        }
+
+        /* Receive data */
+        ret = HVC_ReceiveData(inTimeOutTime, size, (UINT8*)&version);
+        if ( ret != HVC_ERROR_DATA_TIMEOUT ) break;
+    }
+    return ret;
+}
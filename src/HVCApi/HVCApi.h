@@ -120,6 +120,7 @@ INT32 HVC_SetBaudRate(INT32 inTimeOutTime, INT32 inRate, UINT8 *outStatus);
 /*          : INT32         inUserID        User ID (0-499)                   */
 /*          : INT32         inDataID        Data ID (0-9)                     */
 /*          : HVC_IMAGE     *outImage       image info                        */
+/*          :                               (NULL...discard the image)        */
 /*          : UINT8         *outStatus      response code                     */
 INT32 HVC_Registration(INT32 inTimeOutTime, INT32 inUserID, INT32 inDataID, HVC_IMAGE *outImage, UINT8 *outStatus);
 
@@ -167,6 +168,16 @@ INT32 HVC_LoadAlbum(INT32 inTimeOutTime, UINT8 *inAlbumData, INT32 inAlbumDataSi
 /*          : UINT8         *outStatus      response code                     */
 INT32 HVC_WriteAlbum(INT32 inTimeOutTime, UINT8 *outStatus);
 
+/* HVC_Cancel                                                                 */
+/* Aborts the command waiting for its response (call from another thread).   */
+/* Commands return HVC_ERROR_CANCELED until HVC_Resync is called.            */
+void HVC_Cancel(void);
+
+/* HVC_Resync                                                                 */
+/* param    : INT32         inTimeOutTime   timeout time (ms)                 */
+/*          : UINT8         *outStatus      response code                     */
+INT32 HVC_Resync(INT32 inTimeOutTime, UINT8 *outStatus);
+
 #ifdef  __cplusplus
 }
 #endif
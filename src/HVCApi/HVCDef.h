@@ -50,6 +50,8 @@
 #define HVC_ERROR_HEADER_INVALID        -21
 /* Receive data signal timeout error */
 #define HVC_ERROR_DATA_TIMEOUT          -22
+/* Receive canceled by HVC_Cancel */
+#define HVC_ERROR_CANCELED              -23
 
 
 /*----------------------------------------------------------------------------*/
@@ -42,6 +42,25 @@ extern int UART_SendData(int inDataSize, UINT8 *inData);
 /*----------------------------------------------------------------------------*/
 extern int UART_ReceiveData(int inTimeOutTime, int inDataSize, UINT8 *outResult);
 
+/*----------------------------------------------------------------------------*/
+/* UART cancel receive                                                        */
+/* Makes the UART_ReceiveData in progress return at once.                     */
+/* Called from another thread than the one executing the command.            */
+/* param    : void                                                            */
+/* return   : void                                                            */
+/*----------------------------------------------------------------------------*/
+extern void UART_CancelReceive(void);
+
+/*----------------------------------------------------------------------------*/
+/* UART drain receive                                                         */
+/* Also clears UART_CancelReceive for the next UART_ReceiveData.             */
+/* param    : int   inQuietTime     discard data until no data is received   */
+/*          :                       for this time (ms)                        */
+/*          : int   inTimeOutTime   timeout time (ms)                         */
+/* return   : int                   discarded data number                     */
+/*----------------------------------------------------------------------------*/
+extern int UART_DrainData(int inQuietTime, int inTimeOutTime);
+
 #ifdef  __cplusplus
 }
 #endif
@@ -0,0 +1,345 @@
+/*---------------------------------------------------------------------------*/
+/* Copyright(C)  2018  OMRON Corporation                                     */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*---------------------------------------------------------------------------*/
+
+/* 
+    HVC command queue
+
+    HVCApi.c talks to one sensor over one UART and has no locking: commands
+    from several threads would interleave on the wire. Threads instead submit
+    their commands here and a single I/O thread executes them one at a time.
+    Commands in HVC_QUEUE_LANE_CONTROL are executed before the ones waiting in
+    HVC_QUEUE_LANE_STREAM, so a configuration change is slotted in right after
+    the Execute in progress.
+
+    Example (control thread):
+        static INT32 SetThresholdFunc(void *pArg)
+        {
+            THRESHOLD_ARG *p = (THRESHOLD_ARG *)pArg;
+            return HVC_SetThreshold(UART_SETTING_TIMEOUT, &p->threshold, &p->status);
+        }
+        ret = HVCQueue_Call(&queue, HVC_QUEUE_LANE_CONTROL, SetThresholdFunc, &arg);
+
+    Shutdown: HVCQueue_Stop, then HVCQueue_Destroy after the other threads
+    have stopped calling HVCQueue_*. src/Queue_Sample/queue_main.c shows the
+    whole sequence.
+*/
+
+#include <stdlib.h>
+#include "HVCQueue.h"
+
+#ifdef WIN32
+#define HvcQueueLockInit(pLock)         InitializeCriticalSection(pLock)
+#define HvcQueueLockTerm(pLock)         DeleteCriticalSection(pLock)
+#define HvcQueueLock(pLock)             EnterCriticalSection(pLock)
+#define HvcQueueUnlock(pLock)           LeaveCriticalSection(pLock)
+#define HvcQueueCondInit(pCond)         InitializeConditionVariable(pCond)
+#define HvcQueueCondTerm(pCond)
+#define HvcQueueCondWait(pCond, pLock)  SleepConditionVariableCS(pCond, pLock, INFINITE)
+#define HvcQueueCondSignal(pCond)       WakeConditionVariable(pCond)
+#define HvcQueueCondBroadcast(pCond)    WakeAllConditionVariable(pCond)
+#else
+#define HvcQueueLockInit(pLock)         pthread_mutex_init(pLock, NULL)
+#define HvcQueueLockTerm(pLock)         pthread_mutex_destroy(pLock)
+#define HvcQueueLock(pLock)             pthread_mutex_lock(pLock)
+#define HvcQueueUnlock(pLock)           pthread_mutex_unlock(pLock)
+#define HvcQueueCondInit(pCond)         pthread_cond_init(pCond, NULL)
+#define HvcQueueCondTerm(pCond)         pthread_cond_destroy(pCond)
+#define HvcQueueCondWait(pCond, pLock)  pthread_cond_wait(pCond, pLock)
+#define HvcQueueCondSignal(pCond)       pthread_cond_signal(pCond)
+#define HvcQueueCondBroadcast(pCond)    pthread_cond_broadcast(pCond)
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* Take the next request, control lane first (call with the lock held)        */
+/*----------------------------------------------------------------------------*/
+static HVC_QUEUE_REQUEST *HVCQueue_Pop(HVC_QUEUE *pQueue)
+{
+    INT32 lane;
+    HVC_QUEUE_REQUEST *pRequest;
+
+    for ( lane = 0; lane < HVC_QUEUE_LANE_NUM; lane++ ) {
+        pRequest = pQueue->pHead[lane];
+        if ( pRequest != NULL ) {
+            pQueue->pHead[lane] = pRequest->pNext;
+            if ( pQueue->pHead[lane] == NULL ) {
+                pQueue->pTail[lane] = NULL;
+            }
+            pRequest->pNext = NULL;
+            return pRequest;
+        }
+    }
+    return NULL;
+}
+
+/*----------------------------------------------------------------------------*/
+/* I/O thread                                                                 */
+/*----------------------------------------------------------------------------*/
+#ifdef WIN32
+static DWORD WINAPI HVCQueue_Thread(LPVOID pParam)
+#else
+static void *HVCQueue_Thread(void *pParam)
+#endif
+{
+    HVC_QUEUE *pQueue = (HVC_QUEUE *)pParam;
+    HVC_QUEUE_REQUEST *pRequest;
+    INT32 ret;
+
+    for ( ;; ) {
+        HvcQueueLock(&pQueue->lock);
+        pRequest = NULL;
+        while ( !pQueue->isEnd && ((pRequest = HVCQueue_Pop(pQueue)) == NULL) ) {
+            HvcQueueCondWait(&pQueue->notEmpty, &pQueue->lock);
+        }
+        HvcQueueUnlock(&pQueue->lock);
+        if ( pRequest == NULL ) break;
+
+        ret = pRequest->func(pRequest->pArg);
+
+        HvcQueueLock(&pQueue->lock);
+        pRequest->ret = ret;
+        pRequest->isDone = 1;
+        HvcQueueCondBroadcast(&pQueue->done);
+        HvcQueueUnlock(&pQueue->lock);
+    }
+    return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+/* HVCQueue_Start                                                             */
+/* Starts the I/O thread. From here on, HVC_* functions must only be called   */
+/* through the queue.                                                         */
+/* param    : HVC_QUEUE     *pQueue         command queue                     */
+/* return   : INT32                         execution result error code       */
+/*          :                               0...normal                        */
+/*          :                               -1...parameter error,             */
+/*          :                                    thread creation error        */
+/*----------------------------------------------------------------------------*/
+INT32 HVCQueue_Start(HVC_QUEUE *pQueue)
+{
+    INT32 lane;
+
+    if(NULL == pQueue){
+        return HVC_ERROR_PARAMETER;
+    }
+
+    for ( lane = 0; lane < HVC_QUEUE_LANE_NUM; lane++ ) {
+        pQueue->pHead[lane] = NULL;
+        pQueue->pTail[lane] = NULL;
+    }
+    pQueue->isEnd = 0;
+    pQueue->waitNum = 0;
+    HvcQueueLockInit(&pQueue->lock);
+    HvcQueueCondInit(&pQueue->notEmpty);
+    HvcQueueCondInit(&pQueue->done);
+#ifdef WIN32
+    pQueue->thread = CreateThread(NULL, 0, HVCQueue_Thread, pQueue, 0, NULL);
+    if ( pQueue->thread == NULL ) {
+#else
+    if ( pthread_create(&pQueue->thread, NULL, HVCQueue_Thread, pQueue) != 0 ) {
+#endif
+        HvcQueueCondTerm(&pQueue->done);
+        HvcQueueCondTerm(&pQueue->notEmpty);
+        HvcQueueLockTerm(&pQueue->lock);
+        return HVC_ERROR_PARAMETER;
+    }
+    return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+/* HVCQueue_Stop                                                              */
+/* Aborts the command in progress with HVC_Cancel and completes the queued    */
+/* ones with HVC_ERROR_CANCELED without sending them, so stopping does not    */
+/* wait for the Execute timeout. Call HVC_Resync before using HVC_* again.    */
+/* Returns after every HVCQueue_Wait has returned. The queue stays valid:     */
+/* HVCQueue_Submit/Call return HVC_ERROR_CANCELED until HVCQueue_Destroy.     */
+/* param    : HVC_QUEUE     *pQueue         command queue                     */
+/* return   : void                                                            */
+/*----------------------------------------------------------------------------*/
+void HVCQueue_Stop(HVC_QUEUE *pQueue)
+{
+    HVC_QUEUE_REQUEST *pRequest;
+
+    if(NULL == pQueue){
+        return;
+    }
+
+    HvcQueueLock(&pQueue->lock);
+    pQueue->isEnd = 1;
+    /* Under the lock: a command popped before isEnd was set is canceled */
+    /* even if it has not been sent yet (the cancel lasts until HVC_Resync) */
+    HVC_Cancel();
+    while ( (pRequest = HVCQueue_Pop(pQueue)) != NULL ) {
+        pRequest->ret = HVC_ERROR_CANCELED;
+        pRequest->isDone = 1;
+    }
+    HvcQueueCondBroadcast(&pQueue->done);
+    HvcQueueCondSignal(&pQueue->notEmpty);
+    HvcQueueUnlock(&pQueue->lock);
+
+#ifdef WIN32
+    WaitForSingleObject(pQueue->thread, INFINITE);
+    CloseHandle(pQueue->thread);
+#else
+    pthread_join(pQueue->thread, NULL);
+#endif
+
+    HvcQueueLock(&pQueue->lock);
+    while ( pQueue->waitNum > 0 ) {
+        HvcQueueCondWait(&pQueue->done, &pQueue->lock);
+    }
+    HvcQueueUnlock(&pQueue->lock);
+}
+
+/*----------------------------------------------------------------------------*/
+/* HVCQueue_Destroy                                                           */
+/* Frees the lock and the condition variables. Call after HVCQueue_Stop, once */
+/* no other thread calls HVCQueue_* with this queue any more.                 */
+/* param    : HVC_QUEUE     *pQueue         command queue                     */
+/* return   : void                                                            */
+/*----------------------------------------------------------------------------*/
+void HVCQueue_Destroy(HVC_QUEUE *pQueue)
+{
+    if(NULL == pQueue){
+        return;
+    }
+
+    HvcQueueCondTerm(&pQueue->done);
+    HvcQueueCondTerm(&pQueue->notEmpty);
+    HvcQueueLockTerm(&pQueue->lock);
+}
+
+/*----------------------------------------------------------------------------*/
+/* HVCQueue_Submit                                                            */
+/* Queues a command and returns at once; HVCQueue_IsDone/HVCQueue_Wait give   */
+/* its result.                                                                */
+/* param    : HVC_QUEUE         *pQueue     command queue                     */
+/*          : INT32             inLane      HVC_QUEUE_LANE_CONTROL/STREAM     */
+/*          : HVC_QUEUE_REQUEST *pRequest   request                           */
+/*          : HVC_QUEUE_FUNC    inFunc      command                           */
+/*          : void              *pArg       command argument                  */
+/* return   : INT32                         execution result error code       */
+/*          :                               0...normal                        */
+/*          :                               -1...parameter error              */
+/*          :                               -23...queue stopped               */
+/*----------------------------------------------------------------------------*/
+INT32 HVCQueue_Submit(HVC_QUEUE *pQueue, INT32 inLane, HVC_QUEUE_REQUEST *pRequest, HVC_QUEUE_FUNC inFunc, void *pArg)
+{
+    INT32 ret = 0;
+
+    if((NULL == pQueue) || (NULL == pRequest) || (NULL == inFunc)
+    || (inLane < 0) || (inLane >= HVC_QUEUE_LANE_NUM)){
+        return HVC_ERROR_PARAMETER;
+    }
+
+    pRequest->func = inFunc;
+    pRequest->pArg = pArg;
+    pRequest->ret = 0;
+    pRequest->isDone = 0;
+    pRequest->pNext = NULL;
+
+    HvcQueueLock(&pQueue->lock);
+    if ( pQueue->isEnd ) {
+        pRequest->ret = HVC_ERROR_CANCELED;
+        pRequest->isDone = 1;
+        ret = HVC_ERROR_CANCELED;
+    }
+    else {
+        if ( pQueue->pTail[inLane] == NULL ) {
+            pQueue->pHead[inLane] = pRequest;
+        }
+        else {
+            pQueue->pTail[inLane]->pNext = pRequest;
+        }
+        pQueue->pTail[inLane] = pRequest;
+        HvcQueueCondSignal(&pQueue->notEmpty);
+    }
+    HvcQueueUnlock(&pQueue->lock);
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/* HVCQueue_IsDone                                                            */
+/* param    : HVC_QUEUE         *pQueue     command queue                     */
+/*          : HVC_QUEUE_REQUEST *pRequest   request                           */
+/* return   : INT32                         1...done (pRequest->ret is set)   */
+/*          :                               0...waiting or in progress        */
+/*----------------------------------------------------------------------------*/
+INT32 HVCQueue_IsDone(HVC_QUEUE *pQueue, HVC_QUEUE_REQUEST *pRequest)
+{
+    INT32 isDone;
+
+    if((NULL == pQueue) || (NULL == pRequest)){
+        return 1;
+    }
+
+    HvcQueueLock(&pQueue->lock);
+    isDone = pRequest->isDone;
+    HvcQueueUnlock(&pQueue->lock);
+    return isDone;
+}
+
+/*----------------------------------------------------------------------------*/
+/* HVCQueue_Wait                                                              */
+/* param    : HVC_QUEUE         *pQueue     command queue                     */
+/*          : HVC_QUEUE_REQUEST *pRequest   request                           */
+/* return   : INT32                         return code of the command        */
+/*          :                               -1...parameter error              */
+/*          :                               -23...canceled by HVCQueue_Stop   */
+/*----------------------------------------------------------------------------*/
+INT32 HVCQueue_Wait(HVC_QUEUE *pQueue, HVC_QUEUE_REQUEST *pRequest)
+{
+    INT32 ret;
+
+    if((NULL == pQueue) || (NULL == pRequest)){
+        return HVC_ERROR_PARAMETER;
+    }
+
+    HvcQueueLock(&pQueue->lock);
+    pQueue->waitNum++;
+    while ( !pRequest->isDone ) {
+        HvcQueueCondWait(&pQueue->done, &pQueue->lock);
+    }
+    ret = pRequest->ret;
+    pQueue->waitNum--;
+    if ( pQueue->isEnd ) {
+        /* HVCQueue_Stop waits for the last waiter */
+        HvcQueueCondBroadcast(&pQueue->done);
+    }
+    HvcQueueUnlock(&pQueue->lock);
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/* HVCQueue_Call                                                              */
+/* HVCQueue_Submit and HVCQueue_Wait in one call.                             */
+/* param    : HVC_QUEUE         *pQueue     command queue                     */
+/*          : INT32             inLane      HVC_QUEUE_LANE_CONTROL/STREAM     */
+/*          : HVC_QUEUE_FUNC    inFunc      command                           */
+/*          : void              *pArg       command argument                  */
+/* return   : INT32                         return code of the command        */
+/*          :                               -1...parameter error              */
+/*          :                               -23...canceled by HVCQueue_Stop   */
+/*----------------------------------------------------------------------------*/
+INT32 HVCQueue_Call(HVC_QUEUE *pQueue, INT32 inLane, HVC_QUEUE_FUNC inFunc, void *pArg)
+{
+    INT32 ret;
+    HVC_QUEUE_REQUEST request;
+
+    ret = HVCQueue_Submit(pQueue, inLane, &request, inFunc, pArg);
+    if ( ret != 0 ) return ret;
+
+    return HVCQueue_Wait(pQueue, &request);
+}
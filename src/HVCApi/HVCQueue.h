@@ -0,0 +1,126 @@
+/*---------------------------------------------------------------------------*/
+/* Copyright(C)  2018  OMRON Corporation                                     */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*---------------------------------------------------------------------------*/
+
+/* 
+    HVC command queue
+*/
+
+#ifndef HVCQueue_H__
+#define HVCQueue_H__
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#include "HVCApi.h"
+
+/*----------------------------------------------------------------------------*/
+/* Priority lane */
+#define HVC_QUEUE_LANE_CONTROL          0       /* Configuration commands, served first */
+#define HVC_QUEUE_LANE_STREAM           1       /* Execute commands */
+#define HVC_QUEUE_LANE_NUM              2
+
+#ifdef WIN32
+typedef CRITICAL_SECTION    HVC_QUEUE_LOCK;
+typedef CONDITION_VARIABLE  HVC_QUEUE_COND;
+typedef HANDLE              HVC_QUEUE_THREAD;
+#else
+typedef pthread_mutex_t     HVC_QUEUE_LOCK;
+typedef pthread_cond_t      HVC_QUEUE_COND;
+typedef pthread_t           HVC_QUEUE_THREAD;
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* Command executed on the I/O thread                                         */
+/* Calls one or more HVC_* functions with the values in pArg and returns the  */
+/* HVC_* return code. Output values (response code, results) are written      */
+/* back through pArg.                                                         */
+/*----------------------------------------------------------------------------*/
+typedef INT32 (*HVC_QUEUE_FUNC)(void *pArg);
+
+/*----------------------------------------------------------------------------*/
+/* Request (future)                                                           */
+/* Owned by the caller and must stay valid until HVCQueue_Wait returns.       */
+/*----------------------------------------------------------------------------*/
+typedef struct HVC_QUEUE_REQUEST_ {
+    HVC_QUEUE_FUNC              func;
+    void                        *pArg;
+    INT32                       ret;        /* Return code of func */
+    INT32                       isDone;     /* 1...ret is set */
+    struct HVC_QUEUE_REQUEST_   *pNext;
+}HVC_QUEUE_REQUEST;
+
+/*----------------------------------------------------------------------------*/
+/* Command queue                                                              */
+/*----------------------------------------------------------------------------*/
+typedef struct {
+    HVC_QUEUE_REQUEST   *pHead[HVC_QUEUE_LANE_NUM];
+    HVC_QUEUE_REQUEST   *pTail[HVC_QUEUE_LANE_NUM];
+    INT32               isEnd;
+    INT32               waitNum;    /* Threads blocked in HVCQueue_Wait */
+    HVC_QUEUE_LOCK      lock;
+    HVC_QUEUE_COND      notEmpty;
+    HVC_QUEUE_COND      done;
+    HVC_QUEUE_THREAD    thread;
+}HVC_QUEUE;
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/* HVCQueue_Start                                                             */
+/* param    : HVC_QUEUE     *pQueue         command queue                     */
+INT32 HVCQueue_Start(HVC_QUEUE *pQueue);
+
+/* HVCQueue_Stop                                                              */
+/* param    : HVC_QUEUE     *pQueue         command queue                     */
+void  HVCQueue_Stop(HVC_QUEUE *pQueue);
+
+/* HVCQueue_Destroy                                                           */
+/* param    : HVC_QUEUE     *pQueue         command queue                     */
+void  HVCQueue_Destroy(HVC_QUEUE *pQueue);
+
+/* HVCQueue_Submit                                                            */
+/* param    : HVC_QUEUE         *pQueue     command queue                     */
+/*          : INT32             inLane      HVC_QUEUE_LANE_CONTROL/STREAM     */
+/*          : HVC_QUEUE_REQUEST *pRequest   request                           */
+/*          : HVC_QUEUE_FUNC    inFunc      command                           */
+/*          : void              *pArg       command argument                  */
+INT32 HVCQueue_Submit(HVC_QUEUE *pQueue, INT32 inLane, HVC_QUEUE_REQUEST *pRequest, HVC_QUEUE_FUNC inFunc, void *pArg);
+
+/* HVCQueue_IsDone                                                            */
+/* param    : HVC_QUEUE         *pQueue     command queue                     */
+/*          : HVC_QUEUE_REQUEST *pRequest   request                           */
+INT32 HVCQueue_IsDone(HVC_QUEUE *pQueue, HVC_QUEUE_REQUEST *pRequest);
+
+/* HVCQueue_Wait                                                              */
+/* param    : HVC_QUEUE         *pQueue     command queue                     */
+/*          : HVC_QUEUE_REQUEST *pRequest   request                           */
+INT32 HVCQueue_Wait(HVC_QUEUE *pQueue, HVC_QUEUE_REQUEST *pRequest);
+
+/* HVCQueue_Call                                                              */
+/* param    : HVC_QUEUE         *pQueue     command queue                     */
+/*          : INT32             inLane      HVC_QUEUE_LANE_CONTROL/STREAM     */
+/*          : HVC_QUEUE_FUNC    inFunc      command                           */
+/*          : void              *pArg       command argument                  */
+INT32 HVCQueue_Call(HVC_QUEUE *pQueue, INT32 inLane, HVC_QUEUE_FUNC inFunc, void *pArg);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif  /* HVCQueue_H__ */
@@ -0,0 +1,373 @@
+/*---------------------------------------------------------------------------*/
+/* Copyright(C)  2018  OMRON Corporation                                     */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*---------------------------------------------------------------------------*/
+
+/*
+    Command queue sample
+
+    Face detection runs on the I/O thread of HVCQueue (stream lane) while the
+    main thread watches the keyboard. '+' / '-' change the face detection
+    threshold through the control lane: the change is sent right after the
+    Execute in progress. Space stops the queue, which aborts the Execute in
+    progress.
+*/
+
+#ifdef WIN32
+#include <conio.h>
+#include <windows.h>
+#else
+#include <termios.h>
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "uart.h"
+#include "HVCApi.h"
+#include "HVCDef.h"
+#include "HVCExtraUartFunc.h"
+#include "HVCQueue.h"
+
+#define LOGBUFFERSIZE   1024
+
+#define UART_SETTING_TIMEOUT              1000            /* HVC setting command signal timeout period */
+#define UART_EXECUTE_TIMEOUT              ((10+10+6+3+15+15+1+1+15+10)*1000)
+                                                          /* HVC execute command signal timeout period */
+
+#define FACE_THRESHOLD_STEP                100            /* Threshold change per key press */
+#define FACE_THRESHOLD_MIN                   1            /* Face Detection threshold minimum value */
+#define FACE_THRESHOLD_MAX                1000            /* Face Detection threshold maximum value */
+
+#define QUEUE_POLL_INTERVAL                 10            /* Keyboard polling interval (ms) */
+
+#ifndef WIN32
+#define sprintf_s(buf, num, ...) sprintf(buf, __VA_ARGS__)
+#define Sleep(ms) usleep((ms)*1000)
+int kbhit(void);
+#endif
+
+/* Argument of ExecuteFunc */
+typedef struct {
+    HVC_RESULT  *pHVCResult;
+    UINT8       status;
+}EXECUTE_ARG;
+
+/* Argument of ChangeThresholdFunc */
+typedef struct {
+    INT32       step;
+    INT32       face;           /* Threshold after the change */
+    UINT8       status;
+}THRESHOLD_ARG;
+
+/*----------------------------------------------------------------------------*/
+/* UART send signal                                                           */
+/* param    : int   inDataSize  send signal data                              */
+/*          : UINT8 *inData     data length                                   */
+/* return   : int               send signal complete data number              */
+/*----------------------------------------------------------------------------*/
+int UART_SendData(int inDataSize, UINT8 *inData)
+{
+    /* Send Data */
+    int ret = com_send(inData, inDataSize);
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/* UART receive signal                                                        */
+/* param    : int   inTimeOutTime   timeout time (ms)                         */
+/*          : int   *inDataSize     receive signal data size                  */
+/*          : UINT8 *outResult      receive signal data                       */
+/* return   : int                   receive signal complete data number       */
+/*----------------------------------------------------------------------------*/
+int UART_ReceiveData(int inTimeOutTime, int inDataSize, UINT8 *outResult)
+{
+    /* Receive Data */
+    int ret = com_recv(inTimeOutTime, outResult, inDataSize);
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/* UART cancel receive                                                        */
+/* param    : void                                                            */
+/* return   : void                                                            */
+/*----------------------------------------------------------------------------*/
+void UART_CancelReceive(void)
+{
+    /* Cancel Receive */
+    com_cancel();
+}
+
+/*----------------------------------------------------------------------------*/
+/* UART drain receive                                                         */
+/* param    : int   inQuietTime     quiet time (ms)                           */
+/*          : int   inTimeOutTime   timeout time (ms)                         */
+/* return   : int                   discarded data number                     */
+/*----------------------------------------------------------------------------*/
+int UART_DrainData(int inQuietTime, int inTimeOutTime)
+{
+    /* Drain Receive */
+    int ret = com_drain(inQuietTime, inTimeOutTime);
+    return ret;
+}
+
+/* Print Log Message */
+static void PrintLog(char *pStr)
+{
+    puts(pStr);
+}
+
+/*----------------------------------------------------------------------------*/
+/* Face detection (runs on the I/O thread)                                    */
+/*----------------------------------------------------------------------------*/
+static INT32 ExecuteFunc(void *pArg)
+{
+    EXECUTE_ARG *p = (EXECUTE_ARG *)pArg;
+
+    return HVC_ExecuteEx(UART_EXECUTE_TIMEOUT, HVC_ACTIV_FACE_DETECTION | HVC_ACTIV_FACE_DIRECTION,
+                         HVC_EXECUTE_IMAGE_NONE, p->pHVCResult, &p->status);
+}
+
+/*----------------------------------------------------------------------------*/
+/* Threshold change (runs on the I/O thread)                                  */
+/* Get and Set run back-to-back: no other command is sent in between.         */
+/*----------------------------------------------------------------------------*/
+static INT32 ChangeThresholdFunc(void *pArg)
+{
+    THRESHOLD_ARG *p = (THRESHOLD_ARG *)pArg;
+    HVC_THRESHOLD threshold;
+    INT32 ret;
+
+    ret = HVC_GetThreshold(UART_SETTING_TIMEOUT, &threshold, &p->status);
+    if ( (ret != 0) || (p->status != 0) ) return ret;
+
+    threshold.dtThreshold += p->step;
+    if ( threshold.dtThreshold < FACE_THRESHOLD_MIN ) threshold.dtThreshold = FACE_THRESHOLD_MIN;
+    if ( threshold.dtThreshold > FACE_THRESHOLD_MAX ) threshold.dtThreshold = FACE_THRESHOLD_MAX;
+    p->face = threshold.dtThreshold;
+
+    return HVC_SetThreshold(UART_SETTING_TIMEOUT, &threshold, &p->status);
+}
+
+/* HVC Execute Processing with the command queue */
+int main(int argc, char *argv[])
+{
+    INT32 ret = 0;  /* Return code */
+
+    INT32 inRate;
+    int listBaudRate[] = {
+                              9600,
+                             38400,
+                            115200,
+                            230400,
+                            460800,
+                            921600
+                         };
+
+    UINT8 status;
+    HVC_RESULT *pHVCResult = NULL;
+
+    HVC_QUEUE queue;
+    HVC_QUEUE_REQUEST request;
+    EXECUTE_ARG executeArg;
+    THRESHOLD_ARG thresholdArg;
+
+    int i;
+    int ch = 0;
+    char pStr[LOGBUFFERSIZE];       /* String Buffer for logging output */
+
+    S_STAT serialStat;              /* Serial port set value*/
+
+    serialStat.com_num = 0;
+    serialStat.BaudRate = 0;        /* Default Baudrate = 9600 */
+    if ( argc >= 2 ){
+        serialStat.com_num  = atoi(argv[1]);
+    }
+    if ( com_init(&serialStat) == 0 ) {
+        PrintLog("Failed to open COM port.\n");
+        return (-1);
+    }
+
+    if ( argc >= 3 ){
+        serialStat.BaudRate = atoi(argv[2]);
+        for ( inRate = 0; inRate<(int)(sizeof(listBaudRate)/sizeof(int)); inRate++ ) {
+            if ( listBaudRate[inRate] == (int)serialStat.BaudRate ) {
+                break;
+            }
+        }
+        if ( inRate >= (int)(sizeof(listBaudRate)/sizeof(int)) ) {
+            PrintLog("Failed to set baudrate.\n");
+            return (-1);
+        }
+
+        /* Change Baudrate */
+        ret = HVC_SetBaudRate(UART_SETTING_TIMEOUT, inRate, &status);
+        if ( (ret != 0) || (status != 0) ) {
+            PrintLog("HVCApi(HVC_SetBaudRate) Error.\n");
+            return (-1);
+        }
+
+        if ( com_init(&serialStat) == 0 ) {
+            PrintLog("Failed to open COM port.\n");
+            return (-1);
+        }
+    }
+
+    pHVCResult = (HVC_RESULT *)malloc(sizeof(HVC_RESULT));
+    if ( pHVCResult == NULL ) {
+        PrintLog("Memory Allocation Error.\n");
+        com_close();
+        return (-1);
+    }
+    executeArg.pHVCResult = pHVCResult;
+
+    /*********************************/
+    /* Start the I/O thread          */
+    /*********************************/
+    /* From here on, HVC_* functions are only called through the queue */
+    ret = HVCQueue_Start(&queue);
+    if ( ret != 0 ) {
+        PrintLog("HVCQueue_Start Error.\n");
+        free(pHVCResult);
+        com_close();
+        return (-1);
+    }
+
+    PrintLog("Press '+' or '-' to change the face detection threshold, Space to stop.\n");
+    do {
+        /*********************************/
+        /* Execute (stream lane)         */
+        /*********************************/
+        ret = HVCQueue_Submit(&queue, HVC_QUEUE_LANE_STREAM, &request, ExecuteFunc, &executeArg);
+        if ( ret != 0 ) {
+            sprintf_s(pStr, LOGBUFFERSIZE, "HVCQueue_Submit Error : %d\n", ret);
+            PrintLog(pStr);
+            break;
+        }
+
+        /* The keyboard stays responsive while the Execute is in progress */
+        while ( !HVCQueue_IsDone(&queue, &request) ) {
+#ifdef WIN32
+            ch = 0;
+            if ( _kbhit() ) {
+                ch = _getch();
+            }
+#else
+            ch = kbhit();
+#endif
+            if ( ch == ' ' ) break;
+            if ( (ch == '+') || (ch == '-') ) {
+                /*********************************/
+                /* Threshold (control lane)      */
+                /*********************************/
+                thresholdArg.step = (ch == '+') ? FACE_THRESHOLD_STEP : -FACE_THRESHOLD_STEP;
+                ret = HVCQueue_Call(&queue, HVC_QUEUE_LANE_CONTROL, ChangeThresholdFunc, &thresholdArg);
+                if ( (ret != 0) || (thresholdArg.status != 0) ) {
+                    sprintf_s(pStr, LOGBUFFERSIZE, "Threshold change Error : %d (0x%02X)\n", ret, thresholdArg.status);
+                }
+                else {
+                    sprintf_s(pStr, LOGBUFFERSIZE, "Face detection threshold : %d\n", thresholdArg.face);
+                }
+                PrintLog(pStr);
+            }
+            Sleep(QUEUE_POLL_INTERVAL);
+        }
+        if ( ch == ' ' ) break;
+
+        ret = HVCQueue_Wait(&queue, &request);
+        if ( ret != 0 ) {
+            sprintf_s(pStr, LOGBUFFERSIZE, "HVCApi(HVC_ExecuteEx) Error : %d\n", ret);
+            PrintLog(pStr);
+            break;
+        }
+        if ( executeArg.status != 0 ) {
+            sprintf_s(pStr, LOGBUFFERSIZE, "HVC_ExecuteEx Response Error : 0x%02X\n", executeArg.status);
+            PrintLog(pStr);
+            break;
+        }
+
+        sprintf_s(pStr, LOGBUFFERSIZE, "Face count = %d", pHVCResult->fdResult.num);
+        for ( i = 0; i < pHVCResult->fdResult.num; i++ ) {
+            sprintf_s(&pStr[strlen(pStr)], LOGBUFFERSIZE-strlen(pStr), "\n  Index:%d  X:%d Y:%d Size:%d Conf:%d  LR:%d UD:%d Roll:%d", i,
+                        pHVCResult->fdResult.fcResult[i].dtResult.posX,
+                        pHVCResult->fdResult.fcResult[i].dtResult.posY,
+                        pHVCResult->fdResult.fcResult[i].dtResult.size,
+                        pHVCResult->fdResult.fcResult[i].dtResult.confidence,
+                        pHVCResult->fdResult.fcResult[i].dirResult.yaw,
+                        pHVCResult->fdResult.fcResult[i].dirResult.pitch,
+                        pHVCResult->fdResult.fcResult[i].dirResult.roll);
+        }
+        PrintLog(pStr);
+    } while(1);
+
+    /*********************************/
+    /* Stop the I/O thread           */
+    /*********************************/
+    /* Aborts the Execute in progress; the request is still valid after Stop */
+    HVCQueue_Stop(&queue);
+    ret = HVCQueue_Wait(&queue, &request);
+    if ( ret == HVC_ERROR_CANCELED ) {
+        PrintLog("Execute canceled.\n");
+    }
+    /* No other thread uses the queue: free it */
+    HVCQueue_Destroy(&queue);
+
+    /* Discard the rest of the canceled response */
+    ret = HVC_Resync(UART_SETTING_TIMEOUT, &status);
+    if ( ret != 0 ) {
+        sprintf_s(pStr, LOGBUFFERSIZE, "HVCApi(HVC_Resync) Error : %d\n", ret);
+        PrintLog(pStr);
+    }
+
+    free(pHVCResult);
+    com_close();
+    return (0);
+}
+
+#ifndef WIN32
+/*----------------------------------------------------------------------------*/
+/* kbhit for Linux                                                            */
+/* param    : void                                                            */
+/* return   : int                    input keyboard character code            */
+/*----------------------------------------------------------------------------*/
+int kbhit(void)
+{
+    struct termios oldt, newt;
+    int ch,ret;
+    int oldf;
+
+    tcgetattr(STDIN_FILENO, &oldt);
+    newt = oldt;
+    newt.c_lflag &= ~(ICANON | ECHO);
+    tcsetattr(STDIN_FILENO, TCSANOW, &newt);
+    oldf = fcntl(STDIN_FILENO, F_GETFL, 0);
+    fcntl(STDIN_FILENO, F_SETFL, oldf | O_NONBLOCK);
+
+    ch = getchar();
+
+    tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
+    fcntl(STDIN_FILENO, F_SETFL, oldf);
+
+    if (ch == EOF) {
+        ret = -1;
+    }
+    else {
+        ret = ch;
+    }
+
+    return ret;
+}
+#endif
@@ -19,6 +19,7 @@
 */
 
 #include <stdlib.h>
+#include <stddef.h>
 #include "STBWrap.h"
 
 #pragma comment(lib, "STB.lib")
@@ -57,14 +58,16 @@ void STB_Final(void)
 int STB_Exec(int inActiveFunc, const HVC_RESULT *inResult, int *pnSTBFaceCount, STB_FACE **pSTBFaceResult, int *pnSTBBodyCount, STB_BODY **pSTBBodyResult)
 {
     int ret;
-    STB_FRAME_RESULT frameRes;
+    STB_FRAME_LAYOUT_DETECTION bodyLayout;
+    STB_FRAME_LAYOUT_FACE faceLayout;
 
     m_nFaceCount = 0;
     m_nBodyCount = 0;
-    GetFrameResult(inActiveFunc, inResult, &frameRes);
+    GetFrameLayout(inActiveFunc, &bodyLayout, &faceLayout);
     do{
-        // Set frame information (Detection Result)
-        ret = STB_SetFrameResult(m_Handle, &frameRes);
+        // Set frame information (Detection Result read in place from HVC_RESULT)
+        ret = STB_SetFrameResultLayout(m_Handle, inResult->bdResult.num, inResult->bdResult.bdResult, &bodyLayout,
+                                                 inResult->fdResult.num, inResult->fdResult.fcResult, &faceLayout);
         if(STB_NORMAL != ret){
             break;
         }
@@ -161,76 +164,93 @@ int STB_SetFrParam(int inThreshold, int inUDAngleMin, int inUDAngleMax, int inLR
 
 
 
-static void GetFrameResult(int inActiveFunc, const HVC_RESULT *inResult, STB_FRAME_RESULT *outFrameResult)
+static void GetFrameLayout(int inActiveFunc, STB_FRAME_LAYOUT_DETECTION *outBodyLayout, STB_FRAME_LAYOUT_FACE *outFaceLayout)
 {
     int i;
 
     // Body Detection
-    outFrameResult->bodys.nCount = inResult->bdResult.num;
-    if(inActiveFunc & HVC_ACTIV_BODY_DETECTION){
-        for(i = 0; i <  inResult->bdResult.num; i++){
-            DETECT_RESULT dtRes = inResult->bdResult.bdResult[i];
-            outFrameResult->bodys.body[i].center.nX     = dtRes.posX;
-            outFrameResult->bodys.body[i].center.nY     = dtRes.posY;
-            outFrameResult->bodys.body[i].nSize         = dtRes.size;
-            outFrameResult->bodys.body[i].nConfidence   = dtRes.confidence;
-        }
+    outBodyLayout->nStride              = sizeof(DETECT_RESULT);
+    outBodyLayout->center.nX            = offsetof(DETECT_RESULT, posX);
+    outBodyLayout->center.nY            = offsetof(DETECT_RESULT, posY);
+    outBodyLayout->nSize                = offsetof(DETECT_RESULT, size);
+    outBodyLayout->nConfidence          = offsetof(DETECT_RESULT, confidence);
+
+    // Face Detection
+    outFaceLayout->nStride              = sizeof(FACE_RESULT);
+    outFaceLayout->center.nX            = offsetof(FACE_RESULT, dtResult.posX);
+    outFaceLayout->center.nY            = offsetof(FACE_RESULT, dtResult.posY);
+    outFaceLayout->nSize                = offsetof(FACE_RESULT, dtResult.size);
+    outFaceLayout->nConfidence          = offsetof(FACE_RESULT, dtResult.confidence);
+
+    // Face Direction (not read : 0)
+    if(inActiveFunc & HVC_ACTIV_FACE_DIRECTION){
+        outFaceLayout->direction.nUD            = offsetof(FACE_RESULT, dirResult.pitch);
+        outFaceLayout->direction.nLR            = offsetof(FACE_RESULT, dirResult.yaw);
+        outFaceLayout->direction.nRoll          = offsetof(FACE_RESULT, dirResult.roll);
+        outFaceLayout->direction.nConfidence    = offsetof(FACE_RESULT, dirResult.confidence);
+    } else {
+        outFaceLayout->direction.nUD            = STB_LAYOUT_NONE;
+        outFaceLayout->direction.nLR            = STB_LAYOUT_NONE;
+        outFaceLayout->direction.nRoll          = STB_LAYOUT_NONE;
+        outFaceLayout->direction.nConfidence    = STB_LAYOUT_NONE;
     }
 
-    outFrameResult->faces.nCount = inResult->fdResult.num;
-    for(i = 0; i < inResult->fdResult.num; i++){
-        // Face Detection
-        if(inActiveFunc & HVC_ACTIV_FACE_DETECTION){
-            DETECT_RESULT dtRes = inResult->fdResult.fcResult[i].dtResult;
-            outFrameResult->faces.face[i].center.nX     = dtRes.posX;
-            outFrameResult->faces.face[i].center.nY     = dtRes.posY;
-            outFrameResult->faces.face[i].nSize         = dtRes.size;
-            outFrameResult->faces.face[i].nConfidence   = dtRes.confidence;
-        }
-        
-        // Face Direction
-        if(inActiveFunc & HVC_ACTIV_FACE_DIRECTION){
-            DIR_RESULT dirRes = inResult->fdResult.fcResult[i].dirResult;
-            outFrameResult->faces.face[i].direction.nUD         = dirRes.pitch;
-            outFrameResult->faces.face[i].direction.nLR         = dirRes.yaw;
-            outFrameResult->faces.face[i].direction.nRoll       = dirRes.roll;
-            outFrameResult->faces.face[i].direction.nConfidence = dirRes.confidence;
-        } else {
-            outFrameResult->faces.face[i].direction.nUD         = 0;
-            outFrameResult->faces.face[i].direction.nLR         = 0;
-            outFrameResult->faces.face[i].direction.nRoll       = 0;
-            outFrameResult->faces.face[i].direction.nConfidence = 0;
-        }
+    // Age (not read : -128)
+    if(inActiveFunc & HVC_ACTIV_AGE_ESTIMATION){
+        outFaceLayout->age.nAge                 = offsetof(FACE_RESULT, ageResult.age);
+        outFaceLayout->age.nConfidence          = offsetof(FACE_RESULT, ageResult.confidence);
+    } else {
+        outFaceLayout->age.nAge                 = STB_LAYOUT_NONE;
+        outFaceLayout->age.nConfidence          = STB_LAYOUT_NONE;
+    }
 
-        // Age
-        if(inActiveFunc & HVC_ACTIV_AGE_ESTIMATION){
-            AGE_RESULT ageRes = inResult->fdResult.fcResult[i].ageResult;
-            outFrameResult->faces.face[i].age.nAge              = ageRes.age;
-            outFrameResult->faces.face[i].age.nConfidence       = ageRes.confidence;
-        } else {
-            outFrameResult->faces.face[i].age.nAge              = -128;
-            outFrameResult->faces.face[i].age.nConfidence       = -128;
-        }
+    // Gender (not read : -128)
+    if(inActiveFunc & HVC_ACTIV_GENDER_ESTIMATION){
+        outFaceLayout->gender.nGender           = offsetof(FACE_RESULT, genderResult.gender);
+        outFaceLayout->gender.nConfidence       = offsetof(FACE_RESULT, genderResult.confidence);
+    } else {
+        outFaceLayout->gender.nGender           = STB_LAYOUT_NONE;
+        outFaceLayout->gender.nConfidence       = STB_LAYOUT_NONE;
+    }
 
-        // Gender
-        if(inActiveFunc & HVC_ACTIV_GENDER_ESTIMATION){
-            GENDER_RESULT genderRes = inResult->fdResult.fcResult[i].genderResult;
-            outFrameResult->faces.face[i].gender.nGender        = genderRes.gender;
-            outFrameResult->faces.face[i].gender.nConfidence    = genderRes.confidence;
-        } else {
-            outFrameResult->faces.face[i].gender.nGender        = -128;
-            outFrameResult->faces.face[i].gender.nConfidence    = -128;
-        }
+    // Gaze (not read : -128)
+    if(inActiveFunc & HVC_ACTIV_GAZE_ESTIMATION){
+        outFaceLayout->gaze.nLR                 = offsetof(FACE_RESULT, gazeResult.gazeLR);
+        outFaceLayout->gaze.nUD                 = offsetof(FACE_RESULT, gazeResult.gazeUD);
+    } else {
+        outFaceLayout->gaze.nLR                 = STB_LAYOUT_NONE;
+        outFaceLayout->gaze.nUD                 = STB_LAYOUT_NONE;
+    }
+
+    // Blink (not read : -128)
+    if(inActiveFunc & HVC_ACTIV_BLINK_ESTIMATION){
+        outFaceLayout->blink.nLeftEye           = offsetof(FACE_RESULT, blinkResult.ratioL);
+        outFaceLayout->blink.nRightEye          = offsetof(FACE_RESULT, blinkResult.ratioR);
+    } else {
+        outFaceLayout->blink.nLeftEye           = STB_LAYOUT_NONE;
+        outFaceLayout->blink.nRightEye          = STB_LAYOUT_NONE;
+    }
 
-        // F
-        if(inActiveFunc & HVC_ACTIV_FACE_RECOGNITION){
-            RECOGNITION_RESULT recogRes = inResult->fdResult.fcResult[i].recognitionResult;
-            outFrameResult->faces.face[i].recognition.nUID      = recogRes.uid;
-            outFrameResult->faces.face[i].recognition.nScore    = recogRes.confidence;
+    // Expression (not read : -128)
+    for(i = 0; i < STB_Expression_Max; i++){
+        if(inActiveFunc & HVC_ACTIV_EXPRESSION_ESTIMATION){
+            outFaceLayout->expression.anScore[i] = offsetof(FACE_RESULT, expressionResult.score) + i * sizeof(INT32);
         } else {
-            outFrameResult->faces.face[i].recognition.nUID      = -128;
-            outFrameResult->faces.face[i].recognition.nScore    = -128;
+            outFaceLayout->expression.anScore[i] = STB_LAYOUT_NONE;
         }
     }
-}
+    if(inActiveFunc & HVC_ACTIV_EXPRESSION_ESTIMATION){
+        outFaceLayout->expression.nDegree       = offsetof(FACE_RESULT, expressionResult.degree);
+    } else {
+        outFaceLayout->expression.nDegree       = STB_LAYOUT_NONE;
+    }
 
+    // Face Recognition (not read : -128)
+    if(inActiveFunc & HVC_ACTIV_FACE_RECOGNITION){
+        outFaceLayout->recognition.nUID         = offsetof(FACE_RESULT, recognitionResult.uid);
+        outFaceLayout->recognition.nScore       = offsetof(FACE_RESULT, recognitionResult.confidence);
+    } else {
+        outFaceLayout->recognition.nUID         = STB_LAYOUT_NONE;
+        outFaceLayout->recognition.nScore       = STB_LAYOUT_NONE;
+    }
+}
@@ -42,7 +42,7 @@ int STB_SetTrParam(int inRetryCount, int inStbPosParam, int inStbSizeParam);
 int STB_SetPeParam(int inThreshold, int inUDAngleMin, int inUDAngleMax, int inLRAngleMin, int inLRAngleMax, int inCompCount);
 int STB_SetFrParam(int inThreshold, int inUDAngleMin, int inUDAngleMax, int inLRAngleMin, int inLRAngleMax, int inCompCount, int inRatio);
 
-static void GetFrameResult(int inActiveFunc, const HVC_RESULT *inResult, STB_FRAME_RESULT *outFrameResult);
+static void GetFrameLayout(int inActiveFunc, STB_FRAME_LAYOUT_DETECTION *outBodyLayout, STB_FRAME_LAYOUT_FACE *outFaceLayout);
 
 #ifdef  __cplusplus
 }
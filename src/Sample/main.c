@@ -104,6 +104,30 @@ int UART_ReceiveData(int inTimeOutTime, int inDataSize, UINT8 *outResult)
     return ret;
 }
 
+/*----------------------------------------------------------------------------*/
+/* UART cancel receive                                                        */
+/* param    : void                                                            */
+/* return   : void                                                            */
+/*----------------------------------------------------------------------------*/
+void UART_CancelReceive(void)
+{
+    /* Cancel Receive */
+    com_cancel();
+}
+
+/*----------------------------------------------------------------------------*/
+/* UART drain receive                                                         */
+/* param    : int   inQuietTime     quiet time (ms)                           */
+/*          : int   inTimeOutTime   timeout time (ms)                         */
+/* return   : int                   discarded data number                     */
+/*----------------------------------------------------------------------------*/
+int UART_DrainData(int inQuietTime, int inTimeOutTime)
+{
+    /* Drain Receive */
+    int ret = com_drain(inQuietTime, inTimeOutTime);
+    return ret;
+}
+
 /* Print Log Message */
 static void PrintLog(char *pStr)
 {
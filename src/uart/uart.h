@@ -35,6 +35,8 @@ void com_close(void);
 int com_init(S_STAT *stat);
 int com_send(unsigned char *buf, int len);
 int com_recv(int inTimeOutTimer, unsigned char *buf, int len);
+void com_cancel(void);
+int com_drain(int inQuietTime, int inTimeOutTimer);
 
 #ifdef  __cplusplus
 }
@@ -21,6 +21,7 @@
 #include <memory.h>
 #include <string.h>
 #include <unistd.h>
+#include <time.h>
 #include <pthread.h>
 #include <termios.h>
 #include <sys/stat.h>
@@ -46,6 +47,7 @@ static int m_ptrRead = 0;
 static int m_ptrReceive = 0;
 static unsigned char m_acRcvBuf[SIZE_RCVBUF];
 static int m_nReceiveCount = 0;
+static volatile int m_bCancel = 0;	/* Abort the receive wait in progress */
 
 void InitializeCriticalSection(CRITICAL_SECTION *section)
 {
@@ -69,17 +71,29 @@ void com_sleep(int nSleep)
     usleep(nSleep*1000);
 }
 
+/* Monotonic time (ms) for the receive deadlines */
+static long com_tick(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
 /* UART */
 void com_close(void)
 {
+    /* Release a receive wait in another thread before the port goes away */
+    com_cancel();
+
     // MvZXI
-    if (m_hThread != NULL)
+    // The thread polls m_bThread without blocking, so the join returns at once
+    if (m_hThread != (pthread_t)NULL)
     {
-        (void)pthread_cancel(m_hThread);
+		m_bThread = 0;
+        (void)pthread_join(m_hThread, NULL);
+        m_hThread = (pthread_t)NULL;
     }
     if ( hCom != -1 ) {
-		m_bThread = 0;
-
         tcsetattr(hCom, TCSANOW, &save_options);    // ̐ݒ𕜋A
         close(hCom);
         hCom = -1;
@@ -97,6 +111,7 @@ int com_init(S_STAT *stat)
     struct sched_param spp;
 
     com_close();
+    m_bCancel = 0;      /* A cancel does not carry over to the new port */
 
     sprintf(device, "/dev/ttyACM%d", stat->com_num);
     hCom = open(device,O_RDWR | O_NOCTTY);          // foCXt@CiVA|[gjI[v
@@ -195,18 +210,17 @@ int _com_recv(int inTimeOutTimer, unsigned char *buf, int len)
     int nTotalSize = 0;
     char strBuf[256];
 
-    time_t start,end;
+    long start;
 
     if ( hCom != -1 ) {
         //Start timer
-        time(&start);
+        start = com_tick();
         while ( nTotalSize < len ) {
             nSize = read(hCom, &buf[nTotalSize], len-nTotalSize);
             nTotalSize += nSize;
 
             //Time Out Check
-            time(&end);
-            if( (end - start)*1000 > inTimeOutTimer){
+            if ( com_tick() - start >= inTimeOutTimer ) {
                 break;
             }
         }
@@ -304,17 +318,19 @@ int com_recv(int inTimeOutTimer, unsigned char *buf, int len)
 {
 	int nSize = 0;
 
-    time_t start,end;
+    long start;
 
     //Start timer
-    time(&start);
+    start = com_tick();
     do{
         usleep(10000);
         if ( com_length() >= len ) break;
 
+        //Cancel Check
+        if ( m_bCancel ) break;
+
         //Time Out Check
-        time(&end);
-        if( (end - start)*1000 > inTimeOutTimer){
+        if ( com_tick() - start > inTimeOutTimer ) {
             break;
         }
     }while(1);
@@ -338,3 +354,52 @@ int com_recv(int inTimeOutTimer, unsigned char *buf, int len)
 	LeaveCriticalSection(&cs);
 	return nSize;
 }
+
+/*----------------------------------------------------------------------------*/
+/* Cancel receive                                                             */
+/* Makes the receive wait in progress (also in another thread) return at     */
+/* once with the data received so far. Stays set until com_drain.            */
+/*----------------------------------------------------------------------------*/
+void com_cancel(void)
+{
+	m_bCancel = 1;
+}
+
+/*----------------------------------------------------------------------------*/
+/* Drain receive                                                              */
+/* Discards received data until the line has been quiet for inQuietTime,     */
+/* e.g. the late response of a canceled command, and clears com_cancel.     */
+/* param    : int   inQuietTime     quiet time (ms)                           */
+/*          : int   inTimeOutTimer  timeout time (ms)                         */
+/* return   : int                   discarded data number                     */
+/*----------------------------------------------------------------------------*/
+int com_drain(int inQuietTime, int inTimeOutTimer)
+{
+	int nCount;
+	int nTotal = 0;
+	long start, last, now;
+
+	m_bCancel = 0;
+	start = com_tick();
+	last = start;
+	do{
+		usleep(10000);
+		now = com_tick();
+
+		EnterCriticalSection(&cs);
+		nCount = m_nReceiveCount;
+		m_ptrRead = m_ptrReceive;
+		m_nReceiveCount = 0;
+		LeaveCriticalSection(&cs);
+
+		if ( nCount > 0 ) {
+			nTotal += nCount;
+			last = now;
+		}
+		else if ( now - last >= inQuietTime ) {
+			break;
+		}
+	}while( now - start < inTimeOutTimer );
+
+	return nTotal;
+}
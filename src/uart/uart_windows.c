@@ -20,6 +20,7 @@
 #include "uart.h"
 
 static HANDLE hCom = INVALID_HANDLE_VALUE;
+static volatile int m_bCancel = 0;  /* Abort the receive wait in progress */
 
 /* UART */
 void com_close(void)
@@ -37,6 +38,7 @@ int com_init(S_STAT *stat)
     char device[16];
 
     com_close();
+    m_bCancel = 0;      /* A cancel does not carry over to the new port */
 
     sprintf_s(device, 16, "\\\\.\\COM%d", stat->com_num);
     hCom = CreateFile(device,
@@ -134,6 +136,7 @@ int com_recv(int inTimeOutTimer, unsigned char *buf, int len)
                 totalSize += (int)dwSize;
             }
             if ( totalSize >= len ) break;
+            if ( m_bCancel ) break;
 
             QueryPerformanceCounter(&stopTime);
             finishTime = (double)(stopTime.QuadPart - startTime.QuadPart) * 1000 / (double)timeFreq.QuadPart;
@@ -142,3 +145,59 @@ int com_recv(int inTimeOutTimer, unsigned char *buf, int len)
     }
     return totalSize;
 }
+
+/*----------------------------------------------------------------------------*/
+/* Cancel receive                                                             */
+/* Makes the receive wait in progress (also in another thread) return at     */
+/* once with the data received so far. Stays set until com_drain.            */
+/*----------------------------------------------------------------------------*/
+void com_cancel(void)
+{
+    m_bCancel = 1;
+}
+
+/*----------------------------------------------------------------------------*/
+/* Drain receive                                                              */
+/* Discards received data until the line has been quiet for inQuietTime,     */
+/* e.g. the late response of a canceled command, and clears com_cancel.     */
+/* param    : int   inQuietTime     quiet time (ms)                           */
+/*          : int   inTimeOutTimer  timeout time (ms)                         */
+/* return   : int                   discarded data number                     */
+/*----------------------------------------------------------------------------*/
+int com_drain(int inQuietTime, int inTimeOutTimer)
+{
+    DWORD ierr;
+    COMSTAT stat;
+
+    int totalSize = 0;
+
+    double nowTime = 0.0;
+    double lastTime = 0.0;
+
+    LARGE_INTEGER timeFreq = {0, 0};
+    LARGE_INTEGER stopTime = {0, 0};
+    LARGE_INTEGER startTime = {0, 0};
+
+    m_bCancel = 0;
+    QueryPerformanceFrequency(&timeFreq);
+
+    if ( hCom != INVALID_HANDLE_VALUE ) {
+        QueryPerformanceCounter(&startTime);
+        do{
+            Sleep(10);
+            QueryPerformanceCounter(&stopTime);
+            nowTime = (double)(stopTime.QuadPart - startTime.QuadPart) * 1000 / (double)timeFreq.QuadPart;
+
+            ClearCommError(hCom,&ierr,&stat);
+            if ( stat.cbInQue >= 1 ) {
+                totalSize += (int)stat.cbInQue;
+                PurgeComm(hCom, PURGE_RXCLEAR);
+                lastTime = nowTime;
+            }
+            else if ( nowTime - lastTime >= (double)inQuietTime ) {
+                break;
+            }
+        }while( nowTime < (double)inTimeOutTimer );
+    }
+    return totalSize;
+}